@@ -0,0 +1,1071 @@
+#ifndef BASICCHARBUFFER_H
+#define BASICCHARBUFFER_H
+
+#include <new>
+#include <memory>
+#include <cstring>
+#include <cassert>
+#include <type_traits>
+
+#include <CharKernels.h>
+#include <CharPattern.h>
+#include <RangeException.h>
+
+class CharBuffer;
+
+// Bounds check policy that throws RangeException for any invalid range or index
+class CheckedBounds
+{
+  public:
+    // @throws RangeException
+    static void check(const bool valid)
+    {
+        if (!valid)
+        {
+            throw RangeException();
+        }
+    }
+};
+
+// Bounds check policy that only checks in debug builds, using assert()
+class UncheckedBounds
+{
+  public:
+    static void check(const bool valid) noexcept
+    {
+        assert(valid);
+        (void) valid;
+    }
+};
+
+// Growth policy for buffers with a fixed capacity
+// Exceeding the capacity is treated as a bounds check failure.
+class FixedCapacity
+{
+  public:
+    static bool is_growable() noexcept
+    {
+        return false;
+    }
+
+    static size_t next_capacity(
+        const size_t capacity,
+        const size_t /* required */,
+        const size_t /* max_capacity */
+    ) noexcept
+    {
+        return capacity;
+    }
+};
+
+// Growth policy that at least doubles the capacity when it is exceeded
+class GeometricGrowth
+{
+  public:
+    static bool is_growable() noexcept
+    {
+        return true;
+    }
+
+    static size_t next_capacity(const size_t capacity, const size_t required, const size_t max_capacity) noexcept
+    {
+        const size_t max_growth = (max_capacity - 1) - capacity;
+        const size_t doubled = capacity + (capacity <= max_growth ? capacity : max_growth);
+        return doubled > required ? doubled : required;
+    }
+};
+
+// Growth policy that is selected at runtime, buffers grow like GeometricGrowth while growth is enabled
+class RuntimeGrowth
+{
+  public:
+    RuntimeGrowth() noexcept:
+        growable(false)
+    {
+    }
+
+    void set_growable(const bool growable_flag) noexcept
+    {
+        growable = growable_flag;
+    }
+
+    bool is_growable() const noexcept
+    {
+        return growable;
+    }
+
+    static size_t next_capacity(const size_t capacity, const size_t required, const size_t max_capacity) noexcept
+    {
+        return GeometricGrowth::next_capacity(capacity, required, max_capacity);
+    }
+
+  private:
+    bool growable;
+};
+
+// Non-polymorphic character buffer
+// Implements the CharBuffer operations as non-virtual, inlinable functions. Bounds checking,
+// capacity growth and storage allocation are selected by the template parameters, and storage
+// for capacities up to InlineCapacity is inside the object.
+// CharBuffer is the polymorphic wrapper around BasicCharBuffer<CheckedBounds, RuntimeGrowth,
+// CharAllocatorAdapter, CharBuffer::INLINE_CAPACITY>.
+// A moved-from buffer is empty and has a capacity of zero; reserve() makes room for new content
+// if the growth policy does not.
+template<
+    typename CheckPolicy = CheckedBounds,
+    typename GrowthPolicy = FixedCapacity,
+    typename Allocator = std::allocator<char>,
+    size_t InlineCapacity = 0
+>
+class BasicCharBuffer : private Allocator, private GrowthPolicy
+{
+  public:
+    static_assert(std::is_same<typename Allocator::value_type, char>::value, "Allocator must allocate char");
+
+    // Maximum number of characters that a buffer can contain, without the trailing null character
+    static constexpr size_t MAX_CAPACITY = ~static_cast<size_t> (0) - 1;
+    static constexpr size_t NPOS = ~static_cast<size_t> (0);
+    static constexpr size_t INLINE_CAPACITY = InlineCapacity;
+
+    // @throws std::bad_alloc
+    explicit BasicCharBuffer(size_t capacity, const Allocator& allocator = Allocator());
+
+    // @throws std::bad_alloc, RangeException
+    explicit BasicCharBuffer(const char* text, const Allocator& allocator = Allocator());
+
+    // @throws std::bad_alloc, RangeException
+    explicit BasicCharBuffer(size_t capacity, const char* text, const Allocator& allocator = Allocator());
+
+    ~BasicCharBuffer() noexcept;
+
+    // @throws std::bad_alloc
+    BasicCharBuffer(const BasicCharBuffer& orig);
+    BasicCharBuffer(BasicCharBuffer&& orig) noexcept;
+
+    // @throws std::bad_alloc, RangeException
+    BasicCharBuffer& operator=(const BasicCharBuffer& orig);
+    BasicCharBuffer& operator=(BasicCharBuffer&& orig) noexcept;
+
+    // @throws std::bad_alloc, RangeException
+    BasicCharBuffer& operator=(const char* text);
+
+    bool operator==(const BasicCharBuffer& other) const noexcept;
+    // @throws RangeException
+    bool operator==(const char* text) const noexcept;
+    bool equals_raw(const char* data, size_t length) const noexcept;
+    bool operator!=(const BasicCharBuffer& other) const noexcept;
+    // @throws RangeException
+    bool operator!=(const char* text) const noexcept;
+    bool operator<(const BasicCharBuffer& other) const noexcept;
+    bool operator>(const BasicCharBuffer& other) const noexcept;
+    bool operator<=(const BasicCharBuffer& other) const noexcept;
+    bool operator>=(const BasicCharBuffer& other) const noexcept;
+
+    // @throws std::bad_alloc, RangeException
+    void operator+=(const BasicCharBuffer& other);
+
+    // @throws std::bad_alloc, RangeException
+    void operator+=(const char* text);
+
+    // @throws std::bad_alloc, RangeException
+    void operator+=(char in_char);
+
+    // @throws RangeException
+    char& operator[](size_t index);
+
+    // @throws RangeException
+    const char& operator[](size_t index) const;
+
+    bool is_empty() const noexcept;
+    size_t length() const noexcept;
+    size_t capacity() const noexcept;
+    void clear() noexcept;
+    void wipe() noexcept;
+    void truncate(size_t new_length) noexcept;
+
+    bool is_growable() const noexcept;
+
+    // Gives access to the state of a stateful growth policy, such as RuntimeGrowth
+    GrowthPolicy& growth_policy() noexcept;
+    const GrowthPolicy& growth_policy() const noexcept;
+
+    Allocator get_allocator() const noexcept;
+
+    // @throws std::bad_alloc
+    void reserve(size_t min_capacity);
+
+    // @throws std::bad_alloc
+    void shrink_to_fit();
+
+    // @throws std::bad_alloc, RangeException
+    void copy_raw(const char* data, size_t length);
+
+    // @throws RangeException
+    void substring(size_t start, size_t end);
+
+    // @throws std::bad_alloc, RangeException
+    void substring_from(const BasicCharBuffer& other, size_t start, size_t end);
+
+    // @throws std::bad_alloc, RangeException
+    void append(const BasicCharBuffer& other, size_t start, size_t end);
+
+    // @throws std::bad_alloc, RangeException
+    void append_raw(const char* data, size_t data_length);
+
+    // @throws std::bad_alloc, RangeException
+    void append_raw(const char* data, size_t start, size_t end);
+
+    // @throws std::bad_alloc, RangeException
+    void overwrite_with(size_t dst_start, const BasicCharBuffer& other);
+
+    // @throws std::bad_alloc, RangeException
+    void overwrite_with(size_t dst_start, const char* text);
+
+    void fill(char fill_char) noexcept;
+
+    // @throws std::bad_alloc, RangeException
+    void fill(char fill_char, size_t target_length);
+
+    int compare_to(const BasicCharBuffer& other) const noexcept;
+    // @throws RangeException
+    int compare_to(const char* text) const noexcept;
+    int compare_to_raw(const char* data, size_t length) const noexcept;
+
+    bool starts_with(const BasicCharBuffer& other) const noexcept;
+    // @throws RangeException
+    bool starts_with(const char* text) const noexcept;
+    bool starts_with_raw(const char* data, size_t length) const noexcept;
+
+    bool ends_with(const BasicCharBuffer& other) const noexcept;
+    // @throws RangeException
+    bool ends_with(const char* text) const noexcept;
+    bool ends_with_raw(const char* data, size_t length) const noexcept;
+
+    size_t index_of(char letter) const noexcept;
+
+    // @throws RangeException
+    size_t index_of(char letter, size_t start) const;
+
+    size_t index_of(const BasicCharBuffer& other) const noexcept;
+    // @throws RangeException
+    size_t index_of(const char* text) const noexcept;
+    size_t index_of(const CharPattern& pattern) const noexcept;
+
+    // @throws RangeException
+    size_t index_of(const BasicCharBuffer& other, size_t start) const;
+
+    // @throws RangeException
+    size_t index_of(const char* text, size_t start) const;
+
+    // @throws RangeException
+    size_t index_of(const CharPattern& pattern, size_t start) const;
+
+    const char* c_str() const noexcept;
+
+  private:
+    // CharBuffer implements its additional operations directly on the storage
+    friend class CharBuffer;
+
+    typedef std::allocator_traits<Allocator> alloc_traits;
+
+    size_t bfr_capacity;
+    size_t bfr_length;
+    char* buffer;
+    char inline_buffer[InlineCapacity + 1];
+
+    // @throws std::bad_alloc
+    void init_buffer(size_t buffer_capacity);
+
+    void release_buffer() noexcept;
+
+    // @throws std::bad_alloc
+    void reallocate(size_t new_capacity);
+
+    // @throws std::bad_alloc, RangeException
+    void make_room(size_t offset, size_t count);
+
+    // @throws std::bad_alloc, RangeException
+    void make_room(size_t offset, size_t count, const char*& src_data);
+
+    void take_storage(BasicCharBuffer& orig) noexcept;
+
+    // @throws std::bad_alloc, RangeException
+    void assign_impl(const char* data, size_t start, size_t end);
+
+    // @throws std::bad_alloc, RangeException
+    void append_impl(const char* data, size_t start, size_t end);
+
+    // @throws std::bad_alloc, RangeException
+    void overwrite_impl(size_t dst_start, const char* data, size_t data_length);
+
+    // @throws RangeException
+    size_t index_of_impl(const char* pattern, size_t pat_length, size_t start) const;
+};
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+constexpr size_t BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::MAX_CAPACITY;
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+constexpr size_t BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::NPOS;
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+constexpr size_t BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::INLINE_CAPACITY;
+
+// @throws std::bad_alloc
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::BasicCharBuffer(
+    const size_t buffer_capacity,
+    const Allocator& allocator
+):
+    Allocator(allocator)
+{
+    init_buffer(buffer_capacity);
+    bfr_length = 0;
+    buffer[bfr_length] = '\0';
+}
+
+// @throws std::bad_alloc
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::BasicCharBuffer(
+    const char* const text,
+    const Allocator& allocator
+):
+    Allocator(allocator)
+{
+    const size_t text_length = CharKernels::bounded_c_str_length(text, MAX_CAPACITY);
+    init_buffer(text_length);
+    std::memcpy(buffer, text, text_length + 1);
+    bfr_length = text_length;
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::BasicCharBuffer(
+    const size_t buffer_capacity,
+    const char* const text,
+    const Allocator& allocator
+):
+    Allocator(allocator)
+{
+    const size_t text_length = CharKernels::bounded_c_str_length(text, MAX_CAPACITY);
+    const size_t init_capacity = growth_policy().is_growable() && text_length > buffer_capacity ?
+        text_length : buffer_capacity;
+    CheckPolicy::check(text_length <= init_capacity);
+    init_buffer(init_capacity);
+    std::memcpy(buffer, text, text_length + 1);
+    bfr_length = text_length;
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::~BasicCharBuffer() noexcept
+{
+    release_buffer();
+}
+
+// @throws std::bad_alloc
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::BasicCharBuffer(const BasicCharBuffer& orig):
+    Allocator(alloc_traits::select_on_container_copy_construction(orig)),
+    GrowthPolicy(orig)
+{
+    init_buffer(orig.bfr_capacity);
+    std::memcpy(buffer, orig.buffer, orig.bfr_length + 1);
+    bfr_length = orig.bfr_length;
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::BasicCharBuffer(BasicCharBuffer&& orig) noexcept:
+    Allocator(std::move(static_cast<Allocator&> (orig))),
+    GrowthPolicy(orig)
+{
+    take_storage(orig);
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>&
+BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::operator=(const BasicCharBuffer& orig)
+{
+    if (this != &orig)
+    {
+        assign_impl(orig.buffer, 0, orig.bfr_length);
+    }
+    return *this;
+}
+
+// The storage is taken over together with the allocator that obtained it
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>&
+BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::operator=(BasicCharBuffer&& orig) noexcept
+{
+    if (this != &orig)
+    {
+        release_buffer();
+        static_cast<Allocator&> (*this) = std::move(static_cast<Allocator&> (orig));
+        static_cast<GrowthPolicy&> (*this) = static_cast<const GrowthPolicy&> (orig);
+        take_storage(orig);
+    }
+    return *this;
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>&
+BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::operator=(const char* const text)
+{
+    assign_impl(text, 0, CharKernels::bounded_c_str_length(text, MAX_CAPACITY));
+    return *this;
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+bool BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::operator==(
+    const BasicCharBuffer& other
+) const noexcept
+{
+    return equals_raw(other.buffer, other.bfr_length);
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+bool BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::operator==(
+    const char* const text
+) const noexcept
+{
+    return equals_raw(text, CharKernels::bounded_c_str_length(text, MAX_CAPACITY));
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+bool BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::equals_raw(
+    const char* const data,
+    const size_t length
+) const noexcept
+{
+    return bfr_length == length && CharKernels::find_mismatch(buffer, data, length) == length;
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+bool BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::operator!=(
+    const BasicCharBuffer& other
+) const noexcept
+{
+    return !(*this == other);
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+bool BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::operator!=(
+    const char* const text
+) const noexcept
+{
+    return !(*this == text);
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+bool BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::operator<(
+    const BasicCharBuffer& other
+) const noexcept
+{
+    return compare_to(other) < 0;
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+bool BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::operator>(
+    const BasicCharBuffer& other
+) const noexcept
+{
+    return compare_to(other) > 0;
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+bool BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::operator<=(
+    const BasicCharBuffer& other
+) const noexcept
+{
+    return compare_to(other) <= 0;
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+bool BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::operator>=(
+    const BasicCharBuffer& other
+) const noexcept
+{
+    return compare_to(other) >= 0;
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::operator+=(const BasicCharBuffer& other)
+{
+    append_impl(other.buffer, 0, other.bfr_length);
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::operator+=(const char* const text)
+{
+    append_impl(text, 0, CharKernels::bounded_c_str_length(text, MAX_CAPACITY));
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::operator+=(const char in_char)
+{
+    if (bfr_length >= bfr_capacity)
+    {
+        make_room(bfr_length, 1);
+    }
+    buffer[bfr_length] = in_char;
+    ++bfr_length;
+    buffer[bfr_length] = '\0';
+}
+
+// @throws RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+char& BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::operator[](const size_t index)
+{
+    CheckPolicy::check(index < bfr_length);
+    return buffer[index];
+}
+
+// @throws RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+const char& BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::operator[](const size_t index) const
+{
+    CheckPolicy::check(index < bfr_length);
+    return buffer[index];
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+bool BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::is_empty() const noexcept
+{
+    return bfr_length == 0;
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+size_t BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::length() const noexcept
+{
+    return bfr_length;
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+size_t BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::capacity() const noexcept
+{
+    return bfr_capacity;
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::clear() noexcept
+{
+    bfr_length = 0;
+    buffer[bfr_length] = '\0';
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::wipe() noexcept
+{
+    volatile char* const wipe_buffer = buffer;
+    for (size_t idx = 0; idx <= bfr_capacity; ++idx)
+    {
+        wipe_buffer[idx] = 0;
+    }
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::truncate(const size_t new_length) noexcept
+{
+    if (new_length < bfr_length)
+    {
+        bfr_length = new_length;
+        buffer[bfr_length] = '\0';
+    }
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+bool BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::is_growable() const noexcept
+{
+    return growth_policy().is_growable();
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+GrowthPolicy& BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::growth_policy() noexcept
+{
+    return *this;
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+const GrowthPolicy& BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::growth_policy(
+    
+) const noexcept
+{
+    return *this;
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+Allocator BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::get_allocator() const noexcept
+{
+    return *this;
+}
+
+// @throws std::bad_alloc
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::reserve(const size_t min_capacity)
+{
+    if (min_capacity > bfr_capacity)
+    {
+        reallocate(min_capacity);
+    }
+}
+
+// @throws std::bad_alloc
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::shrink_to_fit()
+{
+    if (bfr_length < bfr_capacity)
+    {
+        reallocate(bfr_length);
+    }
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::copy_raw(
+    const char* const data,
+    const size_t length
+)
+{
+    assign_impl(data, 0, length);
+}
+
+// @throws RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::substring(
+    const size_t start,
+    const size_t end
+)
+{
+    CheckPolicy::check(start <= end && end <= bfr_length);
+    bfr_length = end - start;
+    std::memmove(buffer, &(buffer[start]), bfr_length);
+    buffer[bfr_length] = '\0';
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::substring_from(
+    const BasicCharBuffer& other,
+    const size_t start,
+    const size_t end
+)
+{
+    CheckPolicy::check(start <= end && end <= other.bfr_length);
+    assign_impl(other.buffer, start, end);
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::append(
+    const BasicCharBuffer& other,
+    const size_t start,
+    const size_t end
+)
+{
+    CheckPolicy::check(start <= end && end <= other.bfr_length);
+    append_impl(other.buffer, start, end);
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::append_raw(
+    const char* const data,
+    const size_t data_length
+)
+{
+    append_impl(data, 0, data_length);
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::append_raw(
+    const char* const data,
+    const size_t start,
+    const size_t end
+)
+{
+    CheckPolicy::check(start <= end);
+    append_impl(data, start, end);
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::overwrite_with(
+    const size_t dst_start,
+    const BasicCharBuffer& other
+)
+{
+    overwrite_impl(dst_start, other.buffer, other.bfr_length);
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::overwrite_with(
+    const size_t dst_start,
+    const char* const text
+)
+{
+    overwrite_impl(dst_start, text, CharKernels::bounded_c_str_length(text, MAX_CAPACITY));
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::fill(const char fill_char) noexcept
+{
+    std::memset(&(buffer[bfr_length]), fill_char, bfr_capacity - bfr_length);
+    bfr_length = bfr_capacity;
+    buffer[bfr_length] = '\0';
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::fill(
+    const char fill_char,
+    const size_t target_length
+)
+{
+    make_room(0, target_length);
+    if (target_length > bfr_length)
+    {
+        std::memset(&(buffer[bfr_length]), fill_char, target_length - bfr_length);
+    }
+    bfr_length = target_length;
+    buffer[bfr_length] = '\0';
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+int BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::compare_to(
+    const BasicCharBuffer& other
+) const noexcept
+{
+    return compare_to_raw(other.buffer, other.bfr_length);
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+int BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::compare_to(
+    const char* const text
+) const noexcept
+{
+    return compare_to_raw(text, CharKernels::bounded_c_str_length(text, MAX_CAPACITY));
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+int BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::compare_to_raw(
+    const char* const data,
+    const size_t data_length
+) const noexcept
+{
+    return CharKernels::compare(buffer, bfr_length, data, data_length);
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+bool BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::starts_with(
+    const BasicCharBuffer& other
+) const noexcept
+{
+    return starts_with_raw(other.buffer, other.bfr_length);
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+bool BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::starts_with(
+    const char* const text
+) const noexcept
+{
+    return starts_with_raw(text, CharKernels::bounded_c_str_length(text, MAX_CAPACITY));
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+bool BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::starts_with_raw(
+    const char* const data,
+    const size_t length
+) const noexcept
+{
+    return bfr_length >= length && CharKernels::find_mismatch(buffer, data, length) == length;
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+bool BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::ends_with(
+    const BasicCharBuffer& other
+) const noexcept
+{
+    return ends_with_raw(other.buffer, other.bfr_length);
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+bool BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::ends_with(
+    const char* const text
+) const noexcept
+{
+    return ends_with_raw(text, CharKernels::bounded_c_str_length(text, MAX_CAPACITY));
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+bool BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::ends_with_raw(
+    const char* const data,
+    const size_t length
+) const noexcept
+{
+    return bfr_length >= length && CharKernels::find_mismatch(&(buffer[bfr_length - length]), data, length) == length;
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+size_t BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::index_of(const char letter) const noexcept
+{
+    const size_t index = CharKernels::find_char(buffer, 0, bfr_length, letter);
+    return index < bfr_length ? index : NPOS;
+}
+
+// @throws RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+size_t BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::index_of(
+    const char letter,
+    const size_t start
+) const
+{
+    CheckPolicy::check(start <= bfr_length);
+    const size_t index = CharKernels::find_char(buffer, start, bfr_length, letter);
+    return index < bfr_length ? index : NPOS;
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+size_t BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::index_of(
+    const BasicCharBuffer& other
+) const noexcept
+{
+    return CharPattern::find(buffer, bfr_length, other.buffer, other.bfr_length, 0);
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+size_t BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::index_of(
+    const char* const text
+) const noexcept
+{
+    const size_t text_length = CharKernels::bounded_c_str_length(text, MAX_CAPACITY);
+    return CharPattern::find(buffer, bfr_length, text, text_length, 0);
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+size_t BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::index_of(
+    const CharPattern& pattern
+) const noexcept
+{
+    return pattern.find_in(buffer, bfr_length, 0);
+}
+
+// @throws RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+size_t BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::index_of(
+    const BasicCharBuffer& other,
+    const size_t start
+) const
+{
+    return index_of_impl(other.buffer, other.bfr_length, start);
+}
+
+// @throws RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+size_t BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::index_of(
+    const char* const text,
+    const size_t start
+) const
+{
+    return index_of_impl(text, CharKernels::bounded_c_str_length(text, MAX_CAPACITY), start);
+}
+
+// @throws RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+size_t BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::index_of(
+    const CharPattern& pattern,
+    const size_t start
+) const
+{
+    CheckPolicy::check(start <= bfr_length);
+    return pattern.find_in(buffer, bfr_length, start);
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+const char* BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::c_str() const noexcept
+{
+    return buffer;
+}
+
+// @throws std::bad_alloc
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::init_buffer(const size_t buffer_capacity)
+{
+    if (buffer_capacity >= MAX_CAPACITY)
+    {
+        throw std::bad_alloc();
+    }
+    if (buffer_capacity <= InlineCapacity)
+    {
+        buffer = inline_buffer;
+    }
+    else
+    {
+        buffer = alloc_traits::allocate(*this, buffer_capacity + 1);
+    }
+    bfr_capacity = buffer_capacity;
+}
+
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::release_buffer() noexcept
+{
+    if (buffer != inline_buffer)
+    {
+        alloc_traits::deallocate(*this, buffer, bfr_capacity + 1);
+    }
+}
+
+// Replaces the storage by storage for the specified capacity, which must not be less than the current length
+// @throws std::bad_alloc
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::reallocate(const size_t new_capacity)
+{
+    if (new_capacity >= MAX_CAPACITY)
+    {
+        throw std::bad_alloc();
+    }
+    char* new_buffer = inline_buffer;
+    if (new_capacity > InlineCapacity)
+    {
+        new_buffer = alloc_traits::allocate(*this, new_capacity + 1);
+    }
+    if (new_buffer != buffer)
+    {
+        std::memcpy(new_buffer, buffer, bfr_length + 1);
+        release_buffer();
+        buffer = new_buffer;
+    }
+    bfr_capacity = new_capacity;
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::make_room(
+    const size_t offset,
+    const size_t count
+)
+{
+    if (count > bfr_capacity - offset)
+    {
+        if (growth_policy().is_growable())
+        {
+            CheckPolicy::check(count < MAX_CAPACITY - offset);
+            reallocate(GrowthPolicy::next_capacity(bfr_capacity, offset + count, MAX_CAPACITY));
+        }
+        else
+        {
+            CheckPolicy::check(false);
+        }
+    }
+}
+
+// Variant of make_room for source data that may point into this buffer's storage
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::make_room(
+    const size_t offset,
+    const size_t count,
+    const char*& src_data
+)
+{
+    const char* const prev_buffer = buffer;
+    make_room(offset, count);
+    if (buffer != prev_buffer && src_data >= prev_buffer && src_data <= prev_buffer + bfr_length)
+    {
+        src_data = buffer + (src_data - prev_buffer);
+    }
+}
+
+// Takes over the storage of orig, or copies its content if the storage is inline
+// orig is left empty, with a capacity of zero and its inline storage.
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::take_storage(BasicCharBuffer& orig) noexcept
+{
+    bfr_capacity = orig.bfr_capacity;
+    bfr_length = orig.bfr_length;
+    if (orig.buffer == orig.inline_buffer)
+    {
+        buffer = inline_buffer;
+        std::memcpy(inline_buffer, orig.inline_buffer, bfr_length + 1);
+    }
+    else
+    {
+        buffer = orig.buffer;
+    }
+    orig.buffer = orig.inline_buffer;
+    orig.bfr_capacity = 0;
+    orig.bfr_length = 0;
+    orig.buffer[0] = '\0';
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::assign_impl(
+    const char* const data,
+    const size_t start,
+    const size_t end
+)
+{
+    const size_t copy_length = end - start;
+    const char* src_data = data;
+    make_room(0, copy_length, src_data);
+    std::memmove(buffer, &(src_data[start]), copy_length);
+    bfr_length = copy_length;
+    buffer[bfr_length] = '\0';
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::append_impl(
+    const char* const data,
+    const size_t start,
+    const size_t end
+)
+{
+    const size_t copy_length = end - start;
+    const char* src_data = data;
+    make_room(bfr_length, copy_length, src_data);
+    std::memmove(&(buffer[bfr_length]), &(src_data[start]), copy_length);
+    bfr_length += copy_length;
+    buffer[bfr_length] = '\0';
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+void BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::overwrite_impl(
+    const size_t dst_start,
+    const char* const data,
+    const size_t data_length
+)
+{
+    CheckPolicy::check(dst_start <= bfr_length);
+    const char* src_data = data;
+    make_room(dst_start, data_length, src_data);
+    std::memmove(&(buffer[dst_start]), src_data, data_length);
+    const size_t new_length = dst_start + data_length;
+    if (new_length > bfr_length)
+    {
+        bfr_length = new_length;
+        buffer[bfr_length] = '\0';
+    }
+}
+
+// @throws RangeException
+template<typename CheckPolicy, typename GrowthPolicy, typename Allocator, size_t InlineCapacity>
+size_t BasicCharBuffer<CheckPolicy, GrowthPolicy, Allocator, InlineCapacity>::index_of_impl(
+    const char* const pattern,
+    const size_t pat_length,
+    const size_t start
+) const
+{
+    CheckPolicy::check(start <= bfr_length);
+    return CharPattern::find(buffer, bfr_length, pattern, pat_length, start);
+}
+
+#endif /* BASICCHARBUFFER_H */
@@ -0,0 +1,66 @@
+#include <CharAllocator.h>
+
+CharAllocator::CharAllocator()
+{
+}
+
+CharAllocator::~CharAllocator() noexcept
+{
+}
+
+CharAllocatorAdapter::CharAllocatorAdapter() noexcept:
+    source(nullptr)
+{
+}
+
+CharAllocatorAdapter::CharAllocatorAdapter(CharAllocator* const allocator) noexcept:
+    source(allocator)
+{
+}
+
+// @throws std::bad_alloc
+char* CharAllocatorAdapter::allocate(const size_t size)
+{
+    char* storage = nullptr;
+    if (source != nullptr)
+    {
+        storage = source->allocate(size);
+    }
+    else
+    {
+        storage = new char[size];
+    }
+    return storage;
+}
+
+void CharAllocatorAdapter::deallocate(char* const storage, const size_t size) noexcept
+{
+    if (source != nullptr)
+    {
+        source->deallocate(storage, size);
+    }
+    else
+    {
+        delete[] storage;
+    }
+}
+
+CharAllocatorAdapter CharAllocatorAdapter::select_on_container_copy_construction() const noexcept
+{
+    return CharAllocatorAdapter();
+}
+
+CharAllocator* CharAllocatorAdapter::char_allocator() const noexcept
+{
+    return source;
+}
+
+bool CharAllocatorAdapter::operator==(const CharAllocatorAdapter& other) const noexcept
+{
+    return source == other.source;
+}
+
+bool CharAllocatorAdapter::operator!=(const CharAllocatorAdapter& other) const noexcept
+{
+    return source != other.source;
+}
@@ -0,0 +1,57 @@
+#ifndef CHARALLOCATOR_H
+#define CHARALLOCATOR_H
+
+#include <new>
+#include <cstddef>
+#include <type_traits>
+
+// Storage source for the content of CharBuffer instances
+// A CharBuffer that is constructed with an allocator obtains its storage from the allocator
+// and returns it to the allocator upon destruction.
+// The allocator must outlive all CharBuffer instances that use it.
+class CharAllocator
+{
+  public:
+    CharAllocator();
+    virtual ~CharAllocator() noexcept;
+
+    CharAllocator(const CharAllocator& orig) = delete;
+    CharAllocator& operator=(const CharAllocator& orig) = delete;
+    CharAllocator(CharAllocator&& orig) = delete;
+    CharAllocator& operator=(CharAllocator&& orig) = delete;
+
+    // @throws std::bad_alloc
+    virtual char* allocate(size_t size) = 0;
+
+    virtual void deallocate(char* storage, size_t size) noexcept = 0;
+};
+
+// Standard allocator for char that obtains storage from a CharAllocator, or from the heap if there is none
+// Copies of a container use the heap, independent of the CharAllocator of the original.
+class CharAllocatorAdapter
+{
+  public:
+    typedef char value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+
+    CharAllocatorAdapter() noexcept;
+    explicit CharAllocatorAdapter(CharAllocator* allocator) noexcept;
+
+    // @throws std::bad_alloc
+    char* allocate(size_t size);
+
+    void deallocate(char* storage, size_t size) noexcept;
+
+    CharAllocatorAdapter select_on_container_copy_construction() const noexcept;
+
+    // Returns nullptr if storage is obtained from the heap
+    CharAllocator* char_allocator() const noexcept;
+
+    bool operator==(const CharAllocatorAdapter& other) const noexcept;
+    bool operator!=(const CharAllocatorAdapter& other) const noexcept;
+
+  private:
+    CharAllocator* source;
+};
+
+#endif /* CHARALLOCATOR_H */
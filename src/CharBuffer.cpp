@@ -1,22 +1,32 @@
 #include <CharBuffer.h>
 
+#include <new>
+#include <memory>
 #include <stdexcept>
 #include <cstring>
+#include <cerrno>
+#include <climits>
+
+#include <unistd.h>
+#include <sys/uio.h>
 
 #include <RangeException.h>
+#include <CharKernels.h>
+#include <CharPattern.h>
+#include <CharAllocator.h>
+#include <CharBufferHash.h>
+#include <CharNumbers.h>
+#include <IoException.h>
 
 // Maximum net capacity of a CharBuffer
 // This is the maximum number of characters that any CharBuffer instance can contain,
 // without the trailing null character.
-const size_t CharBuffer::MAX_CAPACITY = (~static_cast<size_t> (0)) - 1;
-
-const size_t CharBuffer::NPOS = ~static_cast<size_t> (0);
+const size_t CharBuffer::MAX_CAPACITY = Storage::MAX_CAPACITY;
 
-// @throws RangeException
-inline static char* char_at(size_t idx, char* buffer, size_t length);
+const size_t CharBuffer::NPOS = Storage::NPOS;
 
-// @throws RangeException
-inline static size_t safe_c_str_length(const char* buffer);
+// Buffers up to this capacity store their content inside of the CharBuffer instance
+const size_t CharBuffer::INLINE_CAPACITY;
 
 inline static void copy_buffer(
     const char* src_buffer,
@@ -26,144 +36,152 @@ inline static void copy_buffer(
     size_t dst_offset
 );
 
-inline static int compare_buffer(
+// @throws IoException
+inline static void write_fully(int fd, const char* data, size_t length);
+
+// Calls consumer(index) for each match of the pattern in data[0, length)
+template<typename Consumer>
+inline static void for_each_match(
+    const char* data,
+    size_t length,
+    const char* pattern,
+    size_t pat_length,
+    const CharPattern* compiled_pattern,
+    CharBuffer::MatchMode mode,
+    Consumer&& consumer
+);
+
+inline static size_t index_of_impl(
+    const char* buffer,
+    size_t length,
+    const char* pattern,
+    size_t pat_length,
+    size_t start_offset
+);
+
+// @throws RangeException
+inline static size_t replaced_length(size_t length, size_t pat_length, size_t repl_length, size_t match_count);
+
+inline static char ascii_lower(char letter) noexcept;
+
+inline static int compare_icase_impl(
     const char* buffer,
+    size_t length,
     const char* other_buffer,
-    size_t compare_length
+    size_t other_length
 );
 
-inline static bool match_buffer(
+inline static bool equals_icase_impl(
     const char* buffer,
+    size_t length,
     const char* other_buffer,
-    size_t match_length
+    size_t other_length
 );
 
-inline static size_t index_of_impl(
+inline static bool starts_with_icase_impl(
+    const char* buffer,
+    size_t length,
+    const char* other_buffer,
+    size_t other_length
+);
+
+inline static size_t index_of_icase_impl(
     const char* buffer,
     size_t length,
     const char* pattern,
     size_t pat_length,
-    size_t start_offset,
-    size_t end_offset
+    size_t start_offset
 );
 
 // @throws std::bad_alloc
 CharBuffer::CharBuffer(const size_t buffer_capacity):
-    bfr_capacity(buffer_capacity)
+    storage(buffer_capacity),
+    bfr_hash_caching(false),
+    bfr_hash_valid(false)
 {
-    if (buffer_capacity < MAX_CAPACITY)
-    {
-        buffer_mgr = std::unique_ptr<char[]>(new char[buffer_capacity + 1]);
-        buffer = buffer_mgr.get();
-        bfr_length = 0;
-        buffer[bfr_length] = '\0';
-    }
-    else
-    {
-        throw std::bad_alloc();
-    }
 }
 
 // @throws std::bad_alloc, RangeException
-CharBuffer::CharBuffer(const char* const text)
+CharBuffer::CharBuffer(const char* const text):
+    storage(text),
+    bfr_hash_caching(false),
+    bfr_hash_valid(false)
 {
-    size_t text_length = safe_c_str_length(text);
-    if (text_length < MAX_CAPACITY)
-    {
-        bfr_capacity = text_length;
-        buffer_mgr = std::unique_ptr<char[]>(new char[bfr_capacity + 1]);
-        buffer = buffer_mgr.get();
-        copy_buffer(text, 0, text_length, buffer, 0);
-        bfr_length = text_length;
-    }
-    else
-    {
-        throw std::bad_alloc();
-    }
 }
 
 // @throws std::bad_alloc, RangeException
 CharBuffer::CharBuffer(const size_t buffer_capacity, const char* const text):
-    bfr_capacity(buffer_capacity)
+    storage(buffer_capacity, text),
+    bfr_hash_caching(false),
+    bfr_hash_valid(false)
 {
-    if (bfr_capacity < MAX_CAPACITY)
-    {
-        buffer_mgr = std::unique_ptr<char[]>(new char[bfr_capacity + 1]);
-        buffer = buffer_mgr.get();
+}
 
-        size_t text_length = safe_c_str_length(text);
-        if (text_length <= bfr_capacity)
-        {
-            copy_buffer(text, 0, text_length, buffer, 0);
-        }
-        else
-        {
-            throw RangeException();
-        }
-        bfr_length = text_length;
-    }
-    else
-    {
-        throw std::bad_alloc();
-    }
+// @throws std::bad_alloc
+CharBuffer::CharBuffer(const size_t buffer_capacity, CharAllocator& allocator):
+    storage(buffer_capacity, CharAllocatorAdapter(&allocator)),
+    bfr_hash_caching(false),
+    bfr_hash_valid(false)
+{
+}
+
+// @throws std::bad_alloc, RangeException
+CharBuffer::CharBuffer(const char* const text, CharAllocator& allocator):
+    storage(text, CharAllocatorAdapter(&allocator)),
+    bfr_hash_caching(false),
+    bfr_hash_valid(false)
+{
+}
+
+// @throws std::bad_alloc, RangeException
+CharBuffer::CharBuffer(const size_t buffer_capacity, const char* const text, CharAllocator& allocator):
+    storage(buffer_capacity, text, CharAllocatorAdapter(&allocator)),
+    bfr_hash_caching(false),
+    bfr_hash_valid(false)
+{
 }
 
 CharBuffer::~CharBuffer() noexcept
 {
 }
 
+// Copies obtain their storage from the heap, independent of the allocator used by the original
 // @throws std::bad_alloc
 CharBuffer::CharBuffer(const CharBuffer& orig):
-    bfr_capacity(orig.bfr_capacity),
-    bfr_length(orig.bfr_length),
-    buffer_mgr(new char[orig.bfr_capacity + 1])
+    storage(orig.storage),
+    bfr_hash_caching(orig.bfr_hash_caching),
+    bfr_hash_valid(false)
 {
-    buffer = buffer_mgr.get();
-    copy_buffer(orig.buffer, 0, bfr_length, buffer, 0);
 }
 
+// Leaves orig as an empty buffer with a capacity of zero
 CharBuffer::CharBuffer(CharBuffer&& orig):
-    bfr_capacity(orig.bfr_capacity),
-    bfr_length(orig.bfr_length),
-    buffer(orig.buffer)
+    storage(std::move(orig.storage)),
+    bfr_hash_caching(orig.bfr_hash_caching),
+    bfr_hash_valid(orig.bfr_hash_valid.load(std::memory_order_relaxed)),
+    bfr_hash(orig.bfr_hash.load(std::memory_order_relaxed))
 {
-    buffer_mgr = std::move(orig.buffer_mgr);
-    orig.buffer = nullptr;
-    orig.bfr_length = 0;
-    orig.bfr_capacity = 0;
+    orig.invalidate_hash();
 }
 
-
 // @throws RangeException
 CharBuffer& CharBuffer::operator=(const CharBuffer& orig)
 {
-    if (this != &orig)
-    {
-        if (orig.bfr_length <= bfr_capacity)
-        {
-            bfr_length = orig.bfr_length;
-            copy_buffer(orig.buffer, 0, bfr_length, buffer, 0);
-        }
-        else
-        {
-            throw RangeException();
-        }
-    }
+    invalidate_hash();
+    storage = orig.storage;
     return *this;
 }
 
+// Leaves orig as an empty buffer with a capacity of zero
 CharBuffer& CharBuffer::operator=(CharBuffer&& orig)
 {
     if (this != &orig)
     {
-        buffer = orig.buffer;
-        bfr_length = orig.bfr_length;
-        bfr_capacity = orig.bfr_capacity;
-
-        buffer_mgr = std::move(orig.buffer_mgr);
-        orig.buffer = nullptr;
-        orig.bfr_length = 0;
-        orig.bfr_capacity = 0;
+        storage = std::move(orig.storage);
+        bfr_hash_caching = orig.bfr_hash_caching;
+        bfr_hash.store(orig.bfr_hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        bfr_hash_valid.store(orig.bfr_hash_valid.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        orig.invalidate_hash();
     }
     return *this;
 }
@@ -171,42 +189,24 @@ CharBuffer& CharBuffer::operator=(CharBuffer&& orig)
 // @throws RangeException
 CharBuffer& CharBuffer::operator=(const char* const text)
 {
-    const size_t text_length = safe_c_str_length(text);
-    if (text_length <= bfr_capacity)
-    {
-        for (size_t idx = 0; idx < text_length; ++idx)
-        {
-            buffer[idx] = text[idx];
-        }
-        bfr_length = text_length;
-        buffer[bfr_length] = '\0';
-    }
-    else
-    {
-        throw RangeException();
-    }
+    invalidate_hash();
+    storage = text;
     return *this;
 }
 
 bool CharBuffer::operator==(const CharBuffer& other) const noexcept
 {
-    bool equal_flag = false;
-    if (bfr_length == other.bfr_length)
-    {
-        equal_flag = match_buffer(buffer, other.buffer, bfr_length);
-    }
-    return equal_flag;
+    return storage == other.storage;
 }
 
 bool CharBuffer::operator==(const char* const text) const noexcept
 {
-    bool equal_flag = false;
-    const size_t text_length = safe_c_str_length(text);
-    if (bfr_length == text_length)
-    {
-        equal_flag = match_buffer(buffer, text, bfr_length);
-    }
-    return equal_flag;
+    return storage == text;
+}
+
+bool CharBuffer::equals_raw(const char* const data, const size_t length) const noexcept
+{
+    return storage.equals_raw(data, length);
 }
 
 bool CharBuffer::operator<(const CharBuffer& other) const noexcept
@@ -252,175 +252,156 @@ bool CharBuffer::operator>=(const char* const text) const noexcept
 // @throws RangeException
 void CharBuffer::operator+=(const CharBuffer& other)
 {
-    const size_t remain = bfr_capacity - bfr_length;
-    if (other.bfr_length <= remain)
-    {
-        copy_buffer(other.buffer, 0, other.bfr_length, buffer, bfr_length);
-        bfr_length += other.bfr_length;
-    }
-    else
-    {
-        throw RangeException();
-    }
+    invalidate_hash();
+    storage += other.storage;
 }
 
 // @throws RangeException
 void CharBuffer::operator+=(const char* const text)
 {
-    const size_t remain = bfr_capacity - bfr_length;
-    const size_t text_length = safe_c_str_length(text);
-    if (text_length <= remain)
-    {
-        copy_buffer(text, 0, text_length, buffer, bfr_length);
-        bfr_length += text_length;
-    }
-    else
-    {
-        throw RangeException();
-    }
+    invalidate_hash();
+    storage += text;
 }
 
 // @throws RangeException
 void CharBuffer::operator+=(const char in_char)
 {
-    if (bfr_length < bfr_capacity)
-    {
-        buffer[bfr_length] = in_char;
-        ++bfr_length;
-        buffer[bfr_length] = '\0';
-    }
-    else
-    {
-        throw RangeException();
-    }
+    invalidate_hash();
+    storage += in_char;
 }
 
 // @throws RangeException
 char& CharBuffer::operator[](const size_t index)
 {
-    return *(char_at(index, buffer, bfr_length));
+    invalidate_hash();
+    return storage[index];
 }
 
 // @throws RangeException
 const char& CharBuffer::operator[](const size_t index) const
 {
-    return *(char_at(index, buffer, bfr_length));
+    return storage[index];
 }
 
 bool CharBuffer::is_empty() const noexcept
 {
-    return (bfr_length == 0);
+    return storage.is_empty();
 }
 
 size_t CharBuffer::length() const noexcept
 {
-    return bfr_length;
+    return storage.length();
 }
 
 size_t CharBuffer::capacity() const noexcept
 {
-    return bfr_capacity;
+    return storage.capacity();
 }
 
 void CharBuffer::clear() noexcept
 {
-    bfr_length = 0;
-    buffer[bfr_length] = '\0';
+    invalidate_hash();
+    storage.clear();
 }
 
 void CharBuffer::wipe() noexcept
 {
-    volatile char* const wipe_buffer = buffer;
-    for (size_t idx = 0; idx <= bfr_capacity; ++idx)
-    {
-        wipe_buffer[idx] = 0;
-    }
+    invalidate_hash();
+    storage.wipe();
 }
 
 void CharBuffer::truncate(const size_t new_length) noexcept
 {
-    if (new_length < bfr_length)
-    {
-        bfr_length = new_length;
-        buffer[bfr_length] = '\0';
-    }
+    invalidate_hash();
+    storage.truncate(new_length);
 }
 
-// @throws RangeException
-void CharBuffer::copy_raw(const char* const data, const size_t length)
+void CharBuffer::set_growable(const bool growable) noexcept
+{
+    storage.growth_policy().set_growable(growable);
+}
+
+bool CharBuffer::is_growable() const noexcept
+{
+    return storage.is_growable();
+}
+
+void CharBuffer::set_hash_caching(const bool hash_caching) noexcept
+{
+    bfr_hash_caching = hash_caching;
+    invalidate_hash();
+}
+
+bool CharBuffer::is_hash_caching() const noexcept
+{
+    return bfr_hash_caching;
+}
+
+bool CharBuffer::has_custom_allocator() const noexcept
+{
+    return storage.get_allocator().char_allocator() != nullptr;
+}
+
+size_t CharBuffer::hash() const noexcept
 {
-    if (length <= bfr_capacity)
+    size_t hash_value = 0;
+    if (bfr_hash_valid.load(std::memory_order_acquire))
     {
-        copy_buffer(data, 0, length, buffer, 0);
-        bfr_length = length;
+        hash_value = bfr_hash.load(std::memory_order_relaxed);
     }
     else
     {
-        throw RangeException();
+        hash_value = static_cast<size_t> (CharBufferHash::hash(storage.buffer, storage.bfr_length));
+        if (bfr_hash_caching)
+        {
+            bfr_hash.store(hash_value, std::memory_order_relaxed);
+            bfr_hash_valid.store(true, std::memory_order_release);
+        }
     }
+    return hash_value;
+}
+
+// @throws std::bad_alloc
+void CharBuffer::reserve(const size_t min_capacity)
+{
+    storage.reserve(min_capacity);
+}
+
+// @throws std::bad_alloc
+void CharBuffer::shrink_to_fit()
+{
+    storage.shrink_to_fit();
 }
 
 // @throws RangeException
-void CharBuffer::substring(const size_t start, const size_t end)
+void CharBuffer::copy_raw(const char* const data, const size_t length)
 {
-    if (start <= end && end <= bfr_length)
-    {
-        if (start > 0)
-        {
-            copy_buffer(buffer, start, end, buffer, 0);
-            bfr_length = end - start;
-        }
-        else
-        {
-            bfr_length = end;
-            buffer[bfr_length] = '\0';
-        }
-    }
-    else
-    {
-        throw RangeException();
-    }
+    invalidate_hash();
+    storage.copy_raw(data, length);
+}
 
+// @throws RangeException
+void CharBuffer::substring(const size_t start, const size_t end)
+{
+    invalidate_hash();
+    storage.substring(start, end);
 }
 
 // @throws RangeException
 void CharBuffer::substring_from(const CharBuffer& other, const size_t start, const size_t end)
 {
-    if (start <= end && end <= other.bfr_length)
-    {
-        const size_t substr_length = end - start;
-        if (substr_length <= bfr_capacity)
-        {
-            copy_buffer(other.buffer, start, end, buffer, 0);
-            bfr_length = substr_length;
-        }
-        else
-        {
-            throw RangeException();
-        }
-    }
-    else
-    {
-        throw RangeException();
-    }
+    invalidate_hash();
+    storage.substring_from(other.storage, start, end);
 }
 
 // @throws RangeException
 void CharBuffer::substring_from(const char* const text, const size_t start, const size_t end)
 {
-    const size_t text_length = safe_c_str_length(text);
+    invalidate_hash();
+    const size_t text_length = CharKernels::bounded_c_str_length(text, MAX_CAPACITY);
     if (start <= end && end <= text_length)
     {
-        const size_t substr_length = end - start;
-        if (substr_length <= bfr_capacity)
-        {
-            copy_buffer(text, start, end, buffer, 0);
-            bfr_length = substr_length;
-        }
-        else
-        {
-            throw RangeException();
-        }
+        storage.assign_impl(text, start, end);
     }
     else
     {
@@ -432,18 +413,10 @@ void CharBuffer::substring_from(const char* const text, const size_t start, cons
 // @throws RangeException
 void CharBuffer::substring_raw_from(const char* const data, const size_t start, const size_t end)
 {
+    invalidate_hash();
     if (start <= end)
     {
-        const size_t substr_length = end - start;
-        if (substr_length <= bfr_capacity)
-        {
-            copy_buffer(data, start, end, buffer, 0);
-            bfr_length = substr_length;
-        }
-        else
-        {
-            throw RangeException();
-        }
+        storage.assign_impl(data, start, end);
     }
     else
     {
@@ -454,62 +427,101 @@ void CharBuffer::substring_raw_from(const char* const data, const size_t start,
 // @throws RangeException
 void CharBuffer::append(const CharBuffer& other, const size_t start, const size_t end)
 {
-    const size_t remain = bfr_capacity - bfr_length;
-    if (start <= end && end <= other.bfr_length)
-    {
-        const size_t substr_length = end - start;
-        if (substr_length <= remain)
-        {
-            copy_buffer(other.buffer, start, end, buffer, bfr_length);
-            bfr_length += substr_length;
-        }
-        else
-        {
-            throw RangeException();
-        }
-    }
-    else
-    {
-        throw RangeException();
-    }
+    invalidate_hash();
+    storage.append(other.storage, start, end);
 }
 
 // @throws RangeException
 void CharBuffer::append_raw(const char* const data, const size_t data_length)
 {
-    const size_t remain = bfr_capacity - bfr_length;
-    if (data_length <= remain)
-    {
-        copy_buffer(data, 0, data_length, buffer, bfr_length);
-        bfr_length += data_length;
-    }
-    else
-    {
-        throw RangeException();
-    }
+    invalidate_hash();
+    storage.append_raw(data, data_length);
 }
 
 // @throws RangeException
 void CharBuffer::append_raw(const char* const data, const size_t start, const size_t end)
 {
-    const size_t remain = bfr_capacity - bfr_length;
-    if (start <= end)
+    invalidate_hash();
+    storage.append_raw(data, start, end);
+}
+
+// @throws std::bad_alloc, RangeException
+void CharBuffer::append_views(const CharBufferView* const pieces, const size_t count)
+{
+    invalidate_hash();
+    const size_t total_length = views_length(pieces, count);
+    const char* const prev_buffer = storage.buffer;
+    storage.make_room(storage.bfr_length, total_length);
+
+    size_t offset = storage.bfr_length;
+    for (size_t idx = 0; idx < count; ++idx)
     {
-        const size_t substr_length = end - start;
-        if (substr_length <= remain)
-        {
-            copy_buffer(data, start, end, buffer, bfr_length);
-            bfr_length += substr_length;
-        }
-        else
+        const size_t piece_length = pieces[idx].length();
+        if (piece_length > 0)
         {
-            throw RangeException();
+            // Views of this buffer's content refer to the previous storage if the buffer was reallocated
+            const char* src_data = pieces[idx].data();
+            if (
+                storage.buffer != prev_buffer &&
+                src_data >= prev_buffer &&
+                src_data <= prev_buffer + storage.bfr_length
+            )
+            {
+                src_data = storage.buffer + (src_data - prev_buffer);
+            }
+            copy_buffer(src_data, 0, piece_length, storage.buffer, offset);
+            offset += piece_length;
         }
     }
-    else
+    storage.bfr_length = offset;
+}
+
+// @throws std::bad_alloc, RangeException
+void CharBuffer::append_int(const long long value)
+{
+    invalidate_hash();
+    const size_t sign_length = value < 0 ? 1 : 0;
+    const uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t> (value) : static_cast<uint64_t> (value);
+    const size_t digit_count = CharNumbers::decimal_length(magnitude);
+    storage.make_room(storage.bfr_length, sign_length + digit_count);
+    if (sign_length > 0)
     {
-        throw RangeException();
+        storage.buffer[storage.bfr_length] = '-';
     }
+    CharNumbers::write_decimal(magnitude, &(storage.buffer[storage.bfr_length + sign_length]), digit_count);
+    storage.bfr_length += sign_length + digit_count;
+    storage.buffer[storage.bfr_length] = '\0';
+}
+
+// @throws std::bad_alloc, RangeException
+void CharBuffer::append_uint(const unsigned long long value)
+{
+    invalidate_hash();
+    const size_t digit_count = CharNumbers::decimal_length(value);
+    storage.make_room(storage.bfr_length, digit_count);
+    CharNumbers::write_decimal(value, &(storage.buffer[storage.bfr_length]), digit_count);
+    storage.bfr_length += digit_count;
+    storage.buffer[storage.bfr_length] = '\0';
+}
+
+// @throws std::bad_alloc, RangeException
+void CharBuffer::append_hex(const unsigned long long value)
+{
+    invalidate_hash();
+    const size_t digit_count = CharNumbers::hex_length(value);
+    storage.make_room(storage.bfr_length, digit_count);
+    CharNumbers::write_hex(value, &(storage.buffer[storage.bfr_length]), digit_count);
+    storage.bfr_length += digit_count;
+    storage.buffer[storage.bfr_length] = '\0';
+}
+
+// @throws std::bad_alloc, RangeException
+void CharBuffer::append_double(const double value)
+{
+    // The length of the representation is not known in advance, so it is formatted on the stack
+    char text[CharNumbers::MAX_DOUBLE_LENGTH];
+    const size_t text_length = CharNumbers::format_double(value, text);
+    append_raw(text, text_length);
 }
 
 // @throws RangeException
@@ -518,7 +530,7 @@ void CharBuffer::overwrite_with(
     const CharBuffer& other
 )
 {
-    overwrite_impl(dst_start, other.buffer, other.bfr_length, 0, other.bfr_length);
+    overwrite_impl(dst_start, other.storage.buffer, other.storage.bfr_length, 0, other.storage.bfr_length);
 }
 
 // @throws RangeException
@@ -529,7 +541,7 @@ void CharBuffer::overwrite_with(
     const size_t src_end
 )
 {
-    overwrite_impl(dst_start, other.buffer, other.bfr_length, src_start, src_end);
+    overwrite_impl(dst_start, other.storage.buffer, other.storage.bfr_length, src_start, src_end);
 }
 
 // @throws RangeException
@@ -540,7 +552,7 @@ void CharBuffer::overwrite_with(
     const size_t src_end
 )
 {
-    size_t text_length = safe_c_str_length(text);
+    size_t text_length = CharKernels::bounded_c_str_length(text, MAX_CAPACITY);
     overwrite_impl(dst_start, text, text_length, src_start, src_end);
 }
 
@@ -550,244 +562,431 @@ void CharBuffer::overwrite_with(
     const char* const text
 )
 {
-    size_t text_length = safe_c_str_length(text);
+    size_t text_length = CharKernels::bounded_c_str_length(text, MAX_CAPACITY);
     overwrite_impl(dst_start, text, text_length, 0, text_length);
 }
 
 // @throws RangeException
-inline void CharBuffer::overwrite_impl(
+void CharBuffer::overwrite_with_raw(
     const size_t dst_start,
-    const char* const src_buffer,
-    const size_t src_length,
-    const size_t src_start,
-    const size_t src_end
+    const char* const data,
+    const size_t length
 )
 {
-    if (dst_start > bfr_capacity || dst_start > bfr_length || src_start > src_end || src_end > src_length)
-    {
-        throw RangeException();
-    }
-
-    const size_t remain = bfr_capacity - dst_start;
-    const size_t copy_length = src_end - src_start;
-    if (remain < copy_length)
-    {
-        throw RangeException();
-    }
-
-    size_t dst_idx = dst_start;
-    size_t src_idx = src_start;
-    while (src_idx < src_end)
-    {
-        buffer[dst_idx] = src_buffer[src_idx];
-        ++dst_idx;
-        ++src_idx;
-    }
-    size_t new_length = dst_start + copy_length;
-    if (new_length > bfr_length)
-    {
-        buffer[new_length] = '\0';
-        bfr_length = new_length;
-    }
+    overwrite_impl(dst_start, data, length, 0, length);
 }
 
-void CharBuffer::fill(const char fill_char) noexcept
+inline void CharBuffer::invalidate_hash() noexcept
 {
-    for (size_t idx = bfr_length; idx < bfr_capacity; ++idx)
-    {
-        buffer[idx] = fill_char;
-    }
-    bfr_length = bfr_capacity;
-    buffer[bfr_length] = '\0';
+    bfr_hash_valid.store(false, std::memory_order_relaxed);
 }
 
-void CharBuffer::fill(const char fill_char, const size_t target_length)
+// @throws RangeException
+size_t CharBuffer::views_length(const CharBufferView* const pieces, const size_t count)
 {
-    if (target_length <= bfr_capacity)
+    size_t total_length = 0;
+    for (size_t idx = 0; idx < count; ++idx)
     {
-        for (size_t idx = bfr_length; idx < target_length; ++idx)
+        if (pieces[idx].length() > MAX_CAPACITY - total_length)
         {
-            buffer[idx] = fill_char;
+            throw RangeException();
         }
-        bfr_length = target_length;
-        buffer[bfr_length] = '\0';
-    }
-    else
-    {
-        throw RangeException();
+        total_length += pieces[idx].length();
     }
+    return total_length;
 }
 
-int CharBuffer::compare_to(const CharBuffer& other) const noexcept
-{
-    int result = 0;
-    if (bfr_length == other.bfr_length)
+// @throws std::bad_alloc, RangeException
+inline size_t CharBuffer::replace_impl(
+    const char* const pattern,
+    const size_t pat_length,
+    const CharPattern* const compiled_pattern,
+    const char* const replacement,
+    const size_t repl_length
+)
+{
+    if (pat_length == 0)
     {
-        result = compare_buffer(buffer, other.buffer, bfr_length);
+        throw RangeException();
+    }
+
+    invalidate_hash();
+    size_t replace_count = 0;
+    if (repl_length <= pat_length)
+    {
+        // The content is compacted towards the start while it is being searched; each write ends
+        // at or before the end of the match that has just been found, where the next search starts
+        size_t read_idx = 0;
+        size_t write_idx = 0;
+        for_each_match(
+            storage.buffer, storage.bfr_length, pattern, pat_length, compiled_pattern, MatchMode::NON_OVERLAPPING,
+            [&](const size_t index)
+            {
+                const size_t keep_length = index - read_idx;
+                if (write_idx != read_idx)
+                {
+                    std::memmove(&(storage.buffer[write_idx]), &(storage.buffer[read_idx]), keep_length);
+                }
+                write_idx += keep_length;
+                std::memcpy(&(storage.buffer[write_idx]), replacement, repl_length);
+                write_idx += repl_length;
+                read_idx = index + pat_length;
+                ++replace_count;
+            }
+        );
+        if (replace_count > 0)
+        {
+            copy_buffer(storage.buffer, read_idx, storage.bfr_length, storage.buffer, write_idx);
+            storage.bfr_length = write_idx + (storage.bfr_length - read_idx);
+        }
     }
     else
     {
-        const size_t cmp_length = bfr_length <= other.bfr_length ? bfr_length : other.bfr_length;
-        result = compare_buffer(buffer, other.buffer, cmp_length);
-        if (result == 0)
+        std::vector<size_t> matches;
+        for_each_match(
+            storage.buffer, storage.bfr_length, pattern, pat_length, compiled_pattern, MatchMode::NON_OVERLAPPING,
+            [&matches](const size_t index)
+            {
+                matches.push_back(index);
+            }
+        );
+        replace_count = matches.size();
+        if (replace_count > 0)
         {
-            result = bfr_length < other.bfr_length ? -1 : 1;
+            const size_t new_length = replaced_length(storage.bfr_length, pat_length, repl_length, replace_count);
+            storage.make_room(0, new_length);
+
+            // The content is expanded from the end, so that each move reads characters before
+            // they are overwritten
+            storage.buffer[new_length] = '\0';
+            size_t read_end = storage.bfr_length;
+            size_t write_end = new_length;
+            for (size_t match_idx = replace_count; match_idx > 0; --match_idx)
+            {
+                const size_t index = matches[match_idx - 1];
+                const size_t keep_length = read_end - (index + pat_length);
+                write_end -= keep_length;
+                std::memmove(&(storage.buffer[write_end]), &(storage.buffer[index + pat_length]), keep_length);
+                write_end -= repl_length;
+                std::memcpy(&(storage.buffer[write_end]), replacement, repl_length);
+                read_end = index;
+            }
+            storage.bfr_length = new_length;
         }
     }
-    return result;
+    return replace_count;
 }
 
-// @throws RangeException
-int CharBuffer::compare_to(const char* const text) const noexcept
+// @throws std::bad_alloc, RangeException
+inline size_t CharBuffer::replace_from_impl(
+    const CharBuffer& source,
+    const char* const pattern,
+    const size_t pat_length,
+    const CharPattern* const compiled_pattern,
+    const char* const replacement,
+    const size_t repl_length
+)
 {
-    int result = 0;
-    const size_t text_length = safe_c_str_length(text);
-    if (bfr_length == text_length)
+    if (pat_length == 0)
     {
-        result = compare_buffer(buffer, text, text_length);
+        throw RangeException();
     }
-    else
+
+    const char* const src_buffer = source.storage.buffer;
+    const size_t src_length = source.storage.bfr_length;
+    size_t replace_count = 0;
+    for_each_match(
+        src_buffer, src_length, pattern, pat_length, compiled_pattern, MatchMode::NON_OVERLAPPING,
+        [&replace_count](const size_t)
+        {
+            ++replace_count;
+        }
+    );
+    const size_t new_length = replaced_length(src_length, pat_length, repl_length, replace_count);
+    if (new_length > storage.bfr_capacity)
     {
-        const size_t cmp_length = bfr_length <= text_length ? bfr_length : text_length;
-        result = compare_buffer(buffer, text, cmp_length);
-        if (result == 0)
+        if (storage.is_growable() && new_length < MAX_CAPACITY)
         {
-            result = bfr_length < text_length ? -1 : 1;
+            storage.reallocate(new_length);
+        }
+        else
+        {
+            throw RangeException();
         }
     }
-    return result;
+
+    invalidate_hash();
+    size_t read_idx = 0;
+    size_t write_idx = 0;
+    for_each_match(
+        src_buffer, src_length, pattern, pat_length, compiled_pattern, MatchMode::NON_OVERLAPPING,
+        [&](const size_t index)
+        {
+            const size_t keep_length = index - read_idx;
+            std::memcpy(&(storage.buffer[write_idx]), &(src_buffer[read_idx]), keep_length);
+            write_idx += keep_length;
+            std::memcpy(&(storage.buffer[write_idx]), replacement, repl_length);
+            write_idx += repl_length;
+            read_idx = index + pat_length;
+        }
+    );
+    copy_buffer(src_buffer, read_idx, src_length, storage.buffer, write_idx);
+    storage.bfr_length = new_length;
+    return replace_count;
 }
 
-bool CharBuffer::starts_with(const CharBuffer& other) const noexcept
+// @throws RangeException
+inline void CharBuffer::overwrite_impl(
+    const size_t dst_start,
+    const char* const src_buffer,
+    const size_t src_length,
+    const size_t src_start,
+    const size_t src_end
+)
 {
-    bool result = false;
-    if (bfr_length >= other.bfr_length)
+    invalidate_hash();
+    if (
+        dst_start > storage.bfr_capacity ||
+        dst_start > storage.bfr_length ||
+        src_start > src_end ||
+        src_end > src_length
+    )
     {
-        result = compare_buffer(buffer, other.buffer, other.bfr_length) == 0;
+        throw RangeException();
+    }
+
+    const size_t copy_length = src_end - src_start;
+    const char* src_data = src_buffer;
+    storage.make_room(dst_start, copy_length, src_data);
+
+    // Source and destination may overlap if the source is this buffer
+    std::memmove(&(storage.buffer[dst_start]), &(src_data[src_start]), copy_length);
+    size_t new_length = dst_start + copy_length;
+    if (new_length > storage.bfr_length)
+    {
+        storage.buffer[new_length] = '\0';
+        storage.bfr_length = new_length;
     }
-    return result;
+}
+
+void CharBuffer::fill(const char fill_char) noexcept
+{
+    invalidate_hash();
+    storage.fill(fill_char);
+}
+
+void CharBuffer::to_lower() noexcept
+{
+    invalidate_hash();
+    CharKernels::to_lower(storage.buffer, storage.bfr_length);
+}
+
+void CharBuffer::to_upper() noexcept
+{
+    invalidate_hash();
+    CharKernels::to_upper(storage.buffer, storage.bfr_length);
+}
+
+void CharBuffer::fill(const char fill_char, const size_t target_length)
+{
+    invalidate_hash();
+    storage.fill(fill_char, target_length);
+}
+
+int CharBuffer::compare_to(const CharBuffer& other) const noexcept
+{
+    return storage.compare_to(other.storage);
+}
+
+// @throws RangeException
+int CharBuffer::compare_to(const char* const text) const noexcept
+{
+    return storage.compare_to(text);
+}
+
+int CharBuffer::compare_to_raw(const char* const data, const size_t length) const noexcept
+{
+    return storage.compare_to_raw(data, length);
+}
+
+bool CharBuffer::starts_with(const CharBuffer& other) const noexcept
+{
+    return storage.starts_with(other.storage);
 }
 
 // @throws RangeException
 bool CharBuffer::starts_with(const char* const text) const noexcept
 {
-    bool result = false;
-    const size_t text_length = safe_c_str_length(text);
-    if (bfr_length >= text_length)
-    {
-        result = compare_buffer(buffer, text, text_length) == 0;
-    }
-    return result;
+    return storage.starts_with(text);
+}
+
+bool CharBuffer::starts_with_raw(const char* const data, const size_t length) const noexcept
+{
+    return storage.starts_with_raw(data, length);
 }
 
 bool CharBuffer::ends_with(const CharBuffer& other) const noexcept
 {
-    bool result = false;
-    if (bfr_length >= other.bfr_length)
-    {
-        const size_t cmp_length = bfr_length - other.bfr_length;
-        result = compare_buffer(
-            &(buffer[bfr_length - cmp_length]),
-            other.buffer,
-            cmp_length
-        ) == 0;
-    }
-    return result;
+    return storage.ends_with(other.storage);
 }
 
 // @throws RangeException
 bool CharBuffer::ends_with(const char* const text) const noexcept
 {
-    bool result = false;
-    const size_t text_length = safe_c_str_length(text);
-    if (bfr_length >= text_length)
-    {
-        size_t cmp_length = bfr_length - text_length;
-        result = compare_buffer(
-            &(buffer[bfr_length - cmp_length]),
-            text,
-            cmp_length
-        ) == 0;
-    }
-    return result;
+    return storage.ends_with(text);
+}
+
+bool CharBuffer::ends_with_raw(const char* const data, const size_t length) const noexcept
+{
+    return storage.ends_with_raw(data, length);
 }
 
 size_t CharBuffer::index_of(const char letter) const noexcept
 {
-    size_t index = 0;
-    while (index < bfr_length && buffer[index] != letter)
+    return storage.index_of(letter);
+}
+
+// @throws RangeException
+size_t CharBuffer::index_of(const char letter, const size_t start) const
+{
+    return storage.index_of(letter, start);
+}
+
+size_t CharBuffer::index_of(const CharBuffer& other) const noexcept
+{
+    return storage.index_of(other.storage);
+}
+
+// @throws RangeException
+size_t CharBuffer::index_of(const char* const text) const noexcept
+{
+    return storage.index_of(text);
+}
+
+// @throws RangeException
+size_t CharBuffer::index_of(const CharBuffer& other, const size_t start) const
+{
+    return storage.index_of(other.storage, start);
+}
+
+// @throws RangeException
+size_t CharBuffer::index_of(const char* const text, const size_t start) const
+{
+    return storage.index_of(text, start);
+}
+
+size_t CharBuffer::index_of_raw(const char* const data, const size_t length) const noexcept
+{
+    return index_of_impl(storage.buffer, storage.bfr_length, data, length, 0);
+}
+
+// @throws RangeException
+size_t CharBuffer::index_of_raw(const char* const data, const size_t length, const size_t start) const
+{
+    size_t index = NPOS;
+    if (start <= storage.bfr_length)
+    {
+        index = index_of_impl(storage.buffer, storage.bfr_length, data, length, start);
+    }
+    else
     {
-        ++index;
+        throw RangeException();
     }
 
-    return index < bfr_length ? index : NPOS;
+    return index;
+}
+
+size_t CharBuffer::index_of(const CharPattern& pattern) const noexcept
+{
+    return storage.index_of(pattern);
 }
 
 // @throws RangeException
-size_t CharBuffer::index_of(const char letter, const size_t start) const
+size_t CharBuffer::index_of(const CharPattern& pattern, const size_t start) const
+{
+    return storage.index_of(pattern, start);
+}
+
+size_t CharBuffer::last_index_of(const char letter) const noexcept
+{
+    const size_t index = CharKernels::find_last_char(storage.buffer, 0, storage.bfr_length, letter);
+
+    return index < storage.bfr_length ? index : NPOS;
+}
+
+// @throws RangeException
+size_t CharBuffer::last_index_of(const char letter, const size_t end) const
 {
     size_t index = NPOS;
-    if (start <= bfr_length)
+    if (end <= storage.bfr_length)
     {
-        index = start;
-        while (index < bfr_length && buffer[index] != letter)
-        {
-            ++index;
-        }
+        index = CharKernels::find_last_char(storage.buffer, 0, end, letter);
     }
     else
     {
         throw RangeException();
     }
 
-    return index < bfr_length ? index : NPOS;
+    return index < end ? index : NPOS;
 }
 
-size_t CharBuffer::index_of(const CharBuffer& other) const noexcept
+size_t CharBuffer::last_index_of(const CharBuffer& other) const noexcept
+{
+    return CharPattern::rfind(storage.buffer, storage.bfr_length, other.storage.buffer, other.storage.bfr_length);
+}
+
+// @throws RangeException
+size_t CharBuffer::last_index_of(const char* const text) const
+{
+    const size_t text_length = CharKernels::bounded_c_str_length(text, MAX_CAPACITY);
+    return CharPattern::rfind(storage.buffer, storage.bfr_length, text, text_length);
+}
+
+// @throws RangeException
+size_t CharBuffer::last_index_of(const CharBuffer& other, const size_t end) const
 {
     size_t index = NPOS;
-    if (bfr_length >= other.bfr_length)
+    if (end <= storage.bfr_length)
     {
-        const size_t end_offset = bfr_length - other.bfr_length;
-        index = index_of_impl(
-            buffer, bfr_length,
-            other.buffer, other.bfr_length,
-            0, end_offset
-        );
+        index = CharPattern::rfind(storage.buffer, end, other.storage.buffer, other.storage.bfr_length);
+    }
+    else
+    {
+        throw RangeException();
     }
 
     return index;
 }
 
 // @throws RangeException
-size_t CharBuffer::index_of(const char* const text) const noexcept
+size_t CharBuffer::last_index_of(const char* const text, const size_t end) const
 {
     size_t index = NPOS;
-    const size_t text_length = safe_c_str_length(text);
-    if (bfr_length >= text_length)
+    const size_t text_length = CharKernels::bounded_c_str_length(text, MAX_CAPACITY);
+    if (end <= storage.bfr_length)
     {
-        size_t end_offset = bfr_length - text_length;
-        index = index_of_impl(buffer, bfr_length, text, text_length, 0, end_offset);
+        index = CharPattern::rfind(storage.buffer, end, text, text_length);
+    }
+    else
+    {
+        throw RangeException();
     }
 
     return index;
 }
 
+size_t CharBuffer::last_index_of_raw(const char* const data, const size_t length) const noexcept
+{
+    return CharPattern::rfind(storage.buffer, storage.bfr_length, data, length);
+}
+
 // @throws RangeException
-size_t CharBuffer::index_of(const CharBuffer& other, const size_t start) const
+size_t CharBuffer::last_index_of_raw(const char* const data, const size_t length, const size_t end) const
 {
     size_t index = NPOS;
-    if (start <= bfr_length)
+    if (end <= storage.bfr_length)
     {
-        const size_t remain = bfr_length - start;
-        if (remain >= other.bfr_length)
-        {
-            const size_t end_offset = bfr_length - other.bfr_length;
-            if (start <= end_offset)
-            {
-                index = index_of_impl(buffer, bfr_length, other.buffer, other.bfr_length, start, end_offset);
-            }
-        }
+        index = CharPattern::rfind(storage.buffer, end, data, length);
     }
     else
     {
@@ -797,22 +996,18 @@ size_t CharBuffer::index_of(const CharBuffer& other, const size_t start) const
     return index;
 }
 
+size_t CharBuffer::last_index_of(const CharPattern& pattern) const noexcept
+{
+    return pattern.rfind_in(storage.buffer, storage.bfr_length);
+}
+
 // @throws RangeException
-size_t CharBuffer::index_of(const char* const text, const size_t start) const
+size_t CharBuffer::last_index_of(const CharPattern& pattern, const size_t end) const
 {
     size_t index = NPOS;
-    const size_t text_length = safe_c_str_length(text);
-    if (start <= bfr_length)
+    if (end <= storage.bfr_length)
     {
-        const size_t remain = bfr_length - start;
-        if (remain >= text_length)
-        {
-            size_t end_offset = bfr_length - text_length;
-            if (start <= end_offset)
-            {
-                index = index_of_impl(buffer, bfr_length, text, text_length, start, end_offset);
-            }
-        }
+        index = pattern.rfind_in(storage.buffer, end);
     }
     else
     {
@@ -822,42 +1017,407 @@ size_t CharBuffer::index_of(const char* const text, const size_t start) const
     return index;
 }
 
-const char* CharBuffer::c_str() const
+int CharBuffer::compare_to_icase(const CharBuffer& other) const noexcept
+{
+    return compare_icase_impl(storage.buffer, storage.bfr_length, other.storage.buffer, other.storage.bfr_length);
+}
+
+// @throws RangeException
+int CharBuffer::compare_to_icase(const char* const text) const
+{
+    const size_t text_length = CharKernels::bounded_c_str_length(text, MAX_CAPACITY);
+    return compare_icase_impl(storage.buffer, storage.bfr_length, text, text_length);
+}
+
+int CharBuffer::compare_to_icase_raw(const char* const data, const size_t length) const noexcept
 {
-    return buffer;
+    return compare_icase_impl(storage.buffer, storage.bfr_length, data, length);
+}
+
+bool CharBuffer::equals_icase(const CharBuffer& other) const noexcept
+{
+    return equals_icase_impl(storage.buffer, storage.bfr_length, other.storage.buffer, other.storage.bfr_length);
 }
 
 // @throws RangeException
-inline static char* char_at(const size_t idx, char* const buffer, size_t length)
+bool CharBuffer::equals_icase(const char* const text) const
+{
+    const size_t text_length = CharKernels::bounded_c_str_length(text, MAX_CAPACITY);
+    return equals_icase_impl(storage.buffer, storage.bfr_length, text, text_length);
+}
+
+bool CharBuffer::equals_icase_raw(const char* const data, const size_t length) const noexcept
+{
+    return equals_icase_impl(storage.buffer, storage.bfr_length, data, length);
+}
+
+bool CharBuffer::starts_with_icase(const CharBuffer& other) const noexcept
 {
-    char* out_char {nullptr};
-    if (idx < length)
+    return starts_with_icase_impl(storage.buffer, storage.bfr_length, other.storage.buffer, other.storage.bfr_length);
+}
+
+// @throws RangeException
+bool CharBuffer::starts_with_icase(const char* const text) const
+{
+    const size_t text_length = CharKernels::bounded_c_str_length(text, MAX_CAPACITY);
+    return starts_with_icase_impl(storage.buffer, storage.bfr_length, text, text_length);
+}
+
+bool CharBuffer::starts_with_icase_raw(const char* const data, const size_t length) const noexcept
+{
+    return starts_with_icase_impl(storage.buffer, storage.bfr_length, data, length);
+}
+
+size_t CharBuffer::index_of_icase(const CharBuffer& other) const noexcept
+{
+    return index_of_icase_impl(storage.buffer, storage.bfr_length, other.storage.buffer, other.storage.bfr_length, 0);
+}
+
+// @throws RangeException
+size_t CharBuffer::index_of_icase(const char* const text) const
+{
+    const size_t text_length = CharKernels::bounded_c_str_length(text, MAX_CAPACITY);
+    return index_of_icase_impl(storage.buffer, storage.bfr_length, text, text_length, 0);
+}
+
+// @throws RangeException
+size_t CharBuffer::index_of_icase(const CharBuffer& other, const size_t start) const
+{
+    size_t index = NPOS;
+    if (start <= storage.bfr_length)
     {
-        out_char = &(buffer[idx]);
+        index = index_of_icase_impl(
+            storage.buffer, storage.bfr_length, other.storage.buffer, other.storage.bfr_length, start
+        );
     }
     else
     {
         throw RangeException();
     }
-    return out_char;
+
+    return index;
 }
 
 // @throws RangeException
-inline static size_t safe_c_str_length(const char* const buffer)
+size_t CharBuffer::index_of_icase(const char* const text, const size_t start) const
 {
-    size_t idx = 0;
-    while (buffer[idx] != '\0')
+    size_t index = NPOS;
+    const size_t text_length = CharKernels::bounded_c_str_length(text, MAX_CAPACITY);
+    if (start <= storage.bfr_length)
+    {
+        index = index_of_icase_impl(storage.buffer, storage.bfr_length, text, text_length, start);
+    }
+    else
     {
-        if (idx < CharBuffer::MAX_CAPACITY)
+        throw RangeException();
+    }
+
+    return index;
+}
+
+size_t CharBuffer::index_of_icase_raw(const char* const data, const size_t length) const noexcept
+{
+    return index_of_icase_impl(storage.buffer, storage.bfr_length, data, length, 0);
+}
+
+// @throws RangeException
+size_t CharBuffer::index_of_icase_raw(const char* const data, const size_t length, const size_t start) const
+{
+    size_t index = NPOS;
+    if (start <= storage.bfr_length)
+    {
+        index = index_of_icase_impl(storage.buffer, storage.bfr_length, data, length, start);
+    }
+    else
+    {
+        throw RangeException();
+    }
+
+    return index;
+}
+
+size_t CharBuffer::count_of(const char letter) const noexcept
+{
+    return CharKernels::count_char(storage.buffer, 0, storage.bfr_length, letter);
+}
+
+size_t CharBuffer::count_of(const CharBuffer& other, const MatchMode mode) const noexcept
+{
+    size_t count = 0;
+    for_each_match(
+        storage.buffer, storage.bfr_length, other.storage.buffer, other.storage.bfr_length, nullptr, mode,
+        [&count](size_t)
         {
-            ++idx;
+            ++count;
         }
-        else
+    );
+    return count;
+}
+
+size_t CharBuffer::count_of(const CharPattern& pattern, const MatchMode mode) const noexcept
+{
+    size_t count = 0;
+    for_each_match(
+        storage.buffer, storage.bfr_length, pattern.c_str(), pattern.length(), &pattern, mode,
+        [&count](size_t)
+        {
+            ++count;
+        }
+    );
+    return count;
+}
+
+// @throws std::bad_alloc
+void CharBuffer::find_all(const CharPattern& pattern, const MatchMode mode, std::vector<size_t>& matches) const
+{
+    for_each_match(
+        storage.buffer, storage.bfr_length, pattern.c_str(), pattern.length(), &pattern, mode,
+        [&matches](const size_t index)
+        {
+            matches.push_back(index);
+        }
+    );
+}
+
+void CharBuffer::find_all(
+    const CharPattern& pattern,
+    const MatchMode mode,
+    const std::function<void(size_t index)>& consumer
+) const
+{
+    for_each_match(storage.buffer, storage.bfr_length, pattern.c_str(), pattern.length(), &pattern, mode, consumer);
+}
+
+// @throws std::bad_alloc, RangeException
+size_t CharBuffer::replace_all(const CharPattern& pattern, const CharBuffer& replacement)
+{
+    size_t replace_count = 0;
+    if (&replacement != this)
+    {
+        replace_count = replace_impl(
+            pattern.c_str(), pattern.length(), &pattern,
+            replacement.storage.buffer, replacement.storage.bfr_length
+        );
+    }
+    else
+    {
+        // The replacement would be modified while it is being copied
+        const CharBuffer replacement_copy(replacement);
+        replace_count = replace_impl(
+            pattern.c_str(), pattern.length(), &pattern,
+            replacement_copy.storage.buffer, replacement_copy.storage.bfr_length
+        );
+    }
+    return replace_count;
+}
+
+// @throws std::bad_alloc, RangeException
+size_t CharBuffer::replace_all(const char* const pattern, const char* const replacement)
+{
+    const size_t pat_length = CharKernels::bounded_c_str_length(pattern, MAX_CAPACITY);
+    const size_t repl_length = CharKernels::bounded_c_str_length(replacement, MAX_CAPACITY);
+    return replace_impl(pattern, pat_length, nullptr, replacement, repl_length);
+}
+
+// @throws std::bad_alloc, RangeException
+size_t CharBuffer::replace_all_from(
+    const CharBuffer& source,
+    const CharPattern& pattern,
+    const CharBuffer& replacement
+)
+{
+    size_t replace_count = 0;
+    if (&source == this)
+    {
+        replace_count = replace_all(pattern, replacement);
+    }
+    else if (&replacement != this)
+    {
+        replace_count = replace_from_impl(
+            source, pattern.c_str(), pattern.length(), &pattern,
+            replacement.storage.buffer, replacement.storage.bfr_length
+        );
+    }
+    else
+    {
+        // The replacement would be overwritten by the result
+        const CharBuffer replacement_copy(replacement);
+        replace_count = replace_from_impl(
+            source, pattern.c_str(), pattern.length(), &pattern,
+            replacement_copy.storage.buffer, replacement_copy.storage.bfr_length
+        );
+    }
+    return replace_count;
+}
+
+// @throws std::bad_alloc, RangeException
+size_t CharBuffer::replace_all_from(
+    const CharBuffer& source,
+    const char* const pattern,
+    const char* const replacement
+)
+{
+    size_t replace_count = 0;
+    if (&source == this)
+    {
+        replace_count = replace_all(pattern, replacement);
+    }
+    else
+    {
+        const size_t pat_length = CharKernels::bounded_c_str_length(pattern, MAX_CAPACITY);
+        const size_t repl_length = CharKernels::bounded_c_str_length(replacement, MAX_CAPACITY);
+        replace_count = replace_from_impl(source, pattern, pat_length, nullptr, replacement, repl_length);
+    }
+    return replace_count;
+}
+
+// @throws std::bad_alloc, IoException, RangeException
+size_t CharBuffer::read_from(const int fd, const size_t max_length)
+{
+    invalidate_hash();
+    size_t read_length = max_length;
+    if (read_length > 0 && storage.bfr_length == storage.bfr_capacity && storage.is_growable() &&
+        storage.bfr_capacity < Storage::MAX_CAPACITY)
+    {
+        // max_length only bounds the read, a full buffer grows by one step of its growth policy
+        const size_t step_capacity = RuntimeGrowth::next_capacity(
+            storage.bfr_capacity,
+            storage.bfr_length + 1,
+            Storage::MAX_CAPACITY
+        );
+        const size_t step_length = step_capacity - storage.bfr_length;
+        storage.reserve(storage.bfr_length + (read_length < step_length ? read_length : step_length));
+    }
+    if (read_length > storage.bfr_capacity - storage.bfr_length)
+    {
+        read_length = storage.bfr_capacity - storage.bfr_length;
+        if (read_length == 0)
         {
             throw RangeException();
         }
     }
-    return idx;
+
+    ssize_t result = 0;
+    do
+    {
+        result = read(fd, &(storage.buffer[storage.bfr_length]), read_length);
+    }
+    while (result == -1 && errno == EINTR);
+    if (result == -1)
+    {
+        storage.buffer[storage.bfr_length] = '\0';
+        throw IoException(errno);
+    }
+
+    storage.bfr_length += static_cast<size_t> (result);
+    storage.buffer[storage.bfr_length] = '\0';
+    return static_cast<size_t> (result);
+}
+
+// @throws IoException
+void CharBuffer::write_to(const int fd) const
+{
+    write_fully(fd, storage.buffer, storage.bfr_length);
+}
+
+// @throws IoException, RangeException
+void CharBuffer::write_to(const int fd, const size_t start, const size_t end) const
+{
+    if (start > end || end > storage.bfr_length)
+    {
+        throw RangeException();
+    }
+    write_fully(fd, &(storage.buffer[start]), end - start);
+}
+
+// @throws IoException
+void CharBuffer::write_all_to(const int fd, const std::vector<const CharBuffer*>& buffers)
+{
+    const size_t batch_capacity = IOV_MAX < 256 ? IOV_MAX : 256;
+    struct iovec vectors[batch_capacity];
+
+    size_t next_buffer = 0;
+    size_t batch_length = 0;
+    size_t batch_start = 0;
+    while (next_buffer < buffers.size() || batch_start < batch_length)
+    {
+        // Refills the batch with the remaining buffers, skipping empty ones
+        if (batch_start == batch_length)
+        {
+            batch_start = 0;
+            batch_length = 0;
+            while (next_buffer < buffers.size() && batch_length < batch_capacity)
+            {
+                const CharBuffer& fragment = *(buffers[next_buffer]);
+                if (fragment.storage.bfr_length > 0)
+                {
+                    vectors[batch_length].iov_base = fragment.storage.buffer;
+                    vectors[batch_length].iov_len = fragment.storage.bfr_length;
+                    ++batch_length;
+                }
+                ++next_buffer;
+            }
+        }
+
+        if (batch_start < batch_length)
+        {
+            const ssize_t result = writev(fd, &(vectors[batch_start]), static_cast<int> (batch_length - batch_start));
+            if (result == -1)
+            {
+                if (errno != EINTR)
+                {
+                    throw IoException(errno);
+                }
+            }
+            else
+            {
+                // Skips the vectors that were written completely and adjusts a partially written one
+                size_t written = static_cast<size_t> (result);
+                while (batch_start < batch_length && written >= vectors[batch_start].iov_len)
+                {
+                    written -= vectors[batch_start].iov_len;
+                    ++batch_start;
+                }
+                if (written > 0)
+                {
+                    vectors[batch_start].iov_base = static_cast<char*> (vectors[batch_start].iov_base) + written;
+                    vectors[batch_start].iov_len -= written;
+                }
+            }
+        }
+    }
+}
+
+bool CharBuffer::parse_int(const size_t start, const size_t end, long long& value) const noexcept
+{
+    return start <= end && end <= storage.bfr_length &&
+        CharNumbers::parse_int(&(storage.buffer[start]), end - start, value);
+}
+
+bool CharBuffer::parse_double(const size_t start, const size_t end, double& value) const noexcept
+{
+    return start <= end && end <= storage.bfr_length &&
+        CharNumbers::parse_double(&(storage.buffer[start]), end - start, value);
+}
+
+CharBufferView CharBuffer::view() const noexcept
+{
+    return CharBufferView(storage.buffer, storage.bfr_length);
+}
+
+// @throws RangeException
+CharBufferView CharBuffer::view(const size_t start, const size_t end) const
+{
+    if (start > end || end > storage.bfr_length)
+    {
+        throw RangeException();
+    }
+    return CharBufferView(&(storage.buffer[start]), end - start);
+}
+
+const char* CharBuffer::c_str() const
+{
+    return storage.c_str();
 }
 
 inline static void copy_buffer(
@@ -868,102 +1428,184 @@ inline static void copy_buffer(
     const size_t dst_offset
 )
 {
-    size_t dst_idx = dst_offset;
-    size_t src_idx = src_start;
-    while (src_idx < src_end)
+    // Source and destination may overlap, e.g. for substring()
+    const size_t copy_length = src_end - src_start;
+    std::memmove(&(dst_buffer[dst_offset]), &(src_buffer[src_start]), copy_length);
+    dst_buffer[dst_offset + copy_length] = '\0';
+}
+
+template<typename Consumer>
+inline static void for_each_match(
+    const char* const data,
+    const size_t length,
+    const char* const pattern,
+    const size_t pat_length,
+    const CharPattern* const compiled_pattern,
+    const CharBuffer::MatchMode mode,
+    Consumer&& consumer
+)
+{
+    // Long patterns are searched for using tables that CharPattern::find would rebuild on each call,
+    // so they are compiled once for all of the searches
+    // If there is not enough memory for that, each search prepares the pattern again
+    std::unique_ptr<CharPattern> precompiled;
+    if (compiled_pattern == nullptr && pat_length > CharPattern::SHORT_PATTERN_LENGTH)
     {
-        dst_buffer[dst_idx] = src_buffer[src_idx];
-        ++dst_idx;
-        ++src_idx;
+        try
+        {
+            precompiled.reset(new CharPattern(pattern, pat_length));
+        }
+        catch (std::bad_alloc&)
+        {
+        }
+    }
+    const CharPattern* const search_pattern = compiled_pattern != nullptr ? compiled_pattern : precompiled.get();
+
+    // Empty matches advance by one position in either mode
+    const size_t step = mode == CharBuffer::MatchMode::NON_OVERLAPPING && pat_length > 0 ? pat_length : 1;
+    size_t start = 0;
+    while (start <= length)
+    {
+        const size_t index = search_pattern != nullptr ?
+            search_pattern->find_in(data, length, start) :
+            CharPattern::find(data, length, pattern, pat_length, start);
+        if (index != CharBuffer::NPOS)
+        {
+            consumer(index);
+            start = index + step;
+        }
+        else
+        {
+            start = CharBuffer::NPOS;
+        }
     }
-    dst_buffer[dst_idx] = '\0';
 }
 
-inline static int compare_buffer(
-    const char* const buffer,
-    const char* const other_buffer,
-    const size_t compare_length
-)
+// @throws IoException
+inline static void write_fully(const int fd, const char* const data, const size_t length)
 {
-    int result = 0;
-    for (size_t idx = 0; idx < compare_length; ++idx)
+    size_t offset = 0;
+    while (offset < length)
     {
-        if (buffer[idx] != other_buffer[idx])
+        const ssize_t result = write(fd, &(data[offset]), length - offset);
+        if (result == -1)
         {
-            if (buffer[idx] < other_buffer[idx])
+            if (errno != EINTR)
             {
-                result = -1;
+                throw IoException(errno);
             }
-            else
-            {
-                result = 1;
-            }
-            break;
+        }
+        else
+        {
+            offset += static_cast<size_t> (result);
         }
     }
-    return result;
 }
 
-inline static bool match_buffer(
+inline static size_t index_of_impl(
     const char* const buffer,
+    const size_t length,
+    const char* const pattern,
+    const size_t pat_length,
+    const size_t start_offset
+)
+{
+    return CharPattern::find(buffer, length, pattern, pat_length, start_offset);
+}
+
+inline static int compare_icase_impl(
+    const char* const buffer,
+    const size_t length,
     const char* const other_buffer,
-    const size_t match_length
+    const size_t other_length
 )
 {
-    size_t idx = 0;
-    while (idx < match_length && buffer[idx] == other_buffer[idx])
+    const size_t cmp_length = length <= other_length ? length : other_length;
+    int result = 0;
+    const size_t idx = CharKernels::find_mismatch_icase(buffer, other_buffer, cmp_length);
+    if (idx < cmp_length)
     {
-        ++idx;
+        result = ascii_lower(buffer[idx]) < ascii_lower(other_buffer[idx]) ? -1 : 1;
     }
-    return idx == match_length;
+    else if (length != other_length)
+    {
+        result = length < other_length ? -1 : 1;
+    }
+    return result;
 }
 
-inline static size_t index_of_impl(
+inline static bool equals_icase_impl(
+    const char* const buffer,
+    const size_t length,
+    const char* const other_buffer,
+    const size_t other_length
+)
+{
+    return length == other_length && CharKernels::find_mismatch_icase(buffer, other_buffer, length) == length;
+}
+
+inline static bool starts_with_icase_impl(
+    const char* const buffer,
+    const size_t length,
+    const char* const other_buffer,
+    const size_t other_length
+)
+{
+    return length >= other_length &&
+        CharKernels::find_mismatch_icase(buffer, other_buffer, other_length) == other_length;
+}
+
+inline static size_t index_of_icase_impl(
     const char* const buffer,
     const size_t length,
     const char* const pattern,
     const size_t pat_length,
-    const size_t start_offset,
-    const size_t end_offset
+    const size_t start_offset
 )
 {
     size_t index = CharBuffer::NPOS;
-
-    if (length >= pat_length)
+    if (pat_length == 0)
     {
-        // Cannot access the first byte of a zero-length string.
-        // The empty string always matches at the position where the
-        // search started
-        if (pat_length > 0)
-        {
-            for (size_t src_idx = start_offset; src_idx <= end_offset; ++src_idx)
-            {
-                // compare first character of both strings
-                if (buffer[src_idx] == pattern[0])
-                {
-                    // first character matches, compare strings
-                    size_t cmp_idx = src_idx + 1;
-                    size_t pat_idx = 1;
-
-                    while (pat_idx < pat_length &&
-                           buffer[cmp_idx] == pattern[pat_idx])
-                    {
-                        ++cmp_idx;
-                        ++pat_idx;
-                    }
-                    if (pat_idx == pat_length)
-                    {
-                        index = src_idx;
-                        break;
-                    }
-                }
-            }
-        }
-        else
+        // The empty string always matches at the position where the search started
+        index = start_offset;
+    }
+    else
+    {
+        const size_t match_idx = CharKernels::find_substring_icase(buffer, start_offset, length, pattern, pat_length);
+        if (match_idx < length)
         {
-            index = 0;
+            index = match_idx;
         }
     }
-
     return index;
 }
+
+inline static char ascii_lower(const char letter) noexcept
+{
+    return letter >= 'A' && letter <= 'Z' ? static_cast<char> (letter - 'A' + 'a') : letter;
+}
+
+// Returns the length of a text of the specified length after replacing match_count matches
+// @throws RangeException
+inline static size_t replaced_length(
+    const size_t length,
+    const size_t pat_length,
+    const size_t repl_length,
+    const size_t match_count
+)
+{
+    size_t new_length = length;
+    if (repl_length <= pat_length)
+    {
+        new_length -= match_count * (pat_length - repl_length);
+    }
+    else if (match_count == 0 || repl_length - pat_length <= (CharBuffer::MAX_CAPACITY - length) / match_count)
+    {
+        new_length += match_count * (repl_length - pat_length);
+    }
+    else
+    {
+        throw RangeException();
+    }
+    return new_length;
+}
@@ -2,18 +2,44 @@
 #define CHARBUFFER_H
 
 #include <new>
+#include <atomic>
 #include <memory>
+#include <functional>
+#include <vector>
+
+#include <CharBufferView.h>
+#include <CharAllocator.h>
+#include <BasicCharBuffer.h>
+
+class CharPattern;
 
 class CharBuffer
 {
   public:
     static const size_t MAX_CAPACITY;
     static const size_t NPOS;
+    static const size_t INLINE_CAPACITY = 31;
+
+    // Selects whether matches found by count_of() and find_all() may overlap
+    // In NON_OVERLAPPING mode, the search for the next match continues after the end of the previous one.
+    enum class MatchMode
+    {
+        OVERLAPPING,
+        NON_OVERLAPPING
+    };
 
     // @throws std::bad_alloc
     explicit CharBuffer(size_t capacity);
     explicit CharBuffer(const char* text);
     explicit CharBuffer(size_t capacity, const char* text);
+
+    // Constructors for buffers that obtain their storage from the specified allocator
+    // Storage for capacities up to INLINE_CAPACITY is always inline.
+    // @throws std::bad_alloc
+    explicit CharBuffer(size_t capacity, CharAllocator& allocator);
+    explicit CharBuffer(const char* text, CharAllocator& allocator);
+    explicit CharBuffer(size_t capacity, const char* text, CharAllocator& allocator);
+
     virtual ~CharBuffer() noexcept;
     explicit CharBuffer(const CharBuffer& orig);
     explicit CharBuffer(CharBuffer&& orig);
@@ -26,6 +52,9 @@ class CharBuffer
     virtual bool operator==(const CharBuffer& other) const noexcept;
     virtual bool operator==(const char* text) const noexcept;
 
+    // Length-aware variant of operator==, data does not need to be null-terminated
+    virtual bool equals_raw(const char* data, size_t length) const noexcept;
+
     virtual bool operator<(const CharBuffer& other) const noexcept;
     virtual bool operator>(const CharBuffer& other) const noexcept;
     virtual bool operator<=(const CharBuffer& other) const noexcept;
@@ -57,6 +86,32 @@ class CharBuffer
     virtual void wipe() noexcept;
     virtual void truncate(size_t new_length) noexcept;
 
+    // A growable buffer increases its capacity geometrically when an operation exceeds it,
+    // instead of throwing RangeException
+    virtual void set_growable(bool growable) noexcept;
+    virtual bool is_growable() const noexcept;
+
+    // A buffer with hash caching enabled stores the value computed by hash() until the content is modified
+    // References obtained from the non-const operator[] must not be used to modify the content after a
+    // subsequent call of hash(). Concurrent calls of hash() on the same buffer are safe, like all other
+    // concurrent const operations.
+    virtual void set_hash_caching(bool hash_caching) noexcept;
+    virtual bool is_hash_caching() const noexcept;
+
+    // Returns true if the storage is obtained from a CharAllocator rather than from the heap
+    virtual bool has_custom_allocator() const noexcept;
+
+    // Returns a 64 bit non-cryptographic hash of the content, see CharBufferHash
+    virtual size_t hash() const noexcept;
+
+    // Increases the capacity to at least min_capacity
+    // @throws std::bad_alloc
+    virtual void reserve(size_t min_capacity);
+
+    // Reduces the capacity to the current length
+    // @throws std::bad_alloc
+    virtual void shrink_to_fit();
+
     // @throws RangeException
     virtual void copy_raw(const char* data, size_t length);
 
@@ -81,6 +136,38 @@ class CharBuffer
     // @throws RangeException
     virtual void append_raw(const char* data, size_t start, size_t end);
 
+    // Appends each argument, which may be any mix of CharBuffer, CharBufferView, C string and char
+    // The total length is computed and the capacity is checked once, before any data is copied,
+    // so the buffer is left unchanged if the arguments do not fit.
+    // @throws std::bad_alloc, RangeException
+    template<typename... Args>
+    void append_all(const Args&... args);
+
+    // Appends the content of count views, with the same semantics as append_all()
+    // @throws std::bad_alloc, RangeException
+    virtual void append_views(const CharBufferView* pieces, size_t count);
+
+    // Returns a buffer that contains the concatenation of the arguments, see append_all(),
+    // with a capacity of exactly the length of the concatenation
+    // @throws std::bad_alloc, RangeException
+    template<typename... Args>
+    static std::unique_ptr<CharBuffer> concat(const Args&... args);
+
+    // Appends the decimal representation of value
+    // @throws std::bad_alloc, RangeException
+    virtual void append_int(long long value);
+
+    // @throws std::bad_alloc, RangeException
+    virtual void append_uint(unsigned long long value);
+
+    // Appends the lowercase hexadecimal representation of value, without a prefix
+    // @throws std::bad_alloc, RangeException
+    virtual void append_hex(unsigned long long value);
+
+    // Appends a short representation of value that parses to the same value, see CharNumbers
+    // @throws std::bad_alloc, RangeException
+    virtual void append_double(double value);
+
     // @throws RangeException
     virtual void overwrite_with(size_t dst_start, const CharBuffer& other);
 
@@ -93,24 +180,38 @@ class CharBuffer
     // @throws RangeException
     virtual void overwrite_with(size_t dst_start, const char* text, size_t src_start, size_t src_end);
 
+    // @throws RangeException
+    virtual void overwrite_with_raw(size_t dst_start, const char* data, size_t length);
+
     virtual void fill(const char fill_char) noexcept;
     virtual void fill(const char fill_char, size_t target_length);
 
+    // Converts the ASCII letters of the content to lowercase or to uppercase in place,
+    // characters outside of the ASCII range are not changed
+    virtual void to_lower() noexcept;
+    virtual void to_upper() noexcept;
+
     virtual int compare_to(const CharBuffer& other) const noexcept;
 
     // @throws RangeException
     virtual int compare_to(const char* text) const noexcept;
 
+    virtual int compare_to_raw(const char* data, size_t length) const noexcept;
+
     virtual bool starts_with(const CharBuffer& other) const noexcept;
 
     // @throws RangeException
     virtual bool starts_with(const char* text) const noexcept;
 
+    virtual bool starts_with_raw(const char* data, size_t length) const noexcept;
+
     virtual bool ends_with(const CharBuffer& other) const noexcept;
 
     // @throws RangeException
     virtual bool ends_with(const char* text) const noexcept;
 
+    virtual bool ends_with_raw(const char* data, size_t length) const noexcept;
+
     virtual size_t index_of(char letter) const noexcept;
 
     // @throws RangeException
@@ -127,13 +228,206 @@ class CharBuffer
     // @throws RangeException
     virtual size_t index_of(const char* text, size_t start) const;
 
+    virtual size_t index_of_raw(const char* data, size_t length) const noexcept;
+
+    // @throws RangeException
+    virtual size_t index_of_raw(const char* data, size_t length, size_t start) const;
+
+    virtual size_t index_of(const CharPattern& pattern) const noexcept;
+
+    // @throws RangeException
+    virtual size_t index_of(const CharPattern& pattern, size_t start) const;
+
+    // The last_index_of() functions search backwards from the end of the content, or from end,
+    // and return the index of the last occurrence that lies entirely within [0, end), or NPOS
+    virtual size_t last_index_of(char letter) const noexcept;
+
+    // @throws RangeException
+    virtual size_t last_index_of(char letter, size_t end) const;
+
+    virtual size_t last_index_of(const CharBuffer& other) const noexcept;
+
+    // @throws RangeException
+    virtual size_t last_index_of(const char* text) const;
+
+    // @throws RangeException
+    virtual size_t last_index_of(const CharBuffer& other, size_t end) const;
+
+    // @throws RangeException
+    virtual size_t last_index_of(const char* text, size_t end) const;
+
+    virtual size_t last_index_of_raw(const char* data, size_t length) const noexcept;
+
+    // @throws RangeException
+    virtual size_t last_index_of_raw(const char* data, size_t length, size_t end) const;
+
+    virtual size_t last_index_of(const CharPattern& pattern) const noexcept;
+
+    // @throws RangeException
+    virtual size_t last_index_of(const CharPattern& pattern, size_t end) const;
+
+    // The _icase functions compare ASCII letters without regard to case, as if both sides had been
+    // converted to lowercase, without creating lowercase copies
+    virtual int compare_to_icase(const CharBuffer& other) const noexcept;
+
+    // @throws RangeException
+    virtual int compare_to_icase(const char* text) const;
+
+    virtual int compare_to_icase_raw(const char* data, size_t length) const noexcept;
+
+    virtual bool equals_icase(const CharBuffer& other) const noexcept;
+
+    // @throws RangeException
+    virtual bool equals_icase(const char* text) const;
+
+    virtual bool equals_icase_raw(const char* data, size_t length) const noexcept;
+
+    virtual bool starts_with_icase(const CharBuffer& other) const noexcept;
+
+    // @throws RangeException
+    virtual bool starts_with_icase(const char* text) const;
+
+    virtual bool starts_with_icase_raw(const char* data, size_t length) const noexcept;
+
+    virtual size_t index_of_icase(const CharBuffer& other) const noexcept;
+
+    // @throws RangeException
+    virtual size_t index_of_icase(const char* text) const;
+
+    // @throws RangeException
+    virtual size_t index_of_icase(const CharBuffer& other, size_t start) const;
+
+    // @throws RangeException
+    virtual size_t index_of_icase(const char* text, size_t start) const;
+
+    virtual size_t index_of_icase_raw(const char* data, size_t length) const noexcept;
+
+    // @throws RangeException
+    virtual size_t index_of_icase_raw(const char* data, size_t length, size_t start) const;
+
+    // Reads up to max_length characters from the file descriptor fd directly into the unused
+    // capacity of the buffer, and returns the number of characters read, which is 0 at the end of file
+    // At most as many characters are read as fit into the remaining capacity. If there is none,
+    // a growable buffer first grows by one step of its growth policy, but by no more than max_length,
+    // so that max_length does not determine the allocation. A non-growable buffer throws
+    // RangeException instead, unless max_length is 0.
+    // The read is retried if it is interrupted by a signal.
+    // @throws std::bad_alloc, IoException, RangeException
+    virtual size_t read_from(int fd, size_t max_length);
+
+    // Writes the entire content to the file descriptor fd, retrying interrupted and partial writes
+    // @throws IoException
+    virtual void write_to(int fd) const;
+
+    // Writes the range [start, end) of the content to the file descriptor fd
+    // @throws IoException, RangeException
+    virtual void write_to(int fd, size_t start, size_t end) const;
+
+    // Writes the content of all buffers to the file descriptor fd with gathering writes,
+    // without copying the buffers together first
+    // Up to IOV_MAX buffers, but no more than 256, are written by a single system call.
+    // @throws IoException
+    static void write_all_to(int fd, const std::vector<const CharBuffer*>& buffers);
+
+    // Parses the range [start, end) as a number, independent of the locale
+    // Returns false and leaves value unchanged if the range is invalid, if it does not contain
+    // a number, or if the number is out of range.
+    virtual bool parse_int(size_t start, size_t end, long long& value) const noexcept;
+    virtual bool parse_double(size_t start, size_t end, double& value) const noexcept;
+
+    virtual size_t count_of(char letter) const noexcept;
+    virtual size_t count_of(const CharBuffer& other, MatchMode mode) const noexcept;
+    virtual size_t count_of(const CharPattern& pattern, MatchMode mode) const noexcept;
+
+    // Appends the indexes of all matches of pattern, in ascending order
+    // An empty pattern matches at every index from 0 to length().
+    // @throws std::bad_alloc
+    virtual void find_all(const CharPattern& pattern, MatchMode mode, std::vector<size_t>& matches) const;
+
+    // Calls the consumer with the index of each match of pattern, in ascending order
+    virtual void find_all(
+        const CharPattern& pattern,
+        MatchMode mode,
+        const std::function<void(size_t index)>& consumer
+    ) const;
+
+    // Replaces all non-overlapping matches of pattern, from left to right, by replacement in place,
+    // and returns the number of replacements
+    // Matches are located with the same search engine as index_of(). A replacement that is not
+    // longer than the pattern is done in a single pass without allocating; a longer one locates all
+    // matches first and then moves the content backwards from the end, after growing the buffer
+    // once if required. The content is unchanged if an exception is thrown, e.g. if the pattern is
+    // empty, or if the result does not fit into a non-growable buffer.
+    // @throws std::bad_alloc, RangeException
+    virtual size_t replace_all(const CharPattern& pattern, const CharBuffer& replacement);
+
+    // The pattern and the replacement must not point into the content of this buffer
+    // @throws std::bad_alloc, RangeException
+    virtual size_t replace_all(const char* pattern, const char* replacement);
+
+    // Sets the content to the content of source with all non-overlapping matches of pattern
+    // replaced by replacement, and returns the number of replacements
+    // The matches are counted first, so that a buffer that has to grow is allocated with exactly
+    // the capacity of the result, before the result is copied in a second pass.
+    // @throws std::bad_alloc, RangeException
+    virtual size_t replace_all_from(const CharBuffer& source, const CharPattern& pattern, const CharBuffer& replacement);
+
+    // The pattern and the replacement must not point into the content of this buffer
+    // @throws std::bad_alloc, RangeException
+    virtual size_t replace_all_from(const CharBuffer& source, const char* pattern, const char* replacement);
+
+    // Returns a view of the content, which is invalidated by any modification of this buffer
+    virtual CharBufferView view() const noexcept;
+
+    // Returns a view of the range [start, end) of the content
+    // @throws RangeException
+    virtual CharBufferView view(size_t start, size_t end) const;
+
     virtual const char* c_str() const;
 
   private:
-    size_t bfr_capacity;
-    size_t bfr_length;
-    std::unique_ptr<char[]> buffer_mgr;
-    char* buffer;
+    // The content, its storage and the growth flag are managed by the non-polymorphic buffer
+    typedef BasicCharBuffer<CheckedBounds, RuntimeGrowth, CharAllocatorAdapter, INLINE_CAPACITY> Storage;
+
+    Storage storage;
+    bool bfr_hash_caching;
+    // The cached value is stored before the valid flag is set with release semantics, so that a
+    // concurrent hash() call that sees the flag also sees the value
+    mutable std::atomic<bool> bfr_hash_valid;
+    mutable std::atomic<size_t> bfr_hash;
+
+    inline void invalidate_hash() noexcept;
+
+    static CharBufferView piece_of(const CharBuffer& text) noexcept;
+    static CharBufferView piece_of(const CharBufferView& text) noexcept;
+
+    // @throws RangeException
+    static CharBufferView piece_of(const char* text);
+
+    static CharBufferView piece_of(const char& letter) noexcept;
+
+    // @throws RangeException
+    static size_t views_length(const CharBufferView* pieces, size_t count);
+
+    // compiled_pattern is used for the search if it is not nullptr
+    // @throws std::bad_alloc, RangeException
+    inline size_t replace_impl(
+        const char* pattern,
+        size_t pat_length,
+        const CharPattern* compiled_pattern,
+        const char* replacement,
+        size_t repl_length
+    );
+
+    // @throws std::bad_alloc, RangeException
+    inline size_t replace_from_impl(
+        const CharBuffer& source,
+        const char* pattern,
+        size_t pat_length,
+        const CharPattern* compiled_pattern,
+        const char* replacement,
+        size_t repl_length
+    );
 
     // @throws RangeException
     inline void overwrite_impl(
@@ -145,4 +439,57 @@ class CharBuffer
     );
 };
 
+// @throws std::bad_alloc, RangeException
+template<typename... Args>
+void CharBuffer::append_all(const Args&... args)
+{
+    // One additional element, so that the array is not empty if there are no arguments
+    const CharBufferView pieces[sizeof...(Args) + 1] = {piece_of(args)...};
+    append_views(pieces, sizeof...(Args));
+}
+
+// @throws std::bad_alloc, RangeException
+template<typename... Args>
+std::unique_ptr<CharBuffer> CharBuffer::concat(const Args&... args)
+{
+    const CharBufferView pieces[sizeof...(Args) + 1] = {piece_of(args)...};
+    std::unique_ptr<CharBuffer> result(new CharBuffer(views_length(pieces, sizeof...(Args))));
+    result->append_views(pieces, sizeof...(Args));
+    return result;
+}
+
+inline CharBufferView CharBuffer::piece_of(const CharBuffer& text) noexcept
+{
+    return CharBufferView(text);
+}
+
+inline CharBufferView CharBuffer::piece_of(const CharBufferView& text) noexcept
+{
+    return text;
+}
+
+// @throws RangeException
+inline CharBufferView CharBuffer::piece_of(const char* const text)
+{
+    return CharBufferView(text);
+}
+
+// The view refers to the argument, which exists until the end of the append_all() or concat() call
+inline CharBufferView CharBuffer::piece_of(const char& letter) noexcept
+{
+    return CharBufferView(&letter, 1);
+}
+
+namespace std
+{
+    template<>
+    struct hash<CharBuffer>
+    {
+        size_t operator()(const CharBuffer& buffer) const noexcept
+        {
+            return buffer.hash();
+        }
+    };
+}
+
 #endif /* CHARBUFFER_H */
@@ -0,0 +1,94 @@
+#include <CharBufferArena.h>
+
+const size_t CharBufferArena::DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+// @throws std::bad_alloc
+CharBufferArena::CharBufferArena():
+    CharBufferArena(DEFAULT_BLOCK_SIZE)
+{
+}
+
+// @throws std::bad_alloc
+CharBufferArena::CharBufferArena(const size_t arena_block_size):
+    block_size(arena_block_size > 0 ? arena_block_size : DEFAULT_BLOCK_SIZE),
+    used_total(0),
+    reserved_total(0),
+    free_ptr(nullptr),
+    free_size(0)
+{
+}
+
+CharBufferArena::~CharBufferArena() noexcept
+{
+}
+
+// @throws std::bad_alloc
+char* CharBufferArena::allocate(const size_t size)
+{
+    char* storage = nullptr;
+    if (size <= free_size)
+    {
+        storage = free_ptr;
+        free_ptr += size;
+        free_size -= size;
+    }
+    else if (size > block_size / 4)
+    {
+        // Large requests get a block of their own, so that the free space of the current block is not wasted
+        std::unique_ptr<char[]> block(new char[size]);
+        storage = block.get();
+        extra_blocks.push_back(std::move(block));
+        reserved_total += size;
+    }
+    else
+    {
+        std::unique_ptr<char[]> block(new char[block_size]);
+        storage = block.get();
+        if (base_block == nullptr)
+        {
+            base_block = std::move(block);
+        }
+        else
+        {
+            extra_blocks.push_back(std::move(block));
+        }
+        reserved_total += block_size;
+        free_ptr = storage + size;
+        free_size = block_size - size;
+    }
+    used_total += size;
+    return storage;
+}
+
+void CharBufferArena::deallocate(char* const storage, const size_t size) noexcept
+{
+    // no-op, storage is released by reset()
+}
+
+void CharBufferArena::reset() noexcept
+{
+    extra_blocks.clear();
+    used_total = 0;
+    if (base_block != nullptr)
+    {
+        free_ptr = base_block.get();
+        free_size = block_size;
+        reserved_total = block_size;
+    }
+    else
+    {
+        free_ptr = nullptr;
+        free_size = 0;
+        reserved_total = 0;
+    }
+}
+
+size_t CharBufferArena::used_bytes() const noexcept
+{
+    return used_total;
+}
+
+size_t CharBufferArena::reserved_bytes() const noexcept
+{
+    return reserved_total;
+}
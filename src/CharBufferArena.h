@@ -0,0 +1,53 @@
+#ifndef CHARBUFFERARENA_H
+#define CHARBUFFERARENA_H
+
+#include <new>
+#include <memory>
+#include <vector>
+
+#include <CharAllocator.h>
+
+// Bump-pointer allocator for short-lived CharBuffer instances
+// Storage is carved sequentially from large blocks. Deallocating storage has no effect,
+// all storage is released at once by reset() or by destroying the arena.
+// All CharBuffer instances that use the arena must be destroyed before the arena is reset.
+// Not thread-safe.
+class CharBufferArena : public CharAllocator
+{
+  public:
+    static const size_t DEFAULT_BLOCK_SIZE;
+
+    // @throws std::bad_alloc
+    CharBufferArena();
+
+    // @throws std::bad_alloc
+    explicit CharBufferArena(size_t block_size);
+
+    virtual ~CharBufferArena() noexcept;
+
+    // @throws std::bad_alloc
+    virtual char* allocate(size_t size) override;
+
+    virtual void deallocate(char* storage, size_t size) noexcept override;
+
+    // Releases all storage, except for one regular block, which is kept for reuse
+    virtual void reset() noexcept;
+
+    // Number of bytes handed out since construction or since the last reset
+    virtual size_t used_bytes() const noexcept;
+
+    // Number of bytes held in blocks
+    virtual size_t reserved_bytes() const noexcept;
+
+  private:
+    size_t block_size;
+    size_t used_total;
+    size_t reserved_total;
+    // Regular block that is kept across resets
+    std::unique_ptr<char[]> base_block;
+    std::vector<std::unique_ptr<char[]>> extra_blocks;
+    char* free_ptr;
+    size_t free_size;
+};
+
+#endif /* CHARBUFFERARENA_H */
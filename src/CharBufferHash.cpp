@@ -0,0 +1,175 @@
+#include <CharBufferHash.h>
+
+#include <cstring>
+
+#include <CharBuffer.h>
+#include <CharBufferView.h>
+
+static const uint64_t SECRET_0 = 0xA0761D6478BD642FULL;
+static const uint64_t SECRET_1 = 0xE7037ED1A0B428DBULL;
+static const uint64_t SECRET_2 = 0x8EBC6AF09C88C6E3ULL;
+static const uint64_t SECRET_3 = 0x589965CC75374CC3ULL;
+
+inline static void multiply(uint64_t& factor_lo, uint64_t& factor_hi);
+inline static uint64_t mix(uint64_t value, uint64_t other_value);
+inline static uint64_t read_64(const unsigned char* data);
+inline static uint64_t read_32(const unsigned char* data);
+
+uint64_t CharBufferHash::hash(const char* const data, const size_t length) noexcept
+{
+    const unsigned char* input = reinterpret_cast<const unsigned char*> (data);
+    uint64_t seed = mix(SECRET_0, SECRET_1);
+    uint64_t value = 0;
+    uint64_t other_value = 0;
+    if (length <= 16)
+    {
+        if (length >= 4)
+        {
+            // Two possibly overlapping 4 byte reads from each end cover all lengths from 4 to 16
+            const size_t offset = (length >> 3) << 2;
+            value = (read_32(input) << 32) | read_32(&(input[offset]));
+            other_value = (read_32(&(input[length - 4])) << 32) | read_32(&(input[length - 4 - offset]));
+        }
+        else if (length > 0)
+        {
+            value = (static_cast<uint64_t> (input[0]) << 16) |
+                (static_cast<uint64_t> (input[length >> 1]) << 8) |
+                static_cast<uint64_t> (input[length - 1]);
+        }
+    }
+    else
+    {
+        size_t remain = length;
+        if (remain > 48)
+        {
+            // Three independent lanes per 48 byte block
+            uint64_t seed_1 = seed;
+            uint64_t seed_2 = seed;
+            do
+            {
+                seed = mix(read_64(input) ^ SECRET_1, read_64(&(input[8])) ^ seed);
+                seed_1 = mix(read_64(&(input[16])) ^ SECRET_2, read_64(&(input[24])) ^ seed_1);
+                seed_2 = mix(read_64(&(input[32])) ^ SECRET_3, read_64(&(input[40])) ^ seed_2);
+                input += 48;
+                remain -= 48;
+            }
+            while (remain > 48);
+            seed ^= seed_1 ^ seed_2;
+        }
+        while (remain > 16)
+        {
+            seed = mix(read_64(input) ^ SECRET_1, read_64(&(input[8])) ^ seed);
+            input += 16;
+            remain -= 16;
+        }
+        // The last 16 bytes, which may overlap bytes that were already mixed
+        value = read_64(&(input[remain - 16]));
+        other_value = read_64(&(input[remain - 8]));
+    }
+    value ^= SECRET_1;
+    other_value ^= seed;
+    multiply(value, other_value);
+    return mix(value ^ SECRET_0 ^ static_cast<uint64_t> (length), other_value ^ SECRET_1);
+}
+
+size_t CharBufferHash::operator()(const CharBuffer& buffer) const noexcept
+{
+    return buffer.hash();
+}
+
+size_t CharBufferHash::operator()(const CharBufferView& view) const noexcept
+{
+    return static_cast<size_t> (hash(view.data(), view.length()));
+}
+
+// @throws RangeException
+size_t CharBufferHash::operator()(const char* const text) const
+{
+    const CharBufferView view(text);
+    return static_cast<size_t> (hash(view.data(), view.length()));
+}
+
+bool CharBufferEqual::operator()(const CharBuffer& buffer, const CharBuffer& other) const noexcept
+{
+    return buffer == other;
+}
+
+bool CharBufferEqual::operator()(const CharBuffer& buffer, const CharBufferView& view) const noexcept
+{
+    return view == buffer;
+}
+
+bool CharBufferEqual::operator()(const CharBufferView& view, const CharBuffer& buffer) const noexcept
+{
+    return view == buffer;
+}
+
+bool CharBufferEqual::operator()(const CharBufferView& view, const CharBufferView& other) const noexcept
+{
+    return view == other;
+}
+
+// @throws RangeException
+bool CharBufferEqual::operator()(const CharBuffer& buffer, const char* const text) const
+{
+    return CharBufferView(text) == buffer;
+}
+
+// @throws RangeException
+bool CharBufferEqual::operator()(const char* const text, const CharBuffer& buffer) const
+{
+    return CharBufferView(text) == buffer;
+}
+
+// @throws RangeException
+bool CharBufferEqual::operator()(const CharBufferView& view, const char* const text) const
+{
+    return view == text;
+}
+
+// @throws RangeException
+bool CharBufferEqual::operator()(const char* const text, const CharBufferView& view) const
+{
+    return view == text;
+}
+
+// Replaces the factors by the low and the high half of their 128 bit product
+inline static void multiply(uint64_t& factor_lo, uint64_t& factor_hi)
+{
+    #ifdef __SIZEOF_INT128__
+    const unsigned __int128 product = static_cast<unsigned __int128> (factor_lo) * factor_hi;
+    factor_lo = static_cast<uint64_t> (product);
+    factor_hi = static_cast<uint64_t> (product >> 64);
+    #else
+    const uint64_t lo_lo = (factor_lo & 0xFFFFFFFFULL) * (factor_hi & 0xFFFFFFFFULL);
+    const uint64_t hi_lo = (factor_lo >> 32) * (factor_hi & 0xFFFFFFFFULL);
+    const uint64_t lo_hi = (factor_lo & 0xFFFFFFFFULL) * (factor_hi >> 32);
+    const uint64_t hi_hi = (factor_lo >> 32) * (factor_hi >> 32);
+    const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFULL) + lo_hi;
+    factor_lo = (cross << 32) | (lo_lo & 0xFFFFFFFFULL);
+    factor_hi = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    #endif
+}
+
+inline static uint64_t mix(const uint64_t value, const uint64_t other_value)
+{
+    uint64_t product_lo = value;
+    uint64_t product_hi = other_value;
+    multiply(product_lo, product_hi);
+    return product_lo ^ product_hi;
+}
+
+// Unaligned native byte order reads, hash values are therefore specific to the byte order of the platform
+inline static uint64_t read_64(const unsigned char* const data)
+{
+    uint64_t value;
+    std::memcpy(&value, data, sizeof (value));
+    return value;
+}
+
+inline static uint64_t read_32(const unsigned char* const data)
+{
+    uint32_t value;
+    std::memcpy(&value, data, sizeof (value));
+    return value;
+}
@@ -0,0 +1,53 @@
+#ifndef CHARBUFFERHASH_H
+#define CHARBUFFERHASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+class CharBuffer;
+class CharBufferView;
+
+// Hash function object for unordered containers keyed by character data
+// The hash is a 64 bit non-cryptographic hash in the style of wyhash. A CharBuffer, a CharBufferView
+// and a C string with the same content have the same hash value, and the hash function object is
+// transparent, so that containers that support heterogeneous lookup can be searched for views or
+// C strings without constructing a CharBuffer.
+class CharBufferHash
+{
+  public:
+    typedef void is_transparent;
+
+    static uint64_t hash(const char* data, size_t length) noexcept;
+
+    size_t operator()(const CharBuffer& buffer) const noexcept;
+    size_t operator()(const CharBufferView& view) const noexcept;
+
+    // @throws RangeException
+    size_t operator()(const char* text) const;
+};
+
+// Transparent equality function object that complements CharBufferHash
+class CharBufferEqual
+{
+  public:
+    typedef void is_transparent;
+
+    bool operator()(const CharBuffer& buffer, const CharBuffer& other) const noexcept;
+    bool operator()(const CharBuffer& buffer, const CharBufferView& view) const noexcept;
+    bool operator()(const CharBufferView& view, const CharBuffer& buffer) const noexcept;
+    bool operator()(const CharBufferView& view, const CharBufferView& other) const noexcept;
+
+    // @throws RangeException
+    bool operator()(const CharBuffer& buffer, const char* text) const;
+
+    // @throws RangeException
+    bool operator()(const char* text, const CharBuffer& buffer) const;
+
+    // @throws RangeException
+    bool operator()(const CharBufferView& view, const char* text) const;
+
+    // @throws RangeException
+    bool operator()(const char* text, const CharBufferView& view) const;
+};
+
+#endif /* CHARBUFFERHASH_H */
@@ -0,0 +1,184 @@
+#include <CharBufferInternTable.h>
+
+#include <mutex>
+
+#include <CharBufferHash.h>
+#include <CharBufferView.h>
+
+// The number of shards must be a power of two
+static const size_t SHARD_COUNT = 64;
+static const size_t SHARD_SHIFT = 58;
+
+static const size_t INITIAL_SLOT_COUNT = 16;
+
+// Block size of the per-shard arenas
+static const size_t ARENA_BLOCK_SIZE = 4 * 1024;
+
+// @throws std::bad_alloc
+CharBufferInternTable::Shard::Shard():
+    arena(ARENA_BLOCK_SIZE),
+    slots(INITIAL_SLOT_COUNT, Slot {0, nullptr})
+{
+}
+
+// @throws std::bad_alloc
+CharBufferInternTable::CharBufferInternTable():
+    entry_total(0),
+    content_total(0)
+{
+    shards.reserve(SHARD_COUNT);
+    for (size_t idx = 0; idx < SHARD_COUNT; ++idx)
+    {
+        shards.push_back(std::unique_ptr<Shard>(new Shard));
+    }
+}
+
+CharBufferInternTable::~CharBufferInternTable() noexcept
+{
+}
+
+// @throws std::bad_alloc
+const CharBuffer* CharBufferInternTable::intern(const char* const data, const size_t length)
+{
+    const uint64_t hash = CharBufferHash::hash(data, length);
+    Shard& shard = *(shards[static_cast<size_t> (hash >> SHARD_SHIFT) & (SHARD_COUNT - 1)]);
+
+    const CharBuffer* entry = nullptr;
+    {
+        std::shared_lock<std::shared_timed_mutex> guard(shard.shard_lock);
+        entry = find_in_shard(shard, hash, data, length);
+    }
+    if (entry == nullptr)
+    {
+        std::lock_guard<std::shared_timed_mutex> guard(shard.shard_lock);
+        // Another thread may have added the entry after the shared lock was released
+        entry = find_in_shard(shard, hash, data, length);
+        if (entry == nullptr)
+        {
+            // Keep the load factor at or below 3/4
+            if ((shard.entries.size() + 1) * 4 > shard.slots.size() * 3)
+            {
+                grow_slots(shard);
+            }
+            shard.entries.reserve(shard.entries.size() + 1);
+
+            std::unique_ptr<CharBuffer> new_entry(new CharBuffer(length, shard.arena));
+            new_entry->copy_raw(data, length);
+            new_entry->set_hash_caching(true);
+            new_entry->hash();
+            entry = new_entry.get();
+            shard.entries.push_back(std::move(new_entry));
+
+            const size_t mask = shard.slots.size() - 1;
+            size_t slot_idx = static_cast<size_t> (hash) & mask;
+            while (shard.slots[slot_idx].entry != nullptr)
+            {
+                slot_idx = (slot_idx + 1) & mask;
+            }
+            shard.slots[slot_idx] = Slot {hash, entry};
+
+            entry_total.fetch_add(1, std::memory_order_relaxed);
+            content_total.fetch_add(length, std::memory_order_relaxed);
+        }
+    }
+    return entry;
+}
+
+// @throws std::bad_alloc
+const CharBuffer* CharBufferInternTable::intern(const CharBuffer& text)
+{
+    return intern(text.c_str(), text.length());
+}
+
+// @throws std::bad_alloc
+const CharBuffer* CharBufferInternTable::intern(const CharBufferView& text)
+{
+    return intern(text.data(), text.length());
+}
+
+// @throws std::bad_alloc, RangeException
+const CharBuffer* CharBufferInternTable::intern(const char* const text)
+{
+    const CharBufferView text_view(text);
+    return intern(text_view.data(), text_view.length());
+}
+
+const CharBuffer* CharBufferInternTable::find(const char* const data, const size_t length) const noexcept
+{
+    const uint64_t hash = CharBufferHash::hash(data, length);
+    const Shard& shard = *(shards[static_cast<size_t> (hash >> SHARD_SHIFT) & (SHARD_COUNT - 1)]);
+    std::shared_lock<std::shared_timed_mutex> guard(shard.shard_lock);
+    return find_in_shard(shard, hash, data, length);
+}
+
+const CharBuffer* CharBufferInternTable::find(const CharBufferView& text) const noexcept
+{
+    return find(text.data(), text.length());
+}
+
+size_t CharBufferInternTable::entry_count() const noexcept
+{
+    return entry_total.load(std::memory_order_relaxed);
+}
+
+size_t CharBufferInternTable::content_bytes() const noexcept
+{
+    return content_total.load(std::memory_order_relaxed);
+}
+
+size_t CharBufferInternTable::memory_bytes() const noexcept
+{
+    size_t total = sizeof (CharBufferInternTable) + shards.capacity() * sizeof (std::unique_ptr<Shard>);
+    for (const std::unique_ptr<Shard>& shard : shards)
+    {
+        std::shared_lock<std::shared_timed_mutex> guard(shard->shard_lock);
+        total += sizeof (Shard);
+        total += shard->slots.capacity() * sizeof (Slot);
+        total += shard->entries.capacity() * sizeof (std::unique_ptr<CharBuffer>);
+        total += shard->entries.size() * sizeof (CharBuffer);
+        total += shard->arena.reserved_bytes();
+    }
+    return total;
+}
+
+inline const CharBuffer* CharBufferInternTable::find_in_shard(
+    const Shard& shard,
+    const uint64_t hash,
+    const char* const data,
+    const size_t length
+) noexcept
+{
+    const CharBuffer* entry = nullptr;
+    const size_t mask = shard.slots.size() - 1;
+    size_t slot_idx = static_cast<size_t> (hash) & mask;
+    while (entry == nullptr && shard.slots[slot_idx].entry != nullptr)
+    {
+        const Slot& slot = shard.slots[slot_idx];
+        if (slot.hash == hash && slot.entry->equals_raw(data, length))
+        {
+            entry = slot.entry;
+        }
+        slot_idx = (slot_idx + 1) & mask;
+    }
+    return entry;
+}
+
+// @throws std::bad_alloc
+inline void CharBufferInternTable::grow_slots(Shard& shard)
+{
+    std::vector<Slot> new_slots(shard.slots.size() * 2, Slot {0, nullptr});
+    const size_t mask = new_slots.size() - 1;
+    for (const Slot& slot : shard.slots)
+    {
+        if (slot.entry != nullptr)
+        {
+            size_t slot_idx = static_cast<size_t> (slot.hash) & mask;
+            while (new_slots[slot_idx].entry != nullptr)
+            {
+                slot_idx = (slot_idx + 1) & mask;
+            }
+            new_slots[slot_idx] = slot;
+        }
+    }
+    shard.slots.swap(new_slots);
+}
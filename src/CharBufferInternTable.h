@@ -0,0 +1,95 @@
+#ifndef CHARBUFFERINTERNTABLE_H
+#define CHARBUFFERINTERNTABLE_H
+
+#include <new>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <shared_mutex>
+
+#include <CharBuffer.h>
+#include <CharBufferArena.h>
+
+// Thread-safe table of unique, immutable CharBuffer instances
+// intern() returns the same canonical buffer for all calls with equal content, so that interned
+// strings can be compared by comparing the pointers. Canonical buffers remain valid until the
+// table is destroyed, and have hash caching enabled.
+// Entries are distributed across shards by their hash value. Each shard is protected by a
+// readers-writer lock, so that lookups of existing entries only take shared locks.
+class CharBufferInternTable
+{
+  public:
+    // @throws std::bad_alloc
+    CharBufferInternTable();
+    virtual ~CharBufferInternTable() noexcept;
+
+    CharBufferInternTable(const CharBufferInternTable& orig) = delete;
+    CharBufferInternTable& operator=(const CharBufferInternTable& orig) = delete;
+    CharBufferInternTable(CharBufferInternTable&& orig) = delete;
+    CharBufferInternTable& operator=(CharBufferInternTable&& orig) = delete;
+
+    // Returns the canonical buffer for the content, adding it to the table if necessary
+    // @throws std::bad_alloc
+    virtual const CharBuffer* intern(const char* data, size_t length);
+
+    // @throws std::bad_alloc
+    virtual const CharBuffer* intern(const CharBuffer& text);
+
+    // @throws std::bad_alloc
+    virtual const CharBuffer* intern(const CharBufferView& text);
+
+    // @throws std::bad_alloc, RangeException
+    virtual const CharBuffer* intern(const char* text);
+
+    // Returns the canonical buffer for the content, or nullptr if the content has not been interned
+    virtual const CharBuffer* find(const char* data, size_t length) const noexcept;
+    virtual const CharBuffer* find(const CharBufferView& text) const noexcept;
+
+    // Number of distinct entries
+    virtual size_t entry_count() const noexcept;
+
+    // Sum of the lengths of all entries
+    virtual size_t content_bytes() const noexcept;
+
+    // Total memory used by the table, including the entries, their storage and the hash tables
+    virtual size_t memory_bytes() const noexcept;
+
+  private:
+    struct Slot
+    {
+        uint64_t hash;
+        const CharBuffer* entry;
+    };
+
+    struct Shard
+    {
+        // @throws std::bad_alloc
+        Shard();
+
+        mutable std::shared_timed_mutex shard_lock;
+        // Storage of entries that do not fit into a CharBuffer's inline storage
+        // Declared before the entries, so that it is destroyed after them
+        CharBufferArena arena;
+        std::vector<std::unique_ptr<CharBuffer>> entries;
+        // Open addressing with linear probing, the number of slots is a power of two
+        std::vector<Slot> slots;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    std::atomic<size_t> entry_total;
+    std::atomic<size_t> content_total;
+
+    inline static const CharBuffer* find_in_shard(
+        const Shard& shard,
+        uint64_t hash,
+        const char* data,
+        size_t length
+    ) noexcept;
+
+    // @throws std::bad_alloc
+    inline static void grow_slots(Shard& shard);
+};
+
+#endif /* CHARBUFFERINTERNTABLE_H */
@@ -0,0 +1,258 @@
+#include <CharBufferMapping.h>
+
+#include <cerrno>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <CharBuffer.h>
+#include <IoException.h>
+#include <RangeException.h>
+
+inline static int advice_of(CharBufferMapping::Access access) noexcept;
+
+// @throws IoException
+CharBufferMapping::CharBufferMapping(const char* const path):
+    map_address(nullptr),
+    map_length(0)
+{
+    int fd = -1;
+    do
+    {
+        fd = open(path, O_RDONLY | O_CLOEXEC);
+    }
+    while (fd == -1 && errno == EINTR);
+    if (fd == -1)
+    {
+        throw IoException(errno);
+    }
+
+    // The mapping remains valid after the file descriptor is closed
+    int error_number = 0;
+    struct stat file_info;
+    if (fstat(fd, &file_info) != 0)
+    {
+        error_number = errno;
+    }
+    else if (!S_ISREG(file_info.st_mode))
+    {
+        error_number = ENODEV;
+    }
+    else if (static_cast<uintmax_t> (file_info.st_size) > static_cast<uintmax_t> (CharBuffer::MAX_CAPACITY))
+    {
+        error_number = EFBIG;
+    }
+    else if (file_info.st_size > 0)
+    {
+        const size_t file_length = static_cast<size_t> (file_info.st_size);
+        void* const address = mmap(nullptr, file_length, PROT_READ, MAP_SHARED, fd, 0);
+        if (address != MAP_FAILED)
+        {
+            map_address = address;
+            map_length = file_length;
+        }
+        else
+        {
+            error_number = errno;
+        }
+    }
+    close(fd);
+
+    if (error_number != 0)
+    {
+        throw IoException(error_number);
+    }
+}
+
+CharBufferMapping::~CharBufferMapping() noexcept
+{
+    unmap();
+}
+
+CharBufferMapping::CharBufferMapping(CharBufferMapping&& orig) noexcept:
+    map_address(orig.map_address),
+    map_length(orig.map_length)
+{
+    orig.map_address = nullptr;
+    orig.map_length = 0;
+}
+
+CharBufferMapping& CharBufferMapping::operator=(CharBufferMapping&& orig) noexcept
+{
+    if (this != &orig)
+    {
+        unmap();
+        map_address = orig.map_address;
+        map_length = orig.map_length;
+        orig.map_address = nullptr;
+        orig.map_length = 0;
+    }
+    return *this;
+}
+
+// @throws IoException
+void CharBufferMapping::advise(const Access access)
+{
+    advise(access, 0, map_length);
+}
+
+// @throws IoException, RangeException
+void CharBufferMapping::advise(const Access access, const size_t start, const size_t end)
+{
+    if (start > end || end > map_length)
+    {
+        throw RangeException();
+    }
+    if (start < end)
+    {
+        // The start address of the advised range must be aligned to a page boundary
+        const size_t page_size = static_cast<size_t> (sysconf(_SC_PAGESIZE));
+        const size_t aligned_start = start - (start % page_size);
+        char* const range_address = static_cast<char*> (map_address) + aligned_start;
+        if (madvise(range_address, end - aligned_start, advice_of(access)) != 0)
+        {
+            throw IoException(errno);
+        }
+    }
+}
+
+// @throws RangeException
+const char& CharBufferMapping::operator[](const size_t index) const
+{
+    if (index >= map_length)
+    {
+        throw RangeException();
+    }
+    return data()[index];
+}
+
+bool CharBufferMapping::is_empty() const noexcept
+{
+    return map_length == 0;
+}
+
+size_t CharBufferMapping::length() const noexcept
+{
+    return map_length;
+}
+
+const char* CharBufferMapping::data() const noexcept
+{
+    return map_address != nullptr ? static_cast<const char*> (map_address) : "";
+}
+
+CharBufferView CharBufferMapping::view() const noexcept
+{
+    return CharBufferView(data(), map_length);
+}
+
+// @throws RangeException
+CharBufferView CharBufferMapping::view(const size_t start, const size_t end) const
+{
+    return view().view(start, end);
+}
+
+int CharBufferMapping::compare_to(const CharBufferView& other) const noexcept
+{
+    return view().compare_to(other);
+}
+
+int CharBufferMapping::compare_to(const CharBuffer& other) const noexcept
+{
+    return view().compare_to(other);
+}
+
+bool CharBufferMapping::starts_with(const CharBufferView& other) const noexcept
+{
+    return view().starts_with(other);
+}
+
+bool CharBufferMapping::starts_with(const CharBuffer& other) const noexcept
+{
+    return view().starts_with(other);
+}
+
+bool CharBufferMapping::ends_with(const CharBufferView& other) const noexcept
+{
+    return view().ends_with(other);
+}
+
+bool CharBufferMapping::ends_with(const CharBuffer& other) const noexcept
+{
+    return view().ends_with(other);
+}
+
+size_t CharBufferMapping::index_of(const char letter) const noexcept
+{
+    return view().index_of(letter);
+}
+
+// @throws RangeException
+size_t CharBufferMapping::index_of(const char letter, const size_t start) const
+{
+    return view().index_of(letter, start);
+}
+
+size_t CharBufferMapping::index_of(const CharBufferView& other) const noexcept
+{
+    return view().index_of(other);
+}
+
+size_t CharBufferMapping::index_of(const CharBuffer& other) const noexcept
+{
+    return view().index_of(other);
+}
+
+size_t CharBufferMapping::index_of(const CharPattern& pattern) const noexcept
+{
+    return view().index_of(pattern);
+}
+
+// @throws RangeException
+size_t CharBufferMapping::index_of(const CharBufferView& other, const size_t start) const
+{
+    return view().index_of(other, start);
+}
+
+// @throws RangeException
+size_t CharBufferMapping::index_of(const CharPattern& pattern, const size_t start) const
+{
+    return view().index_of(pattern, start);
+}
+
+inline void CharBufferMapping::unmap() noexcept
+{
+    if (map_address != nullptr)
+    {
+        munmap(map_address, map_length);
+        map_address = nullptr;
+        map_length = 0;
+    }
+}
+
+inline static int advice_of(const CharBufferMapping::Access access) noexcept
+{
+    int advice = MADV_NORMAL;
+    switch (access)
+    {
+        case CharBufferMapping::Access::SEQUENTIAL:
+            advice = MADV_SEQUENTIAL;
+            break;
+        case CharBufferMapping::Access::RANDOM:
+            advice = MADV_RANDOM;
+            break;
+        case CharBufferMapping::Access::WILL_NEED:
+            advice = MADV_WILLNEED;
+            break;
+        case CharBufferMapping::Access::DONT_NEED:
+            advice = MADV_DONTNEED;
+            break;
+        case CharBufferMapping::Access::NORMAL:
+        default:
+            break;
+    }
+    return advice;
+}
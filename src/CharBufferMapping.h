@@ -0,0 +1,95 @@
+#ifndef CHARBUFFERMAPPING_H
+#define CHARBUFFERMAPPING_H
+
+#include <cstddef>
+
+#include <CharBufferView.h>
+
+class CharBuffer;
+class CharPattern;
+
+// Read-only, memory-mapped view of the content of a file
+// The file is mapped on construction and unmapped on destruction, so that no content is copied and
+// the pages are loaded from, and shared through, the page cache on demand. The content is not
+// null-terminated. Modifying the file while it is mapped changes the content that is visible
+// through the mapping, truncating it may cause accesses to fail with SIGBUS.
+class CharBufferMapping
+{
+  public:
+    // Expected access pattern, used as a hint for the kernel's read-ahead
+    enum class Access
+    {
+        NORMAL,
+        SEQUENTIAL,
+        RANDOM,
+        // The range will be accessed soon and should be read ahead now
+        WILL_NEED,
+        // The range will not be accessed soon and its pages may be released
+        DONT_NEED
+    };
+
+    // Maps the regular file at path
+    // @throws IoException
+    explicit CharBufferMapping(const char* path);
+
+    virtual ~CharBufferMapping() noexcept;
+
+    CharBufferMapping(const CharBufferMapping& orig) = delete;
+    CharBufferMapping& operator=(const CharBufferMapping& orig) = delete;
+    CharBufferMapping(CharBufferMapping&& orig) noexcept;
+    CharBufferMapping& operator=(CharBufferMapping&& orig) noexcept;
+
+    // Advises the kernel of the access pattern for the entire content
+    // @throws IoException
+    virtual void advise(Access access);
+
+    // Advises the kernel of the access pattern for the range [start, end) of the content
+    // @throws IoException, RangeException
+    virtual void advise(Access access, size_t start, size_t end);
+
+    // @throws RangeException
+    virtual const char& operator[](size_t index) const;
+
+    virtual bool is_empty() const noexcept;
+    virtual size_t length() const noexcept;
+    virtual const char* data() const noexcept;
+
+    // Returns a view of the content, which is valid for as long as the mapping exists
+    virtual CharBufferView view() const noexcept;
+
+    // @throws RangeException
+    virtual CharBufferView view(size_t start, size_t end) const;
+
+    virtual int compare_to(const CharBufferView& other) const noexcept;
+    virtual int compare_to(const CharBuffer& other) const noexcept;
+
+    virtual bool starts_with(const CharBufferView& other) const noexcept;
+    virtual bool starts_with(const CharBuffer& other) const noexcept;
+
+    virtual bool ends_with(const CharBufferView& other) const noexcept;
+    virtual bool ends_with(const CharBuffer& other) const noexcept;
+
+    virtual size_t index_of(char letter) const noexcept;
+
+    // @throws RangeException
+    virtual size_t index_of(char letter, size_t start) const;
+
+    virtual size_t index_of(const CharBufferView& other) const noexcept;
+    virtual size_t index_of(const CharBuffer& other) const noexcept;
+    virtual size_t index_of(const CharPattern& pattern) const noexcept;
+
+    // @throws RangeException
+    virtual size_t index_of(const CharBufferView& other, size_t start) const;
+
+    // @throws RangeException
+    virtual size_t index_of(const CharPattern& pattern, size_t start) const;
+
+  private:
+    // nullptr if the file is empty
+    void* map_address;
+    size_t map_length;
+
+    inline void unmap() noexcept;
+};
+
+#endif /* CHARBUFFERMAPPING_H */
@@ -0,0 +1,261 @@
+#include <CharBufferPool.h>
+
+#include <thread>
+
+const size_t CharBufferPool::MIN_CLASS_CAPACITY = 32;
+const size_t CharBufferPool::MAX_CLASS_CAPACITY = 16 * 1024 * 1024;
+
+static const size_t MAX_SHARD_COUNT = 64;
+
+// Assigns consecutive shard keys to threads in the order of their first pool access
+static std::atomic<size_t> next_thread_key(0);
+static thread_local size_t thread_key = next_thread_key.fetch_add(1, std::memory_order_relaxed);
+
+inline static size_t acquire_class(size_t capacity);
+inline static size_t release_class(size_t capacity);
+
+CharBufferPool::Handle::Handle(CharBufferPool* const pool, std::unique_ptr<CharBuffer> buffer) noexcept:
+    owner(pool),
+    managed_buffer(std::move(buffer))
+{
+}
+
+CharBufferPool::Handle::~Handle() noexcept
+{
+    if (owner != nullptr)
+    {
+        owner->release(std::move(managed_buffer));
+    }
+}
+
+CharBufferPool::Handle::Handle(Handle&& orig) noexcept:
+    owner(orig.owner),
+    managed_buffer(std::move(orig.managed_buffer))
+{
+    orig.owner = nullptr;
+}
+
+CharBufferPool::Handle& CharBufferPool::Handle::operator=(Handle&& orig) noexcept
+{
+    if (this != &orig)
+    {
+        if (owner != nullptr)
+        {
+            owner->release(std::move(managed_buffer));
+        }
+        owner = orig.owner;
+        managed_buffer = std::move(orig.managed_buffer);
+        orig.owner = nullptr;
+    }
+    return *this;
+}
+
+CharBuffer& CharBufferPool::Handle::operator*() const noexcept
+{
+    return *managed_buffer;
+}
+
+CharBuffer* CharBufferPool::Handle::operator->() const noexcept
+{
+    return managed_buffer.get();
+}
+
+CharBuffer* CharBufferPool::Handle::get() const noexcept
+{
+    return managed_buffer.get();
+}
+
+std::unique_ptr<CharBuffer> CharBufferPool::Handle::detach() noexcept
+{
+    owner = nullptr;
+    return std::move(managed_buffer);
+}
+
+// @throws std::bad_alloc
+CharBufferPool::CharBufferPool(const size_t max_retained_bytes):
+    max_retained(max_retained_bytes),
+    class_count(release_class(MAX_CLASS_CAPACITY) + 1),
+    hits(0),
+    misses(0),
+    retained_total(0),
+    retained_count(0)
+{
+    size_t shard_count = 1;
+    const size_t thread_count = std::thread::hardware_concurrency();
+    while (shard_count < thread_count && shard_count < MAX_SHARD_COUNT)
+    {
+        shard_count <<= 1;
+    }
+    shards.reserve(shard_count);
+    for (size_t idx = 0; idx < shard_count; ++idx)
+    {
+        std::unique_ptr<Shard> shard(new Shard);
+        shard->free_lists.resize(class_count);
+        shards.push_back(std::move(shard));
+    }
+}
+
+CharBufferPool::~CharBufferPool() noexcept
+{
+}
+
+// @throws std::bad_alloc
+CharBufferPool::Handle CharBufferPool::acquire(const size_t capacity)
+{
+    return Handle(this, acquire_buffer(capacity));
+}
+
+// @throws std::bad_alloc
+std::unique_ptr<CharBuffer> CharBufferPool::acquire_buffer(const size_t capacity)
+{
+    std::unique_ptr<CharBuffer> buffer;
+    if (capacity <= MAX_CLASS_CAPACITY)
+    {
+        const size_t cls = acquire_class(capacity);
+
+        // Try the thread's own shard first, then any other shard that is not currently locked
+        Shard& own_shard = local_shard();
+        {
+            std::lock_guard<std::mutex> guard(own_shard.shard_lock);
+            std::vector<std::unique_ptr<CharBuffer>>& free_list = own_shard.free_lists[cls];
+            if (!free_list.empty())
+            {
+                buffer = std::move(free_list.back());
+                free_list.pop_back();
+            }
+        }
+        for (size_t idx = 0; buffer == nullptr && idx < shards.size(); ++idx)
+        {
+            Shard& shard = *(shards[idx]);
+            if (&shard != &own_shard && shard.shard_lock.try_lock())
+            {
+                std::lock_guard<std::mutex> guard(shard.shard_lock, std::adopt_lock);
+                std::vector<std::unique_ptr<CharBuffer>>& free_list = shard.free_lists[cls];
+                if (!free_list.empty())
+                {
+                    buffer = std::move(free_list.back());
+                    free_list.pop_back();
+                }
+            }
+        }
+
+        if (buffer != nullptr)
+        {
+            hits.fetch_add(1, std::memory_order_relaxed);
+            retained_total.fetch_sub(buffer->capacity(), std::memory_order_relaxed);
+            retained_count.fetch_sub(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            misses.fetch_add(1, std::memory_order_relaxed);
+            buffer = std::unique_ptr<CharBuffer>(new CharBuffer(MIN_CLASS_CAPACITY << cls));
+        }
+    }
+    else
+    {
+        misses.fetch_add(1, std::memory_order_relaxed);
+        buffer = std::unique_ptr<CharBuffer>(new CharBuffer(capacity));
+    }
+    return buffer;
+}
+
+void CharBufferPool::release(std::unique_ptr<CharBuffer> buffer) noexcept
+{
+    // Buffers with a custom allocator are never retained, their storage may not outlive the pool
+    if (buffer != nullptr && !buffer->has_custom_allocator())
+    {
+        const size_t capacity = buffer->capacity();
+        if (capacity >= MIN_CLASS_CAPACITY && capacity < (MAX_CLASS_CAPACITY << 1))
+        {
+            // Retained buffers are returned in the state of a newly allocated buffer
+            buffer->clear();
+            buffer->set_growable(false);
+            buffer->set_hash_caching(false);
+
+            const size_t prev_total = retained_total.fetch_add(capacity, std::memory_order_relaxed);
+            if (prev_total + capacity <= max_retained)
+            {
+                Shard& shard = local_shard();
+                try
+                {
+                    std::lock_guard<std::mutex> guard(shard.shard_lock);
+                    shard.free_lists[release_class(capacity)].push_back(std::move(buffer));
+                    retained_count.fetch_add(1, std::memory_order_relaxed);
+                }
+                catch (std::bad_alloc&)
+                {
+                    // Destroy the buffer instead of retaining it
+                    retained_total.fetch_sub(capacity, std::memory_order_relaxed);
+                }
+            }
+            else
+            {
+                retained_total.fetch_sub(capacity, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+void CharBufferPool::trim() noexcept
+{
+    for (std::unique_ptr<Shard>& shard : shards)
+    {
+        std::lock_guard<std::mutex> guard(shard->shard_lock);
+        for (std::vector<std::unique_ptr<CharBuffer>>& free_list : shard->free_lists)
+        {
+            for (std::unique_ptr<CharBuffer>& buffer : free_list)
+            {
+                retained_total.fetch_sub(buffer->capacity(), std::memory_order_relaxed);
+                retained_count.fetch_sub(1, std::memory_order_relaxed);
+            }
+            free_list.clear();
+        }
+    }
+}
+
+size_t CharBufferPool::hit_count() const noexcept
+{
+    return hits.load(std::memory_order_relaxed);
+}
+
+size_t CharBufferPool::miss_count() const noexcept
+{
+    return misses.load(std::memory_order_relaxed);
+}
+
+size_t CharBufferPool::retained_bytes() const noexcept
+{
+    return retained_total.load(std::memory_order_relaxed);
+}
+
+size_t CharBufferPool::retained_buffers() const noexcept
+{
+    return retained_count.load(std::memory_order_relaxed);
+}
+
+inline CharBufferPool::Shard& CharBufferPool::local_shard() noexcept
+{
+    return *(shards[thread_key & (shards.size() - 1)]);
+}
+
+// Returns the smallest class that fits the capacity
+inline static size_t acquire_class(const size_t capacity)
+{
+    size_t cls = 0;
+    while ((CharBufferPool::MIN_CLASS_CAPACITY << cls) < capacity)
+    {
+        ++cls;
+    }
+    return cls;
+}
+
+// Returns the largest class that the capacity fits, the capacity must be at least MIN_CLASS_CAPACITY
+inline static size_t release_class(const size_t capacity)
+{
+    size_t cls = 0;
+    while ((CharBufferPool::MIN_CLASS_CAPACITY << (cls + 1)) <= capacity)
+    {
+        ++cls;
+    }
+    return cls;
+}
@@ -0,0 +1,103 @@
+#ifndef CHARBUFFERPOOL_H
+#define CHARBUFFERPOOL_H
+
+#include <new>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+#include <CharBuffer.h>
+
+// Thread-safe pool that recycles CharBuffer instances by capacity class
+// Capacity classes are powers of two from MIN_CLASS_CAPACITY to MAX_CLASS_CAPACITY.
+// Requests for larger capacities are served, but those buffers are not retained.
+// Retained buffers are kept in shards that are each assigned to a subset of the threads,
+// so that threads normally acquire and release buffers without contending for a lock.
+// The pool must outlive all handles and buffers that were obtained from it.
+class CharBufferPool
+{
+  public:
+    static const size_t MIN_CLASS_CAPACITY;
+    static const size_t MAX_CLASS_CAPACITY;
+
+    // Owns a pooled buffer and releases it to the pool upon destruction
+    class Handle
+    {
+      public:
+        Handle(CharBufferPool* pool, std::unique_ptr<CharBuffer> buffer) noexcept;
+        ~Handle() noexcept;
+
+        Handle(const Handle& orig) = delete;
+        Handle& operator=(const Handle& orig) = delete;
+        Handle(Handle&& orig) noexcept;
+        Handle& operator=(Handle&& orig) noexcept;
+
+        CharBuffer& operator*() const noexcept;
+        CharBuffer* operator->() const noexcept;
+        CharBuffer* get() const noexcept;
+
+        // Takes the buffer out of the handle, it will not be released to the pool
+        std::unique_ptr<CharBuffer> detach() noexcept;
+
+      private:
+        CharBufferPool* owner;
+        std::unique_ptr<CharBuffer> managed_buffer;
+    };
+
+    // @throws std::bad_alloc
+    explicit CharBufferPool(size_t max_retained_bytes);
+    virtual ~CharBufferPool() noexcept;
+
+    CharBufferPool(const CharBufferPool& orig) = delete;
+    CharBufferPool& operator=(const CharBufferPool& orig) = delete;
+    CharBufferPool(CharBufferPool&& orig) = delete;
+    CharBufferPool& operator=(CharBufferPool&& orig) = delete;
+
+    // Returns an empty buffer with at least the requested capacity
+    // @throws std::bad_alloc
+    virtual Handle acquire(size_t capacity);
+
+    // Returns an empty buffer with at least the requested capacity
+    // @throws std::bad_alloc
+    virtual std::unique_ptr<CharBuffer> acquire_buffer(size_t capacity);
+
+    // Retains the buffer for reuse, or destroys it if the pool is full, if the buffer's capacity
+    // does not fit any capacity class, or if the buffer uses a custom CharAllocator
+    virtual void release(std::unique_ptr<CharBuffer> buffer) noexcept;
+
+    // Destroys all retained buffers
+    virtual void trim() noexcept;
+
+    // Number of acquire requests that were served by a retained buffer
+    virtual size_t hit_count() const noexcept;
+
+    // Number of acquire requests that required allocating a new buffer
+    virtual size_t miss_count() const noexcept;
+
+    // Sum of the capacities of all retained buffers
+    virtual size_t retained_bytes() const noexcept;
+
+    virtual size_t retained_buffers() const noexcept;
+
+  private:
+    struct Shard
+    {
+        std::mutex shard_lock;
+        // One free list per capacity class
+        std::vector<std::vector<std::unique_ptr<CharBuffer>>> free_lists;
+    };
+
+    size_t max_retained;
+    size_t class_count;
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    std::atomic<size_t> hits;
+    std::atomic<size_t> misses;
+    std::atomic<size_t> retained_total;
+    std::atomic<size_t> retained_count;
+
+    inline Shard& local_shard() noexcept;
+};
+
+#endif /* CHARBUFFERPOOL_H */
@@ -0,0 +1,241 @@
+#include <CharBufferView.h>
+
+#include <CharBuffer.h>
+#include <CharBufferHash.h>
+#include <CharKernels.h>
+#include <CharPattern.h>
+#include <RangeException.h>
+
+CharBufferView::CharBufferView() noexcept:
+    view_data(""),
+    view_length(0)
+{
+}
+
+CharBufferView::CharBufferView(const char* const data, const size_t length) noexcept:
+    view_data(data),
+    view_length(length)
+{
+}
+
+CharBufferView::CharBufferView(const CharBuffer& buffer) noexcept:
+    view_data(buffer.c_str()),
+    view_length(buffer.length())
+{
+}
+
+// @throws RangeException
+CharBufferView::CharBufferView(const char* const text):
+    view_data(text),
+    view_length(CharKernels::bounded_c_str_length(text, CharBuffer::MAX_CAPACITY))
+{
+}
+
+bool CharBufferView::operator==(const CharBufferView& other) const noexcept
+{
+    return view_length == other.view_length &&
+        CharKernels::find_mismatch(view_data, other.view_data, view_length) == view_length;
+}
+
+bool CharBufferView::operator==(const CharBuffer& other) const noexcept
+{
+    return other.equals_raw(view_data, view_length);
+}
+
+// @throws RangeException
+bool CharBufferView::operator==(const char* const text) const
+{
+    return *this == CharBufferView(text);
+}
+
+bool CharBufferView::operator!=(const CharBufferView& other) const noexcept
+{
+    return !(*this == other);
+}
+
+bool CharBufferView::operator!=(const CharBuffer& other) const noexcept
+{
+    return !(*this == other);
+}
+
+// @throws RangeException
+bool CharBufferView::operator!=(const char* const text) const
+{
+    return !(*this == text);
+}
+
+bool CharBufferView::operator<(const CharBufferView& other) const noexcept
+{
+    return compare_to(other) < 0;
+}
+
+bool CharBufferView::operator>(const CharBufferView& other) const noexcept
+{
+    return compare_to(other) > 0;
+}
+
+bool CharBufferView::operator<=(const CharBufferView& other) const noexcept
+{
+    return compare_to(other) <= 0;
+}
+
+bool CharBufferView::operator>=(const CharBufferView& other) const noexcept
+{
+    return compare_to(other) >= 0;
+}
+
+// @throws RangeException
+const char& CharBufferView::operator[](const size_t index) const
+{
+    if (index >= view_length)
+    {
+        throw RangeException();
+    }
+    return view_data[index];
+}
+
+size_t CharBufferView::hash() const noexcept
+{
+    return static_cast<size_t> (CharBufferHash::hash(view_data, view_length));
+}
+
+// @throws RangeException
+CharBufferView CharBufferView::view(const size_t start, const size_t end) const
+{
+    if (start > end || end > view_length)
+    {
+        throw RangeException();
+    }
+    return CharBufferView(&(view_data[start]), end - start);
+}
+
+int CharBufferView::compare_to(const CharBufferView& other) const noexcept
+{
+    return CharKernels::compare(view_data, view_length, other.view_data, other.view_length);
+}
+
+int CharBufferView::compare_to(const CharBuffer& other) const noexcept
+{
+    return CharKernels::compare(view_data, view_length, other.c_str(), other.length());
+}
+
+// @throws RangeException
+int CharBufferView::compare_to(const char* const text) const
+{
+    const size_t text_length = CharKernels::bounded_c_str_length(text, CharBuffer::MAX_CAPACITY);
+    return CharKernels::compare(view_data, view_length, text, text_length);
+}
+
+bool CharBufferView::starts_with(const CharBufferView& other) const noexcept
+{
+    return view_length >= other.view_length && CharBufferView(view_data, other.view_length) == other;
+}
+
+bool CharBufferView::starts_with(const CharBuffer& other) const noexcept
+{
+    return starts_with(CharBufferView(other));
+}
+
+// @throws RangeException
+bool CharBufferView::starts_with(const char* const text) const
+{
+    return starts_with(CharBufferView(text));
+}
+
+bool CharBufferView::ends_with(const CharBufferView& other) const noexcept
+{
+    return view_length >= other.view_length &&
+        CharBufferView(&(view_data[view_length - other.view_length]), other.view_length) == other;
+}
+
+bool CharBufferView::ends_with(const CharBuffer& other) const noexcept
+{
+    return ends_with(CharBufferView(other));
+}
+
+// @throws RangeException
+bool CharBufferView::ends_with(const char* const text) const
+{
+    return ends_with(CharBufferView(text));
+}
+
+size_t CharBufferView::index_of(const char letter) const noexcept
+{
+    const size_t index = CharKernels::find_char(view_data, 0, view_length, letter);
+    return index < view_length ? index : CharBuffer::NPOS;
+}
+
+// @throws RangeException
+size_t CharBufferView::index_of(const char letter, const size_t start) const
+{
+    if (start > view_length)
+    {
+        throw RangeException();
+    }
+    const size_t index = CharKernels::find_char(view_data, start, view_length, letter);
+    return index < view_length ? index : CharBuffer::NPOS;
+}
+
+size_t CharBufferView::index_of(const CharBufferView& other) const noexcept
+{
+    return CharPattern::find(view_data, view_length, other.view_data, other.view_length, 0);
+}
+
+size_t CharBufferView::index_of(const CharBuffer& other) const noexcept
+{
+    return CharPattern::find(view_data, view_length, other.c_str(), other.length(), 0);
+}
+
+size_t CharBufferView::index_of(const CharPattern& pattern) const noexcept
+{
+    return pattern.find_in(view_data, view_length, 0);
+}
+
+// @throws RangeException
+size_t CharBufferView::index_of(const char* const text) const
+{
+    const size_t text_length = CharKernels::bounded_c_str_length(text, CharBuffer::MAX_CAPACITY);
+    return CharPattern::find(view_data, view_length, text, text_length, 0);
+}
+
+// @throws RangeException
+size_t CharBufferView::index_of(const CharBufferView& other, const size_t start) const
+{
+    if (start > view_length)
+    {
+        throw RangeException();
+    }
+    return CharPattern::find(view_data, view_length, other.view_data, other.view_length, start);
+}
+
+// @throws RangeException
+size_t CharBufferView::index_of(const CharBuffer& other, const size_t start) const
+{
+    return index_of(CharBufferView(other), start);
+}
+
+// @throws RangeException
+size_t CharBufferView::index_of(const CharPattern& pattern, const size_t start) const
+{
+    if (start > view_length)
+    {
+        throw RangeException();
+    }
+    return pattern.find_in(view_data, view_length, start);
+}
+
+// @throws RangeException
+size_t CharBufferView::index_of(const char* const text, const size_t start) const
+{
+    return index_of(CharBufferView(text), start);
+}
+
+bool operator==(const CharBuffer& buffer, const CharBufferView& view) noexcept
+{
+    return view == buffer;
+}
+
+bool operator!=(const CharBuffer& buffer, const CharBufferView& view) noexcept
+{
+    return view != buffer;
+}
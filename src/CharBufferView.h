@@ -0,0 +1,137 @@
+#ifndef CHARBUFFERVIEW_H
+#define CHARBUFFERVIEW_H
+
+#include <cstddef>
+#include <functional>
+
+class CharBuffer;
+class CharPattern;
+
+// Non-owning, read-only view of a range of characters
+// A view consists of a pointer and a length only. The characters are not required to be
+// null-terminated, and the view is invalidated by any operation that modifies or reallocates
+// the storage that it refers to.
+class CharBufferView
+{
+  public:
+    CharBufferView() noexcept;
+    explicit CharBufferView(const char* data, size_t length) noexcept;
+    explicit CharBufferView(const CharBuffer& buffer) noexcept;
+
+    // @throws RangeException
+    explicit CharBufferView(const char* text);
+
+    CharBufferView(const CharBufferView& orig) = default;
+    CharBufferView& operator=(const CharBufferView& orig) = default;
+    CharBufferView(CharBufferView&& orig) = default;
+    CharBufferView& operator=(CharBufferView&& orig) = default;
+
+    bool operator==(const CharBufferView& other) const noexcept;
+    bool operator==(const CharBuffer& other) const noexcept;
+
+    // @throws RangeException
+    bool operator==(const char* text) const;
+
+    bool operator!=(const CharBufferView& other) const noexcept;
+    bool operator!=(const CharBuffer& other) const noexcept;
+
+    // @throws RangeException
+    bool operator!=(const char* text) const;
+
+    bool operator<(const CharBufferView& other) const noexcept;
+    bool operator>(const CharBufferView& other) const noexcept;
+    bool operator<=(const CharBufferView& other) const noexcept;
+    bool operator>=(const CharBufferView& other) const noexcept;
+
+    // @throws RangeException
+    const char& operator[](size_t index) const;
+
+    bool is_empty() const noexcept;
+    size_t length() const noexcept;
+    const char* data() const noexcept;
+
+    // Returns the same hash value as CharBuffer::hash() for a buffer with the same content
+    size_t hash() const noexcept;
+
+    // Returns a view of the range [start, end) of this view
+    // @throws RangeException
+    CharBufferView view(size_t start, size_t end) const;
+
+    int compare_to(const CharBufferView& other) const noexcept;
+    int compare_to(const CharBuffer& other) const noexcept;
+
+    // @throws RangeException
+    int compare_to(const char* text) const;
+
+    bool starts_with(const CharBufferView& other) const noexcept;
+    bool starts_with(const CharBuffer& other) const noexcept;
+
+    // @throws RangeException
+    bool starts_with(const char* text) const;
+
+    bool ends_with(const CharBufferView& other) const noexcept;
+    bool ends_with(const CharBuffer& other) const noexcept;
+
+    // @throws RangeException
+    bool ends_with(const char* text) const;
+
+    size_t index_of(char letter) const noexcept;
+
+    // @throws RangeException
+    size_t index_of(char letter, size_t start) const;
+
+    size_t index_of(const CharBufferView& other) const noexcept;
+    size_t index_of(const CharBuffer& other) const noexcept;
+    size_t index_of(const CharPattern& pattern) const noexcept;
+
+    // @throws RangeException
+    size_t index_of(const char* text) const;
+
+    // @throws RangeException
+    size_t index_of(const CharBufferView& other, size_t start) const;
+
+    // @throws RangeException
+    size_t index_of(const CharBuffer& other, size_t start) const;
+
+    // @throws RangeException
+    size_t index_of(const CharPattern& pattern, size_t start) const;
+
+    // @throws RangeException
+    size_t index_of(const char* text, size_t start) const;
+
+  private:
+    const char* view_data;
+    size_t view_length;
+};
+
+bool operator==(const CharBuffer& buffer, const CharBufferView& view) noexcept;
+bool operator!=(const CharBuffer& buffer, const CharBufferView& view) noexcept;
+
+namespace std
+{
+    template<>
+    struct hash<CharBufferView>
+    {
+        size_t operator()(const CharBufferView& view) const noexcept
+        {
+            return view.hash();
+        }
+    };
+}
+
+inline bool CharBufferView::is_empty() const noexcept
+{
+    return view_length == 0;
+}
+
+inline size_t CharBufferView::length() const noexcept
+{
+    return view_length;
+}
+
+inline const char* CharBufferView::data() const noexcept
+{
+    return view_data;
+}
+
+#endif /* CHARBUFFERVIEW_H */
@@ -0,0 +1,1678 @@
+#include <CharKernels.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include <RangeException.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define CHARKERNELS_X86
+    #include <immintrin.h>
+#endif
+
+struct KernelTable
+{
+    const char* isa_name;
+    size_t (*find_char)(const char* data, size_t start, size_t end, char letter);
+    size_t (*find_substring)(const char* data, size_t start, size_t end, const char* pattern, size_t pat_length);
+    size_t (*find_mismatch)(const char* data, const char* other_data, size_t length);
+    size_t (*find_terminator)(const char* data, size_t max_length);
+    uint64_t (*match_set)(const char* data, size_t length, const CharKernels::CharSet& set);
+    size_t (*count_char)(const char* data, size_t start, size_t end, char letter);
+    size_t (*find_last_char)(const char* data, size_t start, size_t end, char letter);
+    size_t (*find_last_substring)(const char* data, size_t start, size_t end, const char* pattern, size_t pat_length);
+    void (*change_case)(char* data, size_t length, char range_first);
+    size_t (*find_mismatch_icase)(const char* data, const char* other_data, size_t length);
+    size_t (*find_substring_icase)(const char* data, size_t start, size_t end, const char* pattern, size_t pat_length);
+};
+
+// Length of the ranges of ASCII letters of either case
+static const int LETTER_COUNT = 26;
+// Bit that distinguishes a lowercase ASCII letter from its uppercase counterpart
+static const char CASE_BIT = 0x20;
+
+
+const size_t CharKernels::MATCH_BLOCK_LENGTH;
+
+static std::atomic<const KernelTable*>& selected_kernels() noexcept;
+static const KernelTable& kernels() noexcept;
+static const KernelTable* select_kernels() noexcept;
+inline static bool cpu_supports(const char* isa_name) noexcept;
+
+static size_t find_char_scalar(const char* data, size_t start, size_t end, char letter);
+static size_t find_substring_scalar(
+    const char* data, size_t start, size_t end, const char* pattern, size_t pat_length
+);
+static size_t find_mismatch_scalar(const char* data, const char* other_data, size_t length);
+static size_t find_terminator_scalar(const char* data, size_t max_length);
+static uint64_t match_set_scalar(const char* data, size_t length, const CharKernels::CharSet& set);
+static size_t count_char_scalar(const char* data, size_t start, size_t end, char letter);
+static size_t find_last_char_scalar(const char* data, size_t start, size_t end, char letter);
+static size_t find_last_substring_scalar(
+    const char* data, size_t start, size_t end, const char* pattern, size_t pat_length
+);
+static void change_case_scalar(char* data, size_t length, char range_first);
+static size_t find_mismatch_icase_scalar(const char* data, const char* other_data, size_t length);
+static size_t find_substring_icase_scalar(
+    const char* data, size_t start, size_t end, const char* pattern, size_t pat_length
+);
+
+inline static char fold_lower(char letter) noexcept;
+
+#ifdef CHARKERNELS_X86
+static size_t find_char_sse2(const char* data, size_t start, size_t end, char letter);
+static size_t find_char_avx2(const char* data, size_t start, size_t end, char letter);
+static size_t find_char_avx512(const char* data, size_t start, size_t end, char letter);
+static size_t find_substring_sse2(
+    const char* data, size_t start, size_t end, const char* pattern, size_t pat_length
+);
+static size_t find_substring_avx2(
+    const char* data, size_t start, size_t end, const char* pattern, size_t pat_length
+);
+static size_t find_substring_avx512(
+    const char* data, size_t start, size_t end, const char* pattern, size_t pat_length
+);
+static size_t find_mismatch_sse2(const char* data, const char* other_data, size_t length);
+static size_t find_mismatch_avx2(const char* data, const char* other_data, size_t length);
+static size_t find_mismatch_avx512(const char* data, const char* other_data, size_t length);
+static size_t find_terminator_sse2(const char* data, size_t max_length);
+static size_t find_terminator_avx2(const char* data, size_t max_length);
+static size_t find_terminator_avx512(const char* data, size_t max_length);
+static uint64_t match_set_sse2(const char* data, size_t length, const CharKernels::CharSet& set);
+static uint64_t match_set_avx2(const char* data, size_t length, const CharKernels::CharSet& set);
+static uint64_t match_set_avx512(const char* data, size_t length, const CharKernels::CharSet& set);
+static size_t count_char_sse2(const char* data, size_t start, size_t end, char letter);
+static size_t count_char_avx2(const char* data, size_t start, size_t end, char letter);
+static size_t count_char_avx512(const char* data, size_t start, size_t end, char letter);
+static size_t find_last_char_sse2(const char* data, size_t start, size_t end, char letter);
+static size_t find_last_char_avx2(const char* data, size_t start, size_t end, char letter);
+static size_t find_last_char_avx512(const char* data, size_t start, size_t end, char letter);
+static size_t find_last_substring_sse2(
+    const char* data, size_t start, size_t end, const char* pattern, size_t pat_length
+);
+static size_t find_last_substring_avx2(
+    const char* data, size_t start, size_t end, const char* pattern, size_t pat_length
+);
+static size_t find_last_substring_avx512(
+    const char* data, size_t start, size_t end, const char* pattern, size_t pat_length
+);
+static void change_case_sse2(char* data, size_t length, char range_first);
+static void change_case_avx2(char* data, size_t length, char range_first);
+static void change_case_avx512(char* data, size_t length, char range_first);
+static size_t find_mismatch_icase_sse2(const char* data, const char* other_data, size_t length);
+static size_t find_mismatch_icase_avx2(const char* data, const char* other_data, size_t length);
+static size_t find_mismatch_icase_avx512(const char* data, const char* other_data, size_t length);
+static size_t find_substring_icase_sse2(
+    const char* data, size_t start, size_t end, const char* pattern, size_t pat_length
+);
+static size_t find_substring_icase_avx2(
+    const char* data, size_t start, size_t end, const char* pattern, size_t pat_length
+);
+static size_t find_substring_icase_avx512(
+    const char* data, size_t start, size_t end, const char* pattern, size_t pat_length
+);
+#endif
+
+// Kernel sets in order of preference
+static const KernelTable KERNEL_TABLES[] = {
+    #ifdef CHARKERNELS_X86
+    {
+        "avx512", find_char_avx512, find_substring_avx512, find_mismatch_avx512, find_terminator_avx512,
+        match_set_avx512, count_char_avx512, find_last_char_avx512, find_last_substring_avx512,
+        change_case_avx512, find_mismatch_icase_avx512, find_substring_icase_avx512
+    },
+    {
+        "avx2", find_char_avx2, find_substring_avx2, find_mismatch_avx2, find_terminator_avx2,
+        match_set_avx2, count_char_avx2, find_last_char_avx2, find_last_substring_avx2,
+        change_case_avx2, find_mismatch_icase_avx2, find_substring_icase_avx2
+    },
+    {
+        "sse2", find_char_sse2, find_substring_sse2, find_mismatch_sse2, find_terminator_sse2,
+        match_set_sse2, count_char_sse2, find_last_char_sse2, find_last_substring_sse2,
+        change_case_sse2, find_mismatch_icase_sse2, find_substring_icase_sse2
+    },
+    #endif
+    {
+        "scalar", find_char_scalar, find_substring_scalar, find_mismatch_scalar, find_terminator_scalar,
+        match_set_scalar, count_char_scalar, find_last_char_scalar, find_last_substring_scalar,
+        change_case_scalar, find_mismatch_icase_scalar, find_substring_icase_scalar
+    }
+};
+
+static const size_t KERNEL_TABLE_COUNT = sizeof (KERNEL_TABLES) / sizeof (KERNEL_TABLES[0]);
+
+size_t CharKernels::find_char(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char letter
+) noexcept
+{
+    return kernels().find_char(data, start, end, letter);
+}
+
+size_t CharKernels::count_char(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char letter
+) noexcept
+{
+    return kernels().count_char(data, start, end, letter);
+}
+
+size_t CharKernels::find_last_char(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char letter
+) noexcept
+{
+    return kernels().find_last_char(data, start, end, letter);
+}
+
+size_t CharKernels::find_substring(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length
+) noexcept
+{
+    return kernels().find_substring(data, start, end, pattern, pat_length);
+}
+
+size_t CharKernels::find_last_substring(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length
+) noexcept
+{
+    return kernels().find_last_substring(data, start, end, pattern, pat_length);
+}
+
+size_t CharKernels::find_mismatch(
+    const char* const data,
+    const char* const other_data,
+    const size_t length
+) noexcept
+{
+    return kernels().find_mismatch(data, other_data, length);
+}
+
+int CharKernels::compare(
+    const char* const data,
+    const size_t length,
+    const char* const other_data,
+    const size_t other_length
+) noexcept
+{
+    int result = 0;
+    const size_t cmp_length = length <= other_length ? length : other_length;
+    const size_t idx = kernels().find_mismatch(data, other_data, cmp_length);
+    if (idx < cmp_length)
+    {
+        result = data[idx] < other_data[idx] ? -1 : 1;
+    }
+    else if (length != other_length)
+    {
+        result = length < other_length ? -1 : 1;
+    }
+    return result;
+}
+
+void CharKernels::to_lower(char* const data, const size_t length) noexcept
+{
+    kernels().change_case(data, length, 'A');
+}
+
+void CharKernels::to_upper(char* const data, const size_t length) noexcept
+{
+    kernels().change_case(data, length, 'a');
+}
+
+size_t CharKernels::find_mismatch_icase(
+    const char* const data,
+    const char* const other_data,
+    const size_t length
+) noexcept
+{
+    return kernels().find_mismatch_icase(data, other_data, length);
+}
+
+size_t CharKernels::find_substring_icase(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length
+) noexcept
+{
+    return kernels().find_substring_icase(data, start, end, pattern, pat_length);
+}
+
+size_t CharKernels::find_terminator(const char* const data, const size_t max_length) noexcept
+{
+    return kernels().find_terminator(data, max_length);
+}
+
+// @throws RangeException
+size_t CharKernels::bounded_c_str_length(const char* const text, const size_t max_length)
+{
+    const size_t length = kernels().find_terminator(text, max_length + 1);
+    if (length > max_length)
+    {
+        throw RangeException();
+    }
+    return length;
+}
+
+void CharKernels::prepare_set(const char* const members, const size_t count, CharSet& set) noexcept
+{
+    std::memset(&set, 0, sizeof (set));
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        const unsigned char member = static_cast<unsigned char> (members[idx]);
+        const uint64_t member_bit = static_cast<uint64_t> (1) << (member & 63);
+        if ((set.bitmap[member >> 6] & member_bit) == 0)
+        {
+            set.bitmap[member >> 6] |= member_bit;
+            const size_t high_nibble = member >> 4;
+            uint8_t* const nibble_rows = high_nibble < 8 ? set.nibble_rows_lo : set.nibble_rows_hi;
+            nibble_rows[member & 0xF] |= static_cast<uint8_t> (1 << (high_nibble & 7));
+            if (set.count == 0 || member < static_cast<unsigned char> (set.first))
+            {
+                set.first = static_cast<char> (member);
+            }
+            ++set.count;
+        }
+    }
+}
+
+uint64_t CharKernels::match_set(const char* const data, const size_t length, const CharSet& set) noexcept
+{
+    return kernels().match_set(data, length, set);
+}
+
+const char* CharKernels::isa_name() noexcept
+{
+    return kernels().isa_name;
+}
+
+bool CharKernels::select_isa(const char* const isa_name) noexcept
+{
+    bool selected = false;
+    for (size_t idx = 0; idx < KERNEL_TABLE_COUNT && !selected; ++idx)
+    {
+        if (std::strcmp(KERNEL_TABLES[idx].isa_name, isa_name) == 0 && cpu_supports(isa_name))
+        {
+            selected_kernels().store(&(KERNEL_TABLES[idx]), std::memory_order_relaxed);
+            selected = true;
+        }
+    }
+    return selected;
+}
+
+static std::atomic<const KernelTable*>& selected_kernels() noexcept
+{
+    static std::atomic<const KernelTable*> table(select_kernels());
+    return table;
+}
+
+static const KernelTable& kernels() noexcept
+{
+    return *(selected_kernels().load(std::memory_order_relaxed));
+}
+
+static const KernelTable* select_kernels() noexcept
+{
+    // The scalar kernels come last and are always supported
+    const KernelTable* table = nullptr;
+    for (size_t idx = 0; idx < KERNEL_TABLE_COUNT && table == nullptr; ++idx)
+    {
+        if (cpu_supports(KERNEL_TABLES[idx].isa_name))
+        {
+            table = &(KERNEL_TABLES[idx]);
+        }
+    }
+    return table;
+}
+
+inline static bool cpu_supports(const char* const isa_name) noexcept
+{
+    bool supported = std::strcmp(isa_name, "scalar") == 0;
+    #ifdef CHARKERNELS_X86
+    __builtin_cpu_init();
+    if (std::strcmp(isa_name, "avx512") == 0)
+    {
+        supported = __builtin_cpu_supports("avx512bw");
+    }
+    else if (std::strcmp(isa_name, "avx2") == 0)
+    {
+        supported = __builtin_cpu_supports("avx2");
+    }
+    else if (std::strcmp(isa_name, "sse2") == 0)
+    {
+        supported = __builtin_cpu_supports("sse2");
+    }
+    #endif
+    return supported;
+}
+
+static size_t find_char_scalar(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char letter
+)
+{
+    size_t idx = start;
+    while (idx < end && data[idx] != letter)
+    {
+        ++idx;
+    }
+    return idx;
+}
+
+static size_t count_char_scalar(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char letter
+)
+{
+    size_t count = 0;
+    for (size_t idx = start; idx < end; ++idx)
+    {
+        count += data[idx] == letter ? 1 : 0;
+    }
+    return count;
+}
+
+static size_t find_last_char_scalar(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char letter
+)
+{
+    size_t idx = end;
+    while (idx > start)
+    {
+        --idx;
+        if (data[idx] == letter)
+        {
+            return idx;
+        }
+    }
+    return end;
+}
+
+static size_t find_last_substring_scalar(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length
+)
+{
+    if (end - start >= pat_length)
+    {
+        const size_t last_offset = pat_length - 1;
+        // One past the last candidate position
+        size_t idx = end - pat_length + 1;
+        while (idx > start)
+        {
+            --idx;
+            if (data[idx] == pattern[0] && data[idx + last_offset] == pattern[last_offset] &&
+                std::memcmp(&(data[idx + 1]), &(pattern[1]), pat_length - 2) == 0)
+            {
+                return idx;
+            }
+        }
+    }
+    return end;
+}
+
+static size_t find_substring_scalar(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length
+)
+{
+    if (end - start >= pat_length)
+    {
+        const size_t last_offset = pat_length - 1;
+        const size_t end_offset = end - pat_length;
+        for (size_t idx = start; idx <= end_offset; ++idx)
+        {
+            if (data[idx] == pattern[0] && data[idx + last_offset] == pattern[last_offset] &&
+                std::memcmp(&(data[idx + 1]), &(pattern[1]), pat_length - 2) == 0)
+            {
+                return idx;
+            }
+        }
+    }
+    return end;
+}
+
+static size_t find_mismatch_scalar(
+    const char* const data,
+    const char* const other_data,
+    const size_t length
+)
+{
+    size_t idx = 0;
+    while (idx < length && data[idx] == other_data[idx])
+    {
+        ++idx;
+    }
+    return idx;
+}
+
+static void change_case_scalar(char* const data, const size_t length, const char range_first)
+{
+    for (size_t idx = 0; idx < length; ++idx)
+    {
+        if (static_cast<unsigned char> (data[idx] - range_first) < LETTER_COUNT)
+        {
+            data[idx] ^= CASE_BIT;
+        }
+    }
+}
+
+static size_t find_mismatch_icase_scalar(
+    const char* const data,
+    const char* const other_data,
+    const size_t length
+)
+{
+    size_t idx = 0;
+    while (idx < length && fold_lower(data[idx]) == fold_lower(other_data[idx]))
+    {
+        ++idx;
+    }
+    return idx;
+}
+
+static size_t find_substring_icase_scalar(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length
+)
+{
+    if (end - start >= pat_length)
+    {
+        const size_t last_offset = pat_length - 1;
+        const size_t end_offset = end - pat_length;
+        const char first_char = fold_lower(pattern[0]);
+        const char last_char = fold_lower(pattern[last_offset]);
+        for (size_t idx = start; idx <= end_offset; ++idx)
+        {
+            if (fold_lower(data[idx]) == first_char && fold_lower(data[idx + last_offset]) == last_char &&
+                find_mismatch_icase_scalar(&(data[idx]), pattern, pat_length) == pat_length)
+            {
+                return idx;
+            }
+        }
+    }
+    return end;
+}
+
+inline static char fold_lower(const char letter) noexcept
+{
+    return static_cast<unsigned char> (letter - 'A') < LETTER_COUNT ? static_cast<char> (letter ^ CASE_BIT) : letter;
+}
+
+static size_t find_terminator_scalar(const char* const data, const size_t max_length)
+{
+    size_t idx = 0;
+    while (idx < max_length && data[idx] != '\0')
+    {
+        ++idx;
+    }
+    return idx;
+}
+
+static uint64_t match_set_scalar(const char* const data, const size_t length, const CharKernels::CharSet& set)
+{
+    const size_t block_length = length < CharKernels::MATCH_BLOCK_LENGTH ? length : CharKernels::MATCH_BLOCK_LENGTH;
+    uint64_t mask = 0;
+    for (size_t idx = 0; idx < block_length; ++idx)
+    {
+        const unsigned char letter = static_cast<unsigned char> (data[idx]);
+        const uint64_t member_bit = (set.bitmap[letter >> 6] >> (letter & 63)) & 1;
+        mask |= member_bit << idx;
+    }
+    return mask;
+}
+
+#ifdef CHARKERNELS_X86
+__attribute__((target("sse2")))
+static size_t find_char_sse2(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char letter
+)
+{
+    const __m128i pattern = _mm_set1_epi8(letter);
+    size_t idx = start;
+    while (end - idx >= 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*> (&(data[idx])));
+        const unsigned int mask = static_cast<unsigned int> (_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+        if (mask != 0)
+        {
+            return idx + static_cast<size_t> (__builtin_ctz(mask));
+        }
+        idx += 16;
+    }
+    return find_char_scalar(data, idx, end, letter);
+}
+
+__attribute__((target("avx2")))
+static size_t find_char_avx2(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char letter
+)
+{
+    const __m256i pattern = _mm256_set1_epi8(letter);
+    size_t idx = start;
+    // Unrolled main loop, two vectors per iteration
+    while (end - idx >= 64)
+    {
+        const __m256i block_lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(data[idx])));
+        const __m256i block_hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(data[idx + 32])));
+        const __m256i cmp_lo = _mm256_cmpeq_epi8(block_lo, pattern);
+        const __m256i cmp_hi = _mm256_cmpeq_epi8(block_hi, pattern);
+        if (!_mm256_testz_si256(_mm256_or_si256(cmp_lo, cmp_hi), _mm256_or_si256(cmp_lo, cmp_hi)))
+        {
+            const uint64_t mask =
+                static_cast<uint64_t> (static_cast<uint32_t> (_mm256_movemask_epi8(cmp_lo))) |
+                (static_cast<uint64_t> (static_cast<uint32_t> (_mm256_movemask_epi8(cmp_hi))) << 32);
+            return idx + static_cast<size_t> (__builtin_ctzll(mask));
+        }
+        idx += 64;
+    }
+    while (end - idx >= 32)
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(data[idx])));
+        const uint32_t mask = static_cast<uint32_t> (_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)));
+        if (mask != 0)
+        {
+            return idx + static_cast<size_t> (__builtin_ctz(mask));
+        }
+        idx += 32;
+    }
+    return find_char_sse2(data, idx, end, letter);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static size_t find_char_avx512(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char letter
+)
+{
+    const __m512i pattern = _mm512_set1_epi8(letter);
+    size_t idx = start;
+    while (end - idx >= 64)
+    {
+        const __m512i block = _mm512_loadu_si512(&(data[idx]));
+        const uint64_t mask = _mm512_cmpeq_epi8_mask(block, pattern);
+        if (mask != 0)
+        {
+            return idx + static_cast<size_t> (__builtin_ctzll(mask));
+        }
+        idx += 64;
+    }
+    if (idx < end)
+    {
+        // Masked load of the tail, bytes outside of the mask are not accessed
+        const __mmask64 load_mask = (~static_cast<uint64_t> (0)) >> (64 - (end - idx));
+        const __m512i block = _mm512_maskz_loadu_epi8(load_mask, &(data[idx]));
+        const uint64_t mask = _mm512_mask_cmpeq_epi8_mask(load_mask, block, pattern);
+        if (mask != 0)
+        {
+            return idx + static_cast<size_t> (__builtin_ctzll(mask));
+        }
+        idx = end;
+    }
+    return idx;
+}
+__attribute__((target("sse2")))
+static size_t find_substring_sse2(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length
+)
+{
+    if (end - start < pat_length)
+    {
+        return end;
+    }
+    const size_t last_offset = pat_length - 1;
+    const size_t end_offset = end - pat_length;
+    const __m128i first_char = _mm_set1_epi8(pattern[0]);
+    const __m128i last_char = _mm_set1_epi8(pattern[last_offset]);
+    size_t idx = start;
+    // Each iteration tests 16 candidate positions, all of which must be <= end_offset
+    while (idx + 15 <= end_offset)
+    {
+        const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*> (&(data[idx])));
+        const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*> (&(data[idx + last_offset])));
+        unsigned int mask = static_cast<unsigned int> (
+            _mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(block_first, first_char), _mm_cmpeq_epi8(block_last, last_char))
+            )
+        );
+        while (mask != 0)
+        {
+            const size_t candidate = idx + static_cast<size_t> (__builtin_ctz(mask));
+            if (std::memcmp(&(data[candidate + 1]), &(pattern[1]), pat_length - 2) == 0)
+            {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+        idx += 16;
+    }
+    return find_substring_scalar(data, idx, end, pattern, pat_length);
+}
+
+__attribute__((target("avx2")))
+static size_t find_substring_avx2(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length
+)
+{
+    if (end - start < pat_length)
+    {
+        return end;
+    }
+    const size_t last_offset = pat_length - 1;
+    const size_t end_offset = end - pat_length;
+    const __m256i first_char = _mm256_set1_epi8(pattern[0]);
+    const __m256i last_char = _mm256_set1_epi8(pattern[last_offset]);
+    size_t idx = start;
+    while (idx + 31 <= end_offset)
+    {
+        const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(data[idx])));
+        const __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(data[idx + last_offset])));
+        uint32_t mask = static_cast<uint32_t> (
+            _mm256_movemask_epi8(
+                _mm256_and_si256(
+                    _mm256_cmpeq_epi8(block_first, first_char),
+                    _mm256_cmpeq_epi8(block_last, last_char)
+                )
+            )
+        );
+        while (mask != 0)
+        {
+            const size_t candidate = idx + static_cast<size_t> (__builtin_ctz(mask));
+            if (std::memcmp(&(data[candidate + 1]), &(pattern[1]), pat_length - 2) == 0)
+            {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+        idx += 32;
+    }
+    return find_substring_sse2(data, idx, end, pattern, pat_length);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static size_t find_substring_avx512(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length
+)
+{
+    if (end - start < pat_length)
+    {
+        return end;
+    }
+    const size_t last_offset = pat_length - 1;
+    const size_t end_offset = end - pat_length;
+    const __m512i first_char = _mm512_set1_epi8(pattern[0]);
+    const __m512i last_char = _mm512_set1_epi8(pattern[last_offset]);
+    size_t idx = start;
+    while (idx + 63 <= end_offset)
+    {
+        const __m512i block_first = _mm512_loadu_si512(&(data[idx]));
+        const __m512i block_last = _mm512_loadu_si512(&(data[idx + last_offset]));
+        uint64_t mask = _mm512_mask_cmpeq_epi8_mask(
+            _mm512_cmpeq_epi8_mask(block_first, first_char),
+            block_last,
+            last_char
+        );
+        while (mask != 0)
+        {
+            const size_t candidate = idx + static_cast<size_t> (__builtin_ctzll(mask));
+            if (std::memcmp(&(data[candidate + 1]), &(pattern[1]), pat_length - 2) == 0)
+            {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+        idx += 64;
+    }
+    return find_substring_avx2(data, idx, end, pattern, pat_length);
+}
+__attribute__((target("sse2")))
+static size_t find_mismatch_sse2(
+    const char* const data,
+    const char* const other_data,
+    const size_t length
+)
+{
+    size_t idx = 0;
+    while (length - idx >= 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*> (&(data[idx])));
+        const __m128i other_block = _mm_loadu_si128(reinterpret_cast<const __m128i*> (&(other_data[idx])));
+        const unsigned int mask = static_cast<unsigned int> (_mm_movemask_epi8(_mm_cmpeq_epi8(block, other_block)));
+        if (mask != 0xFFFF)
+        {
+            return idx + static_cast<size_t> (__builtin_ctz(~mask));
+        }
+        idx += 16;
+    }
+    return idx + find_mismatch_scalar(&(data[idx]), &(other_data[idx]), length - idx);
+}
+
+__attribute__((target("avx2")))
+static size_t find_mismatch_avx2(
+    const char* const data,
+    const char* const other_data,
+    const size_t length
+)
+{
+    size_t idx = 0;
+    while (length - idx >= 32)
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(data[idx])));
+        const __m256i other_block = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(other_data[idx])));
+        const uint32_t mask = static_cast<uint32_t> (_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, other_block)));
+        if (mask != 0xFFFFFFFF)
+        {
+            return idx + static_cast<size_t> (__builtin_ctz(~mask));
+        }
+        idx += 32;
+    }
+    return idx + find_mismatch_sse2(&(data[idx]), &(other_data[idx]), length - idx);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static size_t find_mismatch_avx512(
+    const char* const data,
+    const char* const other_data,
+    const size_t length
+)
+{
+    size_t idx = 0;
+    while (length - idx >= 64)
+    {
+        const __m512i block = _mm512_loadu_si512(&(data[idx]));
+        const __m512i other_block = _mm512_loadu_si512(&(other_data[idx]));
+        const uint64_t mask = _mm512_cmpneq_epi8_mask(block, other_block);
+        if (mask != 0)
+        {
+            return idx + static_cast<size_t> (__builtin_ctzll(mask));
+        }
+        idx += 64;
+    }
+    if (idx < length)
+    {
+        const __mmask64 load_mask = (~static_cast<uint64_t> (0)) >> (64 - (length - idx));
+        const __m512i block = _mm512_maskz_loadu_epi8(load_mask, &(data[idx]));
+        const __m512i other_block = _mm512_maskz_loadu_epi8(load_mask, &(other_data[idx]));
+        const uint64_t mask = _mm512_mask_cmpneq_epi8_mask(load_mask, block, other_block);
+        if (mask != 0)
+        {
+            return idx + static_cast<size_t> (__builtin_ctzll(mask));
+        }
+        idx = length;
+    }
+    return idx;
+}
+
+// The terminator kernels start at the aligned block that contains data and shift out the mask bits
+// of the bytes before data. Aligned loads never cross a page boundary, therefore the bytes that are
+// read outside of the string are always accessible, although they are not part of any object as far
+// as the address and thread sanitizers are concerned.
+__attribute__((target("sse2"), no_sanitize_address, no_sanitize_thread))
+static size_t find_terminator_sse2(const char* const data, const size_t max_length)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const size_t misalign = reinterpret_cast<uintptr_t> (data) & 15;
+    const char* const block_data = data - misalign;
+    const unsigned int mask = static_cast<unsigned int> (
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(reinterpret_cast<const __m128i*> (block_data)), zero))
+    ) >> misalign;
+    if (mask != 0)
+    {
+        const size_t idx = static_cast<size_t> (__builtin_ctz(mask));
+        return idx < max_length ? idx : max_length;
+    }
+    size_t idx = 16 - misalign;
+    while (idx < max_length)
+    {
+        const __m128i block = _mm_load_si128(reinterpret_cast<const __m128i*> (&(data[idx])));
+        const unsigned int block_mask = static_cast<unsigned int> (_mm_movemask_epi8(_mm_cmpeq_epi8(block, zero)));
+        if (block_mask != 0)
+        {
+            idx += static_cast<size_t> (__builtin_ctz(block_mask));
+            return idx < max_length ? idx : max_length;
+        }
+        idx += 16;
+    }
+    return max_length;
+}
+
+__attribute__((target("avx2"), no_sanitize_address, no_sanitize_thread))
+static size_t find_terminator_avx2(const char* const data, const size_t max_length)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const size_t misalign = reinterpret_cast<uintptr_t> (data) & 31;
+    const char* const block_data = data - misalign;
+    const uint32_t mask = static_cast<uint32_t> (
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256(reinterpret_cast<const __m256i*> (block_data)), zero))
+    ) >> misalign;
+    if (mask != 0)
+    {
+        const size_t idx = static_cast<size_t> (__builtin_ctz(mask));
+        return idx < max_length ? idx : max_length;
+    }
+    size_t idx = 32 - misalign;
+    while (idx < max_length)
+    {
+        const __m256i block = _mm256_load_si256(reinterpret_cast<const __m256i*> (&(data[idx])));
+        const uint32_t block_mask = static_cast<uint32_t> (_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, zero)));
+        if (block_mask != 0)
+        {
+            idx += static_cast<size_t> (__builtin_ctz(block_mask));
+            return idx < max_length ? idx : max_length;
+        }
+        idx += 32;
+    }
+    return max_length;
+}
+
+__attribute__((target("avx512f,avx512bw"), no_sanitize_address, no_sanitize_thread))
+static size_t find_terminator_avx512(const char* const data, const size_t max_length)
+{
+    const __m512i zero = _mm512_setzero_si512();
+    const size_t misalign = reinterpret_cast<uintptr_t> (data) & 63;
+    const char* const block_data = data - misalign;
+    const uint64_t mask = _mm512_cmpeq_epi8_mask(_mm512_load_si512(block_data), zero) >> misalign;
+    if (mask != 0)
+    {
+        const size_t idx = static_cast<size_t> (__builtin_ctzll(mask));
+        return idx < max_length ? idx : max_length;
+    }
+    size_t idx = 64 - misalign;
+    while (idx < max_length)
+    {
+        const uint64_t block_mask = _mm512_cmpeq_epi8_mask(_mm512_load_si512(&(data[idx])), zero);
+        if (block_mask != 0)
+        {
+            idx += static_cast<size_t> (__builtin_ctzll(block_mask));
+            return idx < max_length ? idx : max_length;
+        }
+        idx += 64;
+    }
+    return max_length;
+}
+
+// Sets of more than one member are matched with the scalar bitmap lookup,
+// since SSE2 lacks the byte shuffle that the nibble table lookup requires
+__attribute__((target("sse2")))
+static uint64_t match_set_sse2(const char* const data, const size_t length, const CharKernels::CharSet& set)
+{
+    uint64_t mask = 0;
+    if (set.count == 1 && length >= CharKernels::MATCH_BLOCK_LENGTH)
+    {
+        const __m128i member = _mm_set1_epi8(set.first);
+        for (size_t idx = 0; idx < CharKernels::MATCH_BLOCK_LENGTH; idx += 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*> (&(data[idx])));
+            const uint64_t block_mask = static_cast<uint32_t> (_mm_movemask_epi8(_mm_cmpeq_epi8(block, member)));
+            mask |= block_mask << idx;
+        }
+    }
+    else
+    {
+        mask = match_set_scalar(data, length, set);
+    }
+    return mask;
+}
+
+// Looks up each character's high nibble bit in the table row that is selected by its low nibble
+__attribute__((target("avx2")))
+inline static uint32_t match_set_block_avx2(
+    const __m256i block,
+    const __m256i rows_lo,
+    const __m256i rows_hi,
+    const __m256i nibble_bits
+)
+{
+    const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+    const __m256i low_nibbles = _mm256_and_si256(block, nibble_mask);
+    const __m256i high_nibbles = _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble_mask);
+    const __m256i rows = _mm256_blendv_epi8(
+        _mm256_shuffle_epi8(rows_lo, low_nibbles),
+        _mm256_shuffle_epi8(rows_hi, low_nibbles),
+        _mm256_cmpgt_epi8(high_nibbles, _mm256_set1_epi8(7))
+    );
+    const __m256i bits = _mm256_shuffle_epi8(nibble_bits, high_nibbles);
+    return static_cast<uint32_t> (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(rows, bits), bits)));
+}
+
+__attribute__((target("avx2")))
+static uint64_t match_set_avx2(const char* const data, const size_t length, const CharKernels::CharSet& set)
+{
+    uint64_t mask = 0;
+    if (length >= CharKernels::MATCH_BLOCK_LENGTH)
+    {
+        const __m256i block_lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (data));
+        const __m256i block_hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(data[32])));
+        if (set.count == 1)
+        {
+            const __m256i member = _mm256_set1_epi8(set.first);
+            mask = static_cast<uint64_t> (static_cast<uint32_t> (_mm256_movemask_epi8(_mm256_cmpeq_epi8(block_lo, member)))) |
+                (static_cast<uint64_t> (static_cast<uint32_t> (_mm256_movemask_epi8(_mm256_cmpeq_epi8(block_hi, member)))) << 32);
+        }
+        else
+        {
+            const __m256i rows_lo = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*> (set.nibble_rows_lo))
+            );
+            const __m256i rows_hi = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*> (set.nibble_rows_hi))
+            );
+            const __m256i nibble_bits = _mm256_setr_epi8(
+                1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128
+            );
+            mask = static_cast<uint64_t> (match_set_block_avx2(block_lo, rows_lo, rows_hi, nibble_bits)) |
+                (static_cast<uint64_t> (match_set_block_avx2(block_hi, rows_lo, rows_hi, nibble_bits)) << 32);
+        }
+    }
+    else
+    {
+        mask = match_set_scalar(data, length, set);
+    }
+    return mask;
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static uint64_t match_set_avx512(const char* const data, const size_t length, const CharKernels::CharSet& set)
+{
+    uint64_t mask = 0;
+    if (length > 0)
+    {
+        // Masked load of a partial block, bytes outside of the mask are not accessed
+        const __mmask64 load_mask = length >= CharKernels::MATCH_BLOCK_LENGTH ?
+            ~static_cast<uint64_t> (0) : (~static_cast<uint64_t> (0)) >> (CharKernels::MATCH_BLOCK_LENGTH - length);
+        const __m512i block = _mm512_maskz_loadu_epi8(load_mask, data);
+        if (set.count == 1)
+        {
+            mask = _mm512_mask_cmpeq_epi8_mask(load_mask, block, _mm512_set1_epi8(set.first));
+        }
+        else
+        {
+            // The zero-masking broadcast is used because the unmasked one is based on an undefined
+            // vector, which triggers false uninitialized-value warnings in some compilers
+            const __mmask16 all_lanes = static_cast<__mmask16> (0xFFFF);
+            const __m512i rows_lo = _mm512_maskz_broadcast_i32x4(
+                all_lanes,
+                _mm_loadu_si128(reinterpret_cast<const __m128i*> (set.nibble_rows_lo))
+            );
+            const __m512i rows_hi = _mm512_maskz_broadcast_i32x4(
+                all_lanes,
+                _mm_loadu_si128(reinterpret_cast<const __m128i*> (set.nibble_rows_hi))
+            );
+            // Bytes 1, 2, 4, ..., 128, repeated
+            const __m512i nibble_bits = _mm512_set1_epi64(static_cast<long long> (0x8040201008040201ULL));
+            const __m512i nibble_mask = _mm512_set1_epi8(0x0F);
+            const __m512i low_nibbles = _mm512_and_si512(block, nibble_mask);
+            const __m512i high_nibbles = _mm512_and_si512(_mm512_srli_epi16(block, 4), nibble_mask);
+            const __m512i rows = _mm512_mask_blend_epi8(
+                _mm512_cmpgt_epu8_mask(high_nibbles, _mm512_set1_epi8(7)),
+                _mm512_shuffle_epi8(rows_lo, low_nibbles),
+                _mm512_shuffle_epi8(rows_hi, low_nibbles)
+            );
+            const __m512i bits = _mm512_shuffle_epi8(nibble_bits, high_nibbles);
+            mask = _mm512_mask_test_epi8_mask(load_mask, rows, bits);
+        }
+    }
+    return mask;
+}
+
+__attribute__((target("sse2")))
+static size_t count_char_sse2(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char letter
+)
+{
+    const __m128i pattern = _mm_set1_epi8(letter);
+    size_t count = 0;
+    size_t idx = start;
+    while (end - idx >= 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*> (&(data[idx])));
+        const unsigned int mask = static_cast<unsigned int> (_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+        count += static_cast<size_t> (__builtin_popcount(mask));
+        idx += 16;
+    }
+    return count + count_char_scalar(data, idx, end, letter);
+}
+
+__attribute__((target("avx2,popcnt")))
+static size_t count_char_avx2(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char letter
+)
+{
+    const __m256i pattern = _mm256_set1_epi8(letter);
+    size_t count = 0;
+    size_t idx = start;
+    // Unrolled main loop, two vectors per iteration
+    while (end - idx >= 64)
+    {
+        const __m256i block_lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(data[idx])));
+        const __m256i block_hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(data[idx + 32])));
+        const uint64_t mask =
+            static_cast<uint64_t> (static_cast<uint32_t> (_mm256_movemask_epi8(_mm256_cmpeq_epi8(block_lo, pattern)))) |
+            (static_cast<uint64_t> (static_cast<uint32_t> (_mm256_movemask_epi8(_mm256_cmpeq_epi8(block_hi, pattern)))) << 32);
+        count += static_cast<size_t> (__builtin_popcountll(mask));
+        idx += 64;
+    }
+    return count + count_char_sse2(data, idx, end, letter);
+}
+
+__attribute__((target("avx512f,avx512bw,popcnt")))
+static size_t count_char_avx512(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char letter
+)
+{
+    const __m512i pattern = _mm512_set1_epi8(letter);
+    size_t count = 0;
+    size_t idx = start;
+    while (end - idx >= 64)
+    {
+        const uint64_t mask = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(&(data[idx])), pattern);
+        count += static_cast<size_t> (__builtin_popcountll(mask));
+        idx += 64;
+    }
+    if (idx < end)
+    {
+        const __mmask64 load_mask = (~static_cast<uint64_t> (0)) >> (64 - (end - idx));
+        const __m512i block = _mm512_maskz_loadu_epi8(load_mask, &(data[idx]));
+        const uint64_t mask = _mm512_mask_cmpeq_epi8_mask(load_mask, block, pattern);
+        count += static_cast<size_t> (__builtin_popcountll(mask));
+    }
+    return count;
+}
+
+// The backward kernels scan blocks from the end of the range towards its start, and pass the
+// remaining head of the range to the kernel of the next smaller vector width
+__attribute__((target("sse2")))
+static size_t find_last_char_sse2(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char letter
+)
+{
+    const __m128i pattern = _mm_set1_epi8(letter);
+    size_t idx = end;
+    while (idx - start >= 16)
+    {
+        idx -= 16;
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*> (&(data[idx])));
+        const unsigned int mask = static_cast<unsigned int> (_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+        if (mask != 0)
+        {
+            return idx + 31 - static_cast<size_t> (__builtin_clz(mask));
+        }
+    }
+    const size_t head_idx = find_last_char_scalar(data, start, idx, letter);
+    return head_idx < idx ? head_idx : end;
+}
+
+__attribute__((target("avx2")))
+static size_t find_last_char_avx2(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char letter
+)
+{
+    const __m256i pattern = _mm256_set1_epi8(letter);
+    size_t idx = end;
+    // Unrolled main loop, two vectors per iteration
+    while (idx - start >= 64)
+    {
+        idx -= 64;
+        const __m256i block_lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(data[idx])));
+        const __m256i block_hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(data[idx + 32])));
+        const __m256i cmp_lo = _mm256_cmpeq_epi8(block_lo, pattern);
+        const __m256i cmp_hi = _mm256_cmpeq_epi8(block_hi, pattern);
+        if (!_mm256_testz_si256(_mm256_or_si256(cmp_lo, cmp_hi), _mm256_or_si256(cmp_lo, cmp_hi)))
+        {
+            const uint64_t mask =
+                static_cast<uint64_t> (static_cast<uint32_t> (_mm256_movemask_epi8(cmp_lo))) |
+                (static_cast<uint64_t> (static_cast<uint32_t> (_mm256_movemask_epi8(cmp_hi))) << 32);
+            return idx + 63 - static_cast<size_t> (__builtin_clzll(mask));
+        }
+    }
+    while (idx - start >= 32)
+    {
+        idx -= 32;
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(data[idx])));
+        const uint32_t mask = static_cast<uint32_t> (_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)));
+        if (mask != 0)
+        {
+            return idx + 31 - static_cast<size_t> (__builtin_clz(mask));
+        }
+    }
+    const size_t head_idx = find_last_char_sse2(data, start, idx, letter);
+    return head_idx < idx ? head_idx : end;
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static size_t find_last_char_avx512(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char letter
+)
+{
+    const __m512i pattern = _mm512_set1_epi8(letter);
+    size_t idx = end;
+    while (idx - start >= 64)
+    {
+        idx -= 64;
+        const uint64_t mask = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(&(data[idx])), pattern);
+        if (mask != 0)
+        {
+            return idx + 63 - static_cast<size_t> (__builtin_clzll(mask));
+        }
+    }
+    if (idx > start)
+    {
+        // Masked load of the head, bytes outside of the mask are not accessed
+        const __mmask64 load_mask = (~static_cast<uint64_t> (0)) >> (64 - (idx - start));
+        const __m512i block = _mm512_maskz_loadu_epi8(load_mask, &(data[start]));
+        const uint64_t mask = _mm512_mask_cmpeq_epi8_mask(load_mask, block, pattern);
+        if (mask != 0)
+        {
+            return start + 63 - static_cast<size_t> (__builtin_clzll(mask));
+        }
+    }
+    return end;
+}
+
+__attribute__((target("sse2")))
+static size_t find_last_substring_sse2(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length
+)
+{
+    if (end - start < pat_length)
+    {
+        return end;
+    }
+    const size_t last_offset = pat_length - 1;
+    const __m128i first_char = _mm_set1_epi8(pattern[0]);
+    const __m128i last_char = _mm_set1_epi8(pattern[last_offset]);
+    // One past the last candidate position, each iteration tests the 16 candidates before idx
+    size_t idx = end - pat_length + 1;
+    while (idx - start >= 16)
+    {
+        idx -= 16;
+        const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*> (&(data[idx])));
+        const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*> (&(data[idx + last_offset])));
+        unsigned int mask = static_cast<unsigned int> (
+            _mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(block_first, first_char), _mm_cmpeq_epi8(block_last, last_char))
+            )
+        );
+        while (mask != 0)
+        {
+            const unsigned int bit_idx = 31 - static_cast<unsigned int> (__builtin_clz(mask));
+            const size_t candidate = idx + bit_idx;
+            if (std::memcmp(&(data[candidate + 1]), &(pattern[1]), pat_length - 2) == 0)
+            {
+                return candidate;
+            }
+            mask &= ~(1U << bit_idx);
+        }
+    }
+    const size_t head_end = idx + last_offset;
+    const size_t head_idx = find_last_substring_scalar(data, start, head_end, pattern, pat_length);
+    return head_idx < head_end ? head_idx : end;
+}
+
+__attribute__((target("avx2")))
+static size_t find_last_substring_avx2(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length
+)
+{
+    if (end - start < pat_length)
+    {
+        return end;
+    }
+    const size_t last_offset = pat_length - 1;
+    const __m256i first_char = _mm256_set1_epi8(pattern[0]);
+    const __m256i last_char = _mm256_set1_epi8(pattern[last_offset]);
+    size_t idx = end - pat_length + 1;
+    while (idx - start >= 32)
+    {
+        idx -= 32;
+        const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(data[idx])));
+        const __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(data[idx + last_offset])));
+        uint32_t mask = static_cast<uint32_t> (
+            _mm256_movemask_epi8(
+                _mm256_and_si256(
+                    _mm256_cmpeq_epi8(block_first, first_char),
+                    _mm256_cmpeq_epi8(block_last, last_char)
+                )
+            )
+        );
+        while (mask != 0)
+        {
+            const unsigned int bit_idx = 31 - static_cast<unsigned int> (__builtin_clz(mask));
+            const size_t candidate = idx + bit_idx;
+            if (std::memcmp(&(data[candidate + 1]), &(pattern[1]), pat_length - 2) == 0)
+            {
+                return candidate;
+            }
+            mask &= ~(static_cast<uint32_t> (1) << bit_idx);
+        }
+    }
+    const size_t head_end = idx + last_offset;
+    const size_t head_idx = find_last_substring_sse2(data, start, head_end, pattern, pat_length);
+    return head_idx < head_end ? head_idx : end;
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static size_t find_last_substring_avx512(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length
+)
+{
+    if (end - start < pat_length)
+    {
+        return end;
+    }
+    const size_t last_offset = pat_length - 1;
+    const __m512i first_char = _mm512_set1_epi8(pattern[0]);
+    const __m512i last_char = _mm512_set1_epi8(pattern[last_offset]);
+    size_t idx = end - pat_length + 1;
+    while (idx - start >= 64)
+    {
+        idx -= 64;
+        const __m512i block_first = _mm512_loadu_si512(&(data[idx]));
+        const __m512i block_last = _mm512_loadu_si512(&(data[idx + last_offset]));
+        uint64_t mask = _mm512_mask_cmpeq_epi8_mask(
+            _mm512_cmpeq_epi8_mask(block_first, first_char),
+            block_last,
+            last_char
+        );
+        while (mask != 0)
+        {
+            const unsigned int bit_idx = 63 - static_cast<unsigned int> (__builtin_clzll(mask));
+            const size_t candidate = idx + bit_idx;
+            if (std::memcmp(&(data[candidate + 1]), &(pattern[1]), pat_length - 2) == 0)
+            {
+                return candidate;
+            }
+            mask &= ~(static_cast<uint64_t> (1) << bit_idx);
+        }
+    }
+    const size_t head_end = idx + last_offset;
+    const size_t head_idx = find_last_substring_avx2(data, start, head_end, pattern, pat_length);
+    return head_idx < head_end ? head_idx : end;
+}
+
+// The case folding kernels subtract the first letter of the range, so that a single comparison
+// classifies each character: SSE2 and AVX2 only compare signed bytes, therefore the difference is
+// additionally offset by -128 there
+__attribute__((target("sse2")))
+inline static __m128i case_mask_sse2(const __m128i block, const __m128i range_offset) noexcept
+{
+    const __m128i in_range = _mm_cmplt_epi8(
+        _mm_add_epi8(block, range_offset),
+        _mm_set1_epi8(static_cast<char> (-128 + LETTER_COUNT))
+    );
+    return _mm_and_si128(in_range, _mm_set1_epi8(CASE_BIT));
+}
+
+__attribute__((target("avx2")))
+inline static __m256i case_mask_avx2(const __m256i block, const __m256i range_offset) noexcept
+{
+    const __m256i in_range = _mm256_cmpgt_epi8(
+        _mm256_set1_epi8(static_cast<char> (-128 + LETTER_COUNT)),
+        _mm256_add_epi8(block, range_offset)
+    );
+    return _mm256_and_si256(in_range, _mm256_set1_epi8(CASE_BIT));
+}
+
+__attribute__((target("avx512f,avx512bw")))
+inline static __m512i case_mask_avx512(const __m512i block, const __m512i range_first) noexcept
+{
+    const __mmask64 in_range = _mm512_cmplt_epu8_mask(
+        _mm512_sub_epi8(block, range_first),
+        _mm512_set1_epi8(LETTER_COUNT)
+    );
+    return _mm512_maskz_mov_epi8(in_range, _mm512_set1_epi8(CASE_BIT));
+}
+
+__attribute__((target("sse2")))
+static void change_case_sse2(char* const data, const size_t length, const char range_first)
+{
+    const __m128i range_offset = _mm_set1_epi8(static_cast<char> (-128 - range_first));
+    size_t idx = 0;
+    while (length - idx >= 16)
+    {
+        __m128i* const block_ptr = reinterpret_cast<__m128i*> (&(data[idx]));
+        const __m128i block = _mm_loadu_si128(block_ptr);
+        _mm_storeu_si128(block_ptr, _mm_xor_si128(block, case_mask_sse2(block, range_offset)));
+        idx += 16;
+    }
+    change_case_scalar(&(data[idx]), length - idx, range_first);
+}
+
+__attribute__((target("avx2")))
+static void change_case_avx2(char* const data, const size_t length, const char range_first)
+{
+    const __m256i range_offset = _mm256_set1_epi8(static_cast<char> (-128 - range_first));
+    size_t idx = 0;
+    while (length - idx >= 32)
+    {
+        __m256i* const block_ptr = reinterpret_cast<__m256i*> (&(data[idx]));
+        const __m256i block = _mm256_loadu_si256(block_ptr);
+        _mm256_storeu_si256(block_ptr, _mm256_xor_si256(block, case_mask_avx2(block, range_offset)));
+        idx += 32;
+    }
+    change_case_sse2(&(data[idx]), length - idx, range_first);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void change_case_avx512(char* const data, const size_t length, const char range_first)
+{
+    const __m512i first = _mm512_set1_epi8(range_first);
+    size_t idx = 0;
+    while (length - idx >= 64)
+    {
+        const __m512i block = _mm512_loadu_si512(&(data[idx]));
+        _mm512_storeu_si512(&(data[idx]), _mm512_xor_si512(block, case_mask_avx512(block, first)));
+        idx += 64;
+    }
+    if (idx < length)
+    {
+        // Masked load and store of the tail, bytes outside of the mask are not accessed
+        const __mmask64 load_mask = (~static_cast<uint64_t> (0)) >> (64 - (length - idx));
+        const __m512i block = _mm512_maskz_loadu_epi8(load_mask, &(data[idx]));
+        _mm512_mask_storeu_epi8(&(data[idx]), load_mask, _mm512_xor_si512(block, case_mask_avx512(block, first)));
+    }
+}
+
+__attribute__((target("sse2")))
+static size_t find_mismatch_icase_sse2(
+    const char* const data,
+    const char* const other_data,
+    const size_t length
+)
+{
+    const __m128i range_offset = _mm_set1_epi8(static_cast<char> (-128 - 'A'));
+    size_t idx = 0;
+    while (length - idx >= 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*> (&(data[idx])));
+        const __m128i other_block = _mm_loadu_si128(reinterpret_cast<const __m128i*> (&(other_data[idx])));
+        const __m128i lower_block = _mm_or_si128(block, case_mask_sse2(block, range_offset));
+        const __m128i lower_other = _mm_or_si128(other_block, case_mask_sse2(other_block, range_offset));
+        const unsigned int mask = static_cast<unsigned int> (_mm_movemask_epi8(_mm_cmpeq_epi8(lower_block, lower_other)));
+        if (mask != 0xFFFF)
+        {
+            return idx + static_cast<size_t> (__builtin_ctz(~mask));
+        }
+        idx += 16;
+    }
+    return idx + find_mismatch_icase_scalar(&(data[idx]), &(other_data[idx]), length - idx);
+}
+
+__attribute__((target("avx2")))
+static size_t find_mismatch_icase_avx2(
+    const char* const data,
+    const char* const other_data,
+    const size_t length
+)
+{
+    const __m256i range_offset = _mm256_set1_epi8(static_cast<char> (-128 - 'A'));
+    size_t idx = 0;
+    while (length - idx >= 32)
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(data[idx])));
+        const __m256i other_block = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(other_data[idx])));
+        const __m256i lower_block = _mm256_or_si256(block, case_mask_avx2(block, range_offset));
+        const __m256i lower_other = _mm256_or_si256(other_block, case_mask_avx2(other_block, range_offset));
+        const uint32_t mask = static_cast<uint32_t> (_mm256_movemask_epi8(_mm256_cmpeq_epi8(lower_block, lower_other)));
+        if (mask != 0xFFFFFFFF)
+        {
+            return idx + static_cast<size_t> (__builtin_ctz(~mask));
+        }
+        idx += 32;
+    }
+    return idx + find_mismatch_icase_sse2(&(data[idx]), &(other_data[idx]), length - idx);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static size_t find_mismatch_icase_avx512(
+    const char* const data,
+    const char* const other_data,
+    const size_t length
+)
+{
+    const __m512i first = _mm512_set1_epi8('A');
+    size_t idx = 0;
+    while (length - idx >= 64)
+    {
+        const __m512i block = _mm512_loadu_si512(&(data[idx]));
+        const __m512i other_block = _mm512_loadu_si512(&(other_data[idx]));
+        const uint64_t mask = _mm512_cmpneq_epi8_mask(
+            _mm512_or_si512(block, case_mask_avx512(block, first)),
+            _mm512_or_si512(other_block, case_mask_avx512(other_block, first))
+        );
+        if (mask != 0)
+        {
+            return idx + static_cast<size_t> (__builtin_ctzll(mask));
+        }
+        idx += 64;
+    }
+    if (idx < length)
+    {
+        const __mmask64 load_mask = (~static_cast<uint64_t> (0)) >> (64 - (length - idx));
+        const __m512i block = _mm512_maskz_loadu_epi8(load_mask, &(data[idx]));
+        const __m512i other_block = _mm512_maskz_loadu_epi8(load_mask, &(other_data[idx]));
+        const uint64_t mask = _mm512_mask_cmpneq_epi8_mask(
+            load_mask,
+            _mm512_or_si512(block, case_mask_avx512(block, first)),
+            _mm512_or_si512(other_block, case_mask_avx512(other_block, first))
+        );
+        if (mask != 0)
+        {
+            return idx + static_cast<size_t> (__builtin_ctzll(mask));
+        }
+        idx = length;
+    }
+    return idx;
+}
+
+__attribute__((target("sse2")))
+static size_t find_substring_icase_sse2(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length
+)
+{
+    if (end - start < pat_length)
+    {
+        return end;
+    }
+    const size_t last_offset = pat_length - 1;
+    const size_t end_offset = end - pat_length;
+    const __m128i range_offset = _mm_set1_epi8(static_cast<char> (-128 - 'A'));
+    const __m128i first_char = _mm_set1_epi8(fold_lower(pattern[0]));
+    const __m128i last_char = _mm_set1_epi8(fold_lower(pattern[last_offset]));
+    size_t idx = start;
+    while (idx + 15 <= end_offset)
+    {
+        const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*> (&(data[idx])));
+        const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*> (&(data[idx + last_offset])));
+        const __m128i lower_first = _mm_or_si128(block_first, case_mask_sse2(block_first, range_offset));
+        const __m128i lower_last = _mm_or_si128(block_last, case_mask_sse2(block_last, range_offset));
+        unsigned int mask = static_cast<unsigned int> (
+            _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(lower_first, first_char), _mm_cmpeq_epi8(lower_last, last_char)))
+        );
+        while (mask != 0)
+        {
+            const size_t candidate = idx + static_cast<size_t> (__builtin_ctz(mask));
+            if (find_mismatch_icase_sse2(&(data[candidate]), pattern, pat_length) == pat_length)
+            {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+        idx += 16;
+    }
+    return find_substring_icase_scalar(data, idx, end, pattern, pat_length);
+}
+
+__attribute__((target("avx2")))
+static size_t find_substring_icase_avx2(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length
+)
+{
+    if (end - start < pat_length)
+    {
+        return end;
+    }
+    const size_t last_offset = pat_length - 1;
+    const size_t end_offset = end - pat_length;
+    const __m256i range_offset = _mm256_set1_epi8(static_cast<char> (-128 - 'A'));
+    const __m256i first_char = _mm256_set1_epi8(fold_lower(pattern[0]));
+    const __m256i last_char = _mm256_set1_epi8(fold_lower(pattern[last_offset]));
+    size_t idx = start;
+    while (idx + 31 <= end_offset)
+    {
+        const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(data[idx])));
+        const __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (&(data[idx + last_offset])));
+        const __m256i lower_first = _mm256_or_si256(block_first, case_mask_avx2(block_first, range_offset));
+        const __m256i lower_last = _mm256_or_si256(block_last, case_mask_avx2(block_last, range_offset));
+        uint32_t mask = static_cast<uint32_t> (
+            _mm256_movemask_epi8(
+                _mm256_and_si256(_mm256_cmpeq_epi8(lower_first, first_char), _mm256_cmpeq_epi8(lower_last, last_char))
+            )
+        );
+        while (mask != 0)
+        {
+            const size_t candidate = idx + static_cast<size_t> (__builtin_ctz(mask));
+            if (find_mismatch_icase_avx2(&(data[candidate]), pattern, pat_length) == pat_length)
+            {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+        idx += 32;
+    }
+    return find_substring_icase_sse2(data, idx, end, pattern, pat_length);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static size_t find_substring_icase_avx512(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length
+)
+{
+    if (end - start < pat_length)
+    {
+        return end;
+    }
+    const size_t last_offset = pat_length - 1;
+    const size_t end_offset = end - pat_length;
+    const __m512i first = _mm512_set1_epi8('A');
+    const __m512i first_char = _mm512_set1_epi8(fold_lower(pattern[0]));
+    const __m512i last_char = _mm512_set1_epi8(fold_lower(pattern[last_offset]));
+    size_t idx = start;
+    while (idx + 63 <= end_offset)
+    {
+        const __m512i block_first = _mm512_loadu_si512(&(data[idx]));
+        const __m512i block_last = _mm512_loadu_si512(&(data[idx + last_offset]));
+        uint64_t mask = _mm512_mask_cmpeq_epi8_mask(
+            _mm512_cmpeq_epi8_mask(_mm512_or_si512(block_first, case_mask_avx512(block_first, first)), first_char),
+            _mm512_or_si512(block_last, case_mask_avx512(block_last, first)),
+            last_char
+        );
+        while (mask != 0)
+        {
+            const size_t candidate = idx + static_cast<size_t> (__builtin_ctzll(mask));
+            if (find_mismatch_icase_avx512(&(data[candidate]), pattern, pat_length) == pat_length)
+            {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+        idx += 64;
+    }
+    return find_substring_icase_avx2(data, idx, end, pattern, pat_length);
+}
+#endif
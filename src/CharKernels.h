@@ -0,0 +1,121 @@
+#ifndef CHARKERNELS_H
+#define CHARKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Low-level scanning kernels used by CharBuffer
+// The kernel set that matches the capabilities of the CPU (scalar, SSE2, AVX2, AVX-512)
+// is selected once, when any of the kernels is used for the first time, see also select_isa().
+class CharKernels
+{
+  public:
+    // Number of characters classified by one match_set() call
+    static const size_t MATCH_BLOCK_LENGTH = 64;
+
+    CharKernels() = delete;
+
+    // Returns the index of the first occurrence of letter in data[start, end),
+    // or end if there is no such occurrence
+    static size_t find_char(const char* data, size_t start, size_t end, char letter) noexcept;
+
+    // Returns the index of the last occurrence of letter in data[start, end),
+    // or end if there is no such occurrence
+    static size_t find_last_char(const char* data, size_t start, size_t end, char letter) noexcept;
+
+    // Returns the number of occurrences of letter in data[start, end)
+    static size_t count_char(const char* data, size_t start, size_t end, char letter) noexcept;
+
+    // Returns the index of the first occurrence of pattern that starts at or after start and
+    // ends at or before end, or end if there is no such occurrence
+    // Candidate positions are filtered by comparing the first and the last character of the
+    // pattern, which makes this kernel suitable for short patterns (pat_length >= 2)
+    static size_t find_substring(
+        const char* data,
+        size_t start,
+        size_t end,
+        const char* pattern,
+        size_t pat_length
+    ) noexcept;
+
+    // Returns the index of the last occurrence of pattern that starts at or after start and
+    // ends at or before end, or end if there is no such occurrence (pat_length >= 2)
+    static size_t find_last_substring(
+        const char* data,
+        size_t start,
+        size_t end,
+        const char* pattern,
+        size_t pat_length
+    ) noexcept;
+
+    // Returns the index of the first position where data[0, length) and other_data[0, length) differ,
+    // or length if both ranges are equal
+    static size_t find_mismatch(const char* data, const char* other_data, size_t length) noexcept;
+
+    // Compares data[0, length) with other_data[0, other_length) and returns -1, 0 or 1, with the same
+    // ordering as CharBuffer::compare_to()
+    static int compare(const char* data, size_t length, const char* other_data, size_t other_length) noexcept;
+
+    // ASCII case folding: converts the letters 'A' to 'Z', or 'a' to 'z', in data[0, length) in place,
+    // all other characters are left unchanged
+    // A character is classified by adding an offset that maps its letter range to the lowest values
+    // of a signed byte and comparing the sum against the length of the range, and converted by
+    // toggling bit 0x20 of the characters in range.
+    static void to_lower(char* data, size_t length) noexcept;
+    static void to_upper(char* data, size_t length) noexcept;
+
+    // Same as find_mismatch(), but ASCII letters compare equal to their other case
+    static size_t find_mismatch_icase(const char* data, const char* other_data, size_t length) noexcept;
+
+    // Same as find_substring(), but ASCII letters match their other case (pat_length >= 1)
+    // The first and the last character of each candidate are compared after folding the data
+    // to lowercase in registers, the remaining characters are compared with find_mismatch_icase().
+    static size_t find_substring_icase(
+        const char* data,
+        size_t start,
+        size_t end,
+        const char* pattern,
+        size_t pat_length
+    ) noexcept;
+
+    // Returns the index of the first null character in data[0, max_length), or max_length if there is none
+    // The vectorized kernels read aligned blocks, which may extend before data and beyond the terminator,
+    // but never into a page that does not contain any of the characters of the string
+    static size_t find_terminator(const char* data, size_t max_length) noexcept;
+
+    // Returns the length of the null-terminated text, scanning at most max_length + 1 characters
+    // @throws RangeException if text is longer than max_length characters
+    static size_t bounded_c_str_length(const char* text, size_t max_length);
+
+    // Set of characters prepared for match_set()
+    struct CharSet
+    {
+        // Bit (high_nibble & 7) of nibble_rows_lo[low_nibble] for high nibbles 0 to 7, or of
+        // nibble_rows_hi[low_nibble] for high nibbles 8 to 15, is set for each member
+        uint8_t nibble_rows_lo[16];
+        uint8_t nibble_rows_hi[16];
+        uint64_t bitmap[4];
+        // Number of distinct members, and the member with the lowest value
+        size_t count;
+        char first;
+    };
+
+    static void prepare_set(const char* members, size_t count, CharSet& set) noexcept;
+
+    // Returns a mask that has bit i set if data[i] is a member of set, for i < min(length, 64)
+    // A single call classifies up to 64 characters, so that a caller that processes the matches one
+    // by one needs only one call per 64 characters, no matter how many of them match.
+    static uint64_t match_set(const char* data, size_t length, const CharSet& set) noexcept;
+
+    // Name of the instruction set extension used by the selected kernels
+    static const char* isa_name() noexcept;
+
+    // Selects the kernels for the named instruction set extension ("scalar", "sse2", "avx2" or
+    // "avx512") instead of the ones chosen by CPU feature detection, and returns true, or returns
+    // false if the name is unknown or the CPU does not support the extension
+    // Intended for tests and benchmarks that compare the kernel sets. The selection applies to all
+    // threads; kernel calls that are running at the time complete with the previous kernels.
+    static bool select_isa(const char* isa_name) noexcept;
+};
+
+#endif /* CHARKERNELS_H */
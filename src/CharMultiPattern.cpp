@@ -0,0 +1,258 @@
+#include <CharMultiPattern.h>
+
+#include <CharBuffer.h>
+#include <CharKernels.h>
+#include <RangeException.h>
+
+static const uint32_t NO_STATE = ~static_cast<uint32_t> (0);
+
+// @throws std::bad_alloc
+CharMultiPattern::CharMultiPattern(const std::vector<const CharBuffer*>& patterns)
+{
+    std::vector<const char*> pat_data;
+    pat_data.reserve(patterns.size());
+    pat_lengths.reserve(patterns.size());
+    for (const CharBuffer* const pattern : patterns)
+    {
+        pat_data.push_back(pattern->c_str());
+        pat_lengths.push_back(pattern->length());
+    }
+    build(pat_data);
+}
+
+// @throws std::bad_alloc, RangeException
+CharMultiPattern::CharMultiPattern(const std::vector<const char*>& patterns)
+{
+    pat_lengths.reserve(patterns.size());
+    for (const char* const pattern : patterns)
+    {
+        pat_lengths.push_back(CharKernels::bounded_c_str_length(pattern, CharBuffer::MAX_CAPACITY));
+    }
+    build(patterns);
+}
+
+CharMultiPattern::~CharMultiPattern() noexcept
+{
+}
+
+size_t CharMultiPattern::pattern_count() const noexcept
+{
+    return pat_lengths.size();
+}
+
+size_t CharMultiPattern::state_count() const noexcept
+{
+    return match_flags.size();
+}
+
+// @throws std::bad_alloc
+void CharMultiPattern::build(const std::vector<const char*>& pat_data)
+{
+    // Assign a class to each byte that occurs in any of the patterns
+    bool byte_used[256] = {};
+    max_pat_length = 0;
+    for (size_t pat_idx = 0; pat_idx < pat_data.size(); ++pat_idx)
+    {
+        const unsigned char* const pattern = reinterpret_cast<const unsigned char*> (pat_data[pat_idx]);
+        for (size_t idx = 0; idx < pat_lengths[pat_idx]; ++idx)
+        {
+            byte_used[pattern[idx]] = true;
+        }
+        if (pat_lengths[pat_idx] > max_pat_length)
+        {
+            max_pat_length = pat_lengths[pat_idx];
+        }
+    }
+    class_count = 1;
+    for (size_t idx = 0; idx < 256; ++idx)
+    {
+        if (byte_used[idx])
+        {
+            byte_class[idx] = static_cast<uint16_t> (class_count);
+            ++class_count;
+        }
+        else
+        {
+            byte_class[idx] = 0;
+        }
+    }
+
+    // Build the trie
+    std::vector<std::vector<size_t>> state_outputs(1);
+    transitions.assign(class_count, NO_STATE);
+    for (size_t pat_idx = 0; pat_idx < pat_data.size(); ++pat_idx)
+    {
+        const size_t pat_length = pat_lengths[pat_idx];
+        if (pat_length > 0)
+        {
+            const unsigned char* const pattern = reinterpret_cast<const unsigned char*> (pat_data[pat_idx]);
+            size_t state = 0;
+            for (size_t idx = 0; idx < pat_length; ++idx)
+            {
+                const size_t trans_idx = state * class_count + byte_class[pattern[idx]];
+                if (transitions[trans_idx] == NO_STATE)
+                {
+                    const size_t new_state = state_outputs.size();
+                    if (new_state >= NO_STATE)
+                    {
+                        throw std::bad_alloc();
+                    }
+                    transitions[trans_idx] = static_cast<uint32_t> (new_state);
+                    transitions.resize(transitions.size() + class_count, NO_STATE);
+                    state_outputs.emplace_back();
+                }
+                state = transitions[trans_idx];
+            }
+            state_outputs[state].push_back(pat_idx);
+        }
+    }
+
+    const size_t states = state_outputs.size();
+    out_offsets.resize(states + 1);
+    size_t out_count = 0;
+    for (size_t state = 0; state < states; ++state)
+    {
+        out_offsets[state] = static_cast<uint32_t> (out_count);
+        out_count += state_outputs[state].size();
+    }
+    out_offsets[states] = static_cast<uint32_t> (out_count);
+    out_ids.reserve(out_count);
+    for (size_t state = 0; state < states; ++state)
+    {
+        out_ids.insert(out_ids.end(), state_outputs[state].begin(), state_outputs[state].end());
+    }
+
+    // Compute the failure links in breadth-first order and replace missing transitions
+    // by the transitions of the failure state, which turns the trie into a DFA
+    std::vector<uint32_t> fail_links(states, 0);
+    dict_links.assign(states, 0);
+    match_flags.assign(states, 0);
+    std::vector<uint32_t> queue;
+    queue.reserve(states);
+    for (size_t cls = 0; cls < class_count; ++cls)
+    {
+        uint32_t& target = transitions[cls];
+        if (target == NO_STATE)
+        {
+            target = 0;
+        }
+        else
+        {
+            queue.push_back(target);
+        }
+    }
+    for (size_t queue_idx = 0; queue_idx < queue.size(); ++queue_idx)
+    {
+        const uint32_t state = queue[queue_idx];
+        const uint32_t fail_state = fail_links[state];
+        const size_t row = state * class_count;
+        const size_t fail_row = fail_state * class_count;
+        for (size_t cls = 0; cls < class_count; ++cls)
+        {
+            uint32_t& target = transitions[row + cls];
+            if (target == NO_STATE)
+            {
+                target = transitions[fail_row + cls];
+            }
+            else
+            {
+                const uint32_t target_fail = transitions[fail_row + cls];
+                fail_links[target] = target_fail;
+                dict_links[target] = out_offsets[target_fail] != out_offsets[target_fail + 1] ?
+                    target_fail : dict_links[target_fail];
+                queue.push_back(target);
+            }
+        }
+        if (out_offsets[state] != out_offsets[state + 1] || dict_links[state] != 0)
+        {
+            match_flags[state] = 1;
+        }
+    }
+}
+
+size_t CharMultiPattern::find_in(
+    const char* const data,
+    const size_t length,
+    const size_t start,
+    size_t& pattern_id
+) const noexcept
+{
+    size_t index = CharBuffer::NPOS;
+    // Scanning stops as soon as no later match can start before the best match found so far
+    size_t scan_end = length;
+    uint32_t state = 0;
+    for (size_t idx = start; idx < scan_end; ++idx)
+    {
+        state = transitions[state * class_count + byte_class[static_cast<unsigned char> (data[idx])]];
+        if (match_flags[state] != 0)
+        {
+            uint32_t out_state = state;
+            while (out_state != 0)
+            {
+                // All patterns of one state have the same length
+                const uint32_t out_begin = out_offsets[out_state];
+                if (out_begin != out_offsets[out_state + 1])
+                {
+                    const size_t out_id = out_ids[out_begin];
+                    const size_t match_idx = idx + 1 - pat_lengths[out_id];
+                    if (index == CharBuffer::NPOS || match_idx < index)
+                    {
+                        index = match_idx;
+                        pattern_id = out_id;
+                    }
+                }
+                out_state = dict_links[out_state];
+            }
+            if (index + max_pat_length - 1 < scan_end)
+            {
+                scan_end = index + max_pat_length - 1;
+            }
+        }
+    }
+    return index;
+}
+
+// @throws RangeException
+size_t CharMultiPattern::find_in(const CharBuffer& subject, const size_t start, size_t& pattern_id) const
+{
+    if (start > subject.length())
+    {
+        throw RangeException();
+    }
+    return find_in(subject.c_str(), subject.length(), start, pattern_id);
+}
+
+// @throws std::bad_alloc
+void CharMultiPattern::find_all_in(
+    const char* const data,
+    const size_t length,
+    const size_t start,
+    std::vector<Match>& matches
+) const
+{
+    uint32_t state = 0;
+    for (size_t idx = start; idx < length; ++idx)
+    {
+        state = transitions[state * class_count + byte_class[static_cast<unsigned char> (data[idx])]];
+        if (match_flags[state] != 0)
+        {
+            uint32_t out_state = state;
+            while (out_state != 0)
+            {
+                const uint32_t out_end = out_offsets[out_state + 1];
+                for (uint32_t out_idx = out_offsets[out_state]; out_idx < out_end; ++out_idx)
+                {
+                    const size_t out_id = out_ids[out_idx];
+                    matches.push_back(Match {idx + 1 - pat_lengths[out_id], out_id});
+                }
+                out_state = dict_links[out_state];
+            }
+        }
+    }
+}
+
+// @throws std::bad_alloc
+void CharMultiPattern::find_all_in(const CharBuffer& subject, std::vector<Match>& matches) const
+{
+    find_all_in(subject.c_str(), subject.length(), 0, matches);
+}
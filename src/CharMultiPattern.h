@@ -0,0 +1,76 @@
+#ifndef CHARMULTIPATTERN_H
+#define CHARMULTIPATTERN_H
+
+#include <new>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+class CharBuffer;
+
+// Aho-Corasick automaton for searching for many patterns in a single pass
+// The automaton is stored as a dense transition table over byte classes, where each byte that
+// occurs in any of the patterns has a class of its own and all other bytes share one class.
+// Pattern IDs are the indexes of the patterns in the vector the automaton was built from.
+// Empty patterns are ignored.
+class CharMultiPattern
+{
+  public:
+    struct Match
+    {
+        size_t index;
+        size_t pattern_id;
+    };
+
+    // @throws std::bad_alloc
+    explicit CharMultiPattern(const std::vector<const CharBuffer*>& patterns);
+
+    // @throws std::bad_alloc, RangeException
+    explicit CharMultiPattern(const std::vector<const char*>& patterns);
+
+    virtual ~CharMultiPattern() noexcept;
+
+    CharMultiPattern(const CharMultiPattern& orig) = delete;
+    CharMultiPattern& operator=(const CharMultiPattern& orig) = delete;
+    CharMultiPattern(CharMultiPattern&& orig) = default;
+    CharMultiPattern& operator=(CharMultiPattern&& orig) = default;
+
+    virtual size_t pattern_count() const noexcept;
+    virtual size_t state_count() const noexcept;
+
+    // Returns the index of the leftmost match in data[start, length), or CharBuffer::NPOS if there is no match
+    // If multiple patterns match at the same index, the shortest one is reported.
+    // start must not be greater than length
+    virtual size_t find_in(const char* data, size_t length, size_t start, size_t& pattern_id) const noexcept;
+
+    // @throws RangeException
+    virtual size_t find_in(const CharBuffer& subject, size_t start, size_t& pattern_id) const;
+
+    // Appends all matches in data[start, length), including overlapping ones, ordered by their end position
+    // start must not be greater than length
+    // @throws std::bad_alloc
+    virtual void find_all_in(const char* data, size_t length, size_t start, std::vector<Match>& matches) const;
+
+    // @throws std::bad_alloc
+    virtual void find_all_in(const CharBuffer& subject, std::vector<Match>& matches) const;
+
+  private:
+    size_t class_count;
+    size_t max_pat_length;
+    uint16_t byte_class[256];
+    // class_count entries per state, state 0 is the root
+    std::vector<uint32_t> transitions;
+    // Nonzero for states that have own outputs or a dictionary suffix link
+    std::vector<uint8_t> match_flags;
+    // Nearest proper suffix state that has own outputs, 0 if there is none
+    std::vector<uint32_t> dict_links;
+    // The pattern IDs of state n are out_ids[out_offsets[n], out_offsets[n + 1])
+    std::vector<uint32_t> out_offsets;
+    std::vector<size_t> out_ids;
+    std::vector<size_t> pat_lengths;
+
+    // @throws std::bad_alloc
+    void build(const std::vector<const char*>& pat_data);
+};
+
+#endif /* CHARMULTIPATTERN_H */
@@ -0,0 +1,49 @@
+#ifndef CHARNUMBERS_H
+#define CHARNUMBERS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Locale-independent conversions between numbers and character data used by CharBuffer
+// The formatting functions write into caller-provided storage and never allocate memory.
+// The parsing functions accept an optional sign followed by digits; for floating point numbers,
+// an optional fraction, an optional exponent and the words inf and nan are accepted as well.
+// Leading or trailing whitespace is not accepted.
+class CharNumbers
+{
+  public:
+    // Maximum number of characters written by the formatting functions
+    static const size_t MAX_INT_LENGTH = 20;
+    static const size_t MAX_HEX_LENGTH = 16;
+    static const size_t MAX_DOUBLE_LENGTH = 25;
+
+    CharNumbers() = delete;
+
+    // Number of characters of the decimal representation of value
+    static size_t decimal_length(uint64_t value) noexcept;
+
+    // Number of characters of the hexadecimal representation of value
+    static size_t hex_length(uint64_t value) noexcept;
+
+    // Writes the decimal_length(value) digits of value to dst
+    static void write_decimal(uint64_t value, char* dst, size_t length) noexcept;
+
+    // Writes the hex_length(value) lowercase hexadecimal digits of value to dst
+    static void write_hex(uint64_t value, char* dst, size_t length) noexcept;
+
+    // Writes the shortest representation of value that parses to the same value to dst,
+    // and returns the number of characters written
+    // Uses the Grisu2 algorithm, which produces the shortest representation for the vast majority
+    // of values and a representation that is at most one digit longer for the others.
+    static size_t format_double(double value, char* dst) noexcept;
+
+    // Returns false if data[0, length) is not an integer, or if it is out of range
+    static bool parse_int(const char* data, size_t length, long long& value) noexcept;
+
+    // Returns false if data[0, length) is not a number, or if it is out of range
+    // The result is correctly rounded, also for numbers with more significant digits than a double
+    // holds; numbers that are too small for a double give zero.
+    static bool parse_double(const char* data, size_t length, double& value) noexcept;
+};
+
+#endif /* CHARNUMBERS_H */
@@ -0,0 +1,455 @@
+#include <CharPattern.h>
+
+#include <cstring>
+
+#include <CharBuffer.h>
+#include <CharKernels.h>
+
+const size_t CharPattern::SHORT_PATTERN_LENGTH = 32;
+
+// Tables of the Two-Way string matching algorithm (Crochemore & Perrin)
+// combined with a Horspool-style shift table for the last character of the window
+struct CharPattern::SearchTables
+{
+    // Position of the critical factorization
+    size_t crit_pos;
+    // Period of the pattern's right half
+    size_t period;
+    // Length of the prefix that is known to match after a shift by period, 0 for non-periodic patterns
+    size_t memory;
+    // For each character, one past the index of its last occurrence in the pattern, 0 if it does not occur
+    size_t shift[256];
+    // For each character, the smallest index greater than 0 of its occurrences in the pattern,
+    // or the length of the pattern if it does not occur there; used when searching backwards
+    size_t reverse_shift[256];
+};
+
+inline static void prepare_two_way(
+    const char* pattern,
+    size_t pat_length,
+    CharPattern::SearchTables& tables
+);
+
+inline static size_t maximal_suffix(
+    const unsigned char* pattern,
+    size_t pat_length,
+    bool reverse_order,
+    size_t& period
+);
+
+inline static size_t find_two_way(
+    const char* data,
+    size_t length,
+    size_t start,
+    const char* pattern,
+    size_t pat_length,
+    const CharPattern::SearchTables& tables
+);
+
+inline static void prepare_reverse_horspool(
+    const char* pattern,
+    size_t pat_length,
+    CharPattern::SearchTables& tables
+);
+
+inline static size_t rfind_reverse_horspool(
+    const char* data,
+    size_t end,
+    const char* pattern,
+    size_t pat_length,
+    const CharPattern::SearchTables& tables
+);
+
+inline static size_t rfind_impl(
+    const char* data,
+    size_t end,
+    const char* pattern,
+    size_t pat_length,
+    const CharPattern::SearchTables* tables
+);
+
+inline static size_t find_impl(
+    const char* data,
+    size_t length,
+    size_t start,
+    const char* pattern,
+    size_t pat_length,
+    const CharPattern::SearchTables* tables
+);
+
+// @throws std::bad_alloc
+CharPattern::CharPattern(const CharBuffer& text)
+{
+    init(text.c_str(), text.length());
+}
+
+// @throws std::bad_alloc, RangeException
+CharPattern::CharPattern(const char* const text)
+{
+    init(text, CharKernels::bounded_c_str_length(text, CharBuffer::MAX_CAPACITY));
+}
+
+// @throws std::bad_alloc
+CharPattern::CharPattern(const char* const data, const size_t length)
+{
+    init(data, length);
+}
+
+CharPattern::~CharPattern() noexcept
+{
+}
+
+// @throws std::bad_alloc
+inline void CharPattern::init(const char* const data, const size_t length)
+{
+    if (length < CharBuffer::MAX_CAPACITY)
+    {
+        pat_length = length;
+        pattern_mgr = std::unique_ptr<char[]>(new char[pat_length + 1]);
+        std::memcpy(pattern_mgr.get(), data, pat_length);
+        pattern_mgr[pat_length] = '\0';
+
+        if (pat_length > SHORT_PATTERN_LENGTH)
+        {
+            tables = std::unique_ptr<SearchTables>(new SearchTables);
+            prepare_two_way(pattern_mgr.get(), pat_length, *tables);
+            prepare_reverse_horspool(pattern_mgr.get(), pat_length, *tables);
+        }
+    }
+    else
+    {
+        throw std::bad_alloc();
+    }
+}
+
+size_t CharPattern::length() const noexcept
+{
+    return pat_length;
+}
+
+const char* CharPattern::c_str() const noexcept
+{
+    return pattern_mgr.get();
+}
+
+size_t CharPattern::find_in(const char* const data, const size_t length, const size_t start) const noexcept
+{
+    return find_impl(data, length, start, pattern_mgr.get(), pat_length, tables.get());
+}
+
+size_t CharPattern::find(
+    const char* const data,
+    const size_t length,
+    const char* const pattern,
+    const size_t pat_length,
+    const size_t start
+) noexcept
+{
+    return find_impl(data, length, start, pattern, pat_length, nullptr);
+}
+
+size_t CharPattern::rfind_in(const char* const data, const size_t end) const noexcept
+{
+    return rfind_impl(data, end, pattern_mgr.get(), pat_length, tables.get());
+}
+
+size_t CharPattern::rfind(
+    const char* const data,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length
+) noexcept
+{
+    return rfind_impl(data, end, pattern, pat_length, nullptr);
+}
+
+inline static size_t find_impl(
+    const char* const data,
+    const size_t length,
+    const size_t start,
+    const char* const pattern,
+    const size_t pat_length,
+    const CharPattern::SearchTables* const tables
+)
+{
+    size_t index = CharBuffer::NPOS;
+    if (pat_length == 0)
+    {
+        // The empty string always matches at the position where the search started
+        index = start;
+    }
+    else if (length - start >= pat_length)
+    {
+        size_t match_idx = length;
+        if (pat_length == 1)
+        {
+            match_idx = CharKernels::find_char(data, start, length, pattern[0]);
+        }
+        else if (pat_length <= CharPattern::SHORT_PATTERN_LENGTH)
+        {
+            match_idx = CharKernels::find_substring(data, start, length, pattern, pat_length);
+        }
+        else if (tables != nullptr)
+        {
+            match_idx = find_two_way(data, length, start, pattern, pat_length, *tables);
+        }
+        else
+        {
+            CharPattern::SearchTables local_tables;
+            prepare_two_way(pattern, pat_length, local_tables);
+            match_idx = find_two_way(data, length, start, pattern, pat_length, local_tables);
+        }
+        if (match_idx < length)
+        {
+            index = match_idx;
+        }
+    }
+    return index;
+}
+
+inline static size_t rfind_impl(
+    const char* const data,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length,
+    const CharPattern::SearchTables* const tables
+)
+{
+    size_t index = CharBuffer::NPOS;
+    if (pat_length == 0)
+    {
+        // The empty string matches at the end of the searched range
+        index = end;
+    }
+    else if (end >= pat_length)
+    {
+        size_t match_idx = end;
+        if (pat_length == 1)
+        {
+            match_idx = CharKernels::find_last_char(data, 0, end, pattern[0]);
+        }
+        else if (pat_length <= CharPattern::SHORT_PATTERN_LENGTH)
+        {
+            match_idx = CharKernels::find_last_substring(data, 0, end, pattern, pat_length);
+        }
+        else if (tables != nullptr)
+        {
+            match_idx = rfind_reverse_horspool(data, end, pattern, pat_length, *tables);
+        }
+        else
+        {
+            CharPattern::SearchTables local_tables;
+            prepare_reverse_horspool(pattern, pat_length, local_tables);
+            match_idx = rfind_reverse_horspool(data, end, pattern, pat_length, local_tables);
+        }
+        if (match_idx < end)
+        {
+            index = match_idx;
+        }
+    }
+    return index;
+}
+
+inline static void prepare_two_way(
+    const char* const pattern,
+    const size_t pat_length,
+    CharPattern::SearchTables& tables
+)
+{
+    const unsigned char* const pat_bytes = reinterpret_cast<const unsigned char*> (pattern);
+
+    for (size_t idx = 0; idx < 256; ++idx)
+    {
+        tables.shift[idx] = 0;
+    }
+    for (size_t idx = 0; idx < pat_length; ++idx)
+    {
+        tables.shift[pat_bytes[idx]] = idx + 1;
+    }
+
+    // The critical factorization is the later one of the two maximal suffixes
+    // computed with opposite orderings of the alphabet
+    size_t fwd_period = 0;
+    size_t rev_period = 0;
+    const size_t fwd_suffix = maximal_suffix(pat_bytes, pat_length, false, fwd_period);
+    const size_t rev_suffix = maximal_suffix(pat_bytes, pat_length, true, rev_period);
+    if (rev_suffix + 1 > fwd_suffix + 1)
+    {
+        tables.crit_pos = rev_suffix;
+        tables.period = rev_period;
+    }
+    else
+    {
+        tables.crit_pos = fwd_suffix;
+        tables.period = fwd_period;
+    }
+
+    // crit_pos is one less than the length of the left half, and may wrap around to NPOS
+    // if the left half is empty
+    const size_t left_length = tables.crit_pos + 1;
+    if (std::memcmp(pattern, &(pattern[tables.period]), left_length) == 0)
+    {
+        tables.memory = pat_length - tables.period;
+    }
+    else
+    {
+        const size_t right_length = pat_length - left_length;
+        tables.period = (tables.crit_pos > right_length ? tables.crit_pos : right_length) + 1;
+        tables.memory = 0;
+    }
+}
+
+// Returns the start position of the maximal suffix minus one (may wrap around to NPOS),
+// and its period in the period parameter
+inline static size_t maximal_suffix(
+    const unsigned char* const pattern,
+    const size_t pat_length,
+    const bool reverse_order,
+    size_t& period
+)
+{
+    size_t suffix_idx = CharBuffer::NPOS;
+    size_t cand_idx = 0;
+    size_t offset = 1;
+    period = 1;
+    while (cand_idx + offset < pat_length)
+    {
+        const unsigned char suffix_char = pattern[suffix_idx + offset];
+        const unsigned char cand_char = pattern[cand_idx + offset];
+        if (suffix_char == cand_char)
+        {
+            if (offset == period)
+            {
+                cand_idx += period;
+                offset = 1;
+            }
+            else
+            {
+                ++offset;
+            }
+        }
+        else if ((suffix_char > cand_char) != reverse_order)
+        {
+            cand_idx += offset;
+            offset = 1;
+            period = cand_idx - suffix_idx;
+        }
+        else
+        {
+            suffix_idx = cand_idx;
+            ++cand_idx;
+            offset = 1;
+            period = 1;
+        }
+    }
+    return suffix_idx;
+}
+
+inline static size_t find_two_way(
+    const char* const data,
+    const size_t length,
+    const size_t start,
+    const char* const pattern,
+    const size_t pat_length,
+    const CharPattern::SearchTables& tables
+)
+{
+    const unsigned char* const pat_bytes = reinterpret_cast<const unsigned char*> (pattern);
+    const size_t right_start = tables.crit_pos + 1;
+    const size_t last_offset = pat_length - 1;
+    const size_t end_offset = length - pat_length;
+
+    size_t window = start;
+    size_t memory = 0;
+    while (window <= end_offset)
+    {
+        const unsigned char* const window_bytes = reinterpret_cast<const unsigned char*> (&(data[window]));
+
+        // Shift by the distance of the window's last character to its last occurrence in the pattern
+        size_t shift = pat_length - tables.shift[window_bytes[last_offset]];
+        if (shift != 0)
+        {
+            window += (shift < memory ? memory : shift);
+            memory = 0;
+            continue;
+        }
+
+        // Compare the right half
+        size_t cmp_idx = right_start > memory ? right_start : memory;
+        while (cmp_idx < pat_length && pat_bytes[cmp_idx] == window_bytes[cmp_idx])
+        {
+            ++cmp_idx;
+        }
+        if (cmp_idx < pat_length)
+        {
+            window += cmp_idx - tables.crit_pos;
+            memory = 0;
+            continue;
+        }
+
+        // Compare the left half
+        cmp_idx = right_start;
+        while (cmp_idx > memory && pat_bytes[cmp_idx - 1] == window_bytes[cmp_idx - 1])
+        {
+            --cmp_idx;
+        }
+        if (cmp_idx <= memory)
+        {
+            return window;
+        }
+        window += tables.period;
+        memory = tables.memory;
+    }
+    return length;
+}
+
+inline static void prepare_reverse_horspool(
+    const char* const pattern,
+    const size_t pat_length,
+    CharPattern::SearchTables& tables
+)
+{
+    const unsigned char* const pat_bytes = reinterpret_cast<const unsigned char*> (pattern);
+    for (size_t idx = 0; idx < 256; ++idx)
+    {
+        tables.reverse_shift[idx] = pat_length;
+    }
+    // Later indexes are overwritten by earlier ones, index 0 is excluded so that every shift advances
+    for (size_t idx = pat_length - 1; idx > 0; --idx)
+    {
+        tables.reverse_shift[pat_bytes[idx]] = idx;
+    }
+}
+
+// Mirror image of the Horspool algorithm: the window moves from the end of the data towards its
+// start, and is shifted by the distance of the window's first character to its first occurrence
+// in the rest of the pattern
+inline static size_t rfind_reverse_horspool(
+    const char* const data,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length,
+    const CharPattern::SearchTables& tables
+)
+{
+    const unsigned char first_char = static_cast<unsigned char> (pattern[0]);
+    size_t match_idx = end;
+    size_t window = end - pat_length;
+    bool searching = true;
+    while (searching)
+    {
+        const unsigned char window_char = static_cast<unsigned char> (data[window]);
+        if (window_char == first_char && std::memcmp(&(data[window + 1]), &(pattern[1]), pat_length - 1) == 0)
+        {
+            match_idx = window;
+            searching = false;
+        }
+        else
+        {
+            const size_t shift = tables.reverse_shift[window_char];
+            searching = window >= shift;
+            window -= shift;
+        }
+    }
+    return match_idx;
+}
@@ -0,0 +1,76 @@
+#ifndef CHARPATTERN_H
+#define CHARPATTERN_H
+
+#include <new>
+#include <memory>
+
+class CharBuffer;
+
+// Precompiled search pattern
+// Holds a copy of the pattern text and the precomputed tables of the search engine,
+// so that a pattern that is searched for repeatedly is only prepared once.
+class CharPattern
+{
+  public:
+    // Patterns up to this length are searched for using the vectorized first/last character filter,
+    // longer patterns are searched for using the Two-Way algorithm, or the Horspool algorithm
+    // when searching backwards
+    static const size_t SHORT_PATTERN_LENGTH;
+
+    // @throws std::bad_alloc
+    explicit CharPattern(const CharBuffer& text);
+
+    // @throws std::bad_alloc, RangeException
+    explicit CharPattern(const char* text);
+
+    // @throws std::bad_alloc
+    explicit CharPattern(const char* data, size_t length);
+
+    virtual ~CharPattern() noexcept;
+
+    CharPattern(const CharPattern& orig) = delete;
+    CharPattern& operator=(const CharPattern& orig) = delete;
+    CharPattern(CharPattern&& orig) = default;
+    CharPattern& operator=(CharPattern&& orig) = default;
+
+    virtual size_t length() const noexcept;
+    virtual const char* c_str() const noexcept;
+
+    // Returns the index of the first occurrence of the pattern in data[start, length),
+    // or CharBuffer::NPOS if there is no such occurrence
+    // start must not be greater than length
+    virtual size_t find_in(const char* data, size_t length, size_t start) const noexcept;
+
+    // Searches for a pattern that has not been precompiled
+    // Returns the index of the first occurrence of pattern in data[start, length),
+    // or CharBuffer::NPOS if there is no such occurrence
+    // start must not be greater than length
+    static size_t find(
+        const char* data,
+        size_t length,
+        const char* pattern,
+        size_t pat_length,
+        size_t start
+    ) noexcept;
+
+    // Returns the index of the last occurrence of the pattern that lies entirely within data[0, end),
+    // or CharBuffer::NPOS if there is no such occurrence
+    virtual size_t rfind_in(const char* data, size_t end) const noexcept;
+
+    // Searches backwards for a pattern that has not been precompiled
+    // Returns the index of the last occurrence of pattern that lies entirely within data[0, end),
+    // or CharBuffer::NPOS if there is no such occurrence
+    static size_t rfind(const char* data, size_t end, const char* pattern, size_t pat_length) noexcept;
+
+    struct SearchTables;
+
+  private:
+    size_t pat_length;
+    std::unique_ptr<char[]> pattern_mgr;
+    std::unique_ptr<SearchTables> tables;
+
+    // @throws std::bad_alloc
+    inline void init(const char* data, size_t length);
+};
+
+#endif /* CHARPATTERN_H */
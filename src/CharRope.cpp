@@ -0,0 +1,541 @@
+#include <CharRope.h>
+
+#include <cstdint>
+
+#include <RangeException.h>
+
+const size_t CharRope::CHUNK_CAPACITY = 64 * 1024 - 64;
+
+// Texts of at least this length are stored in a chunk of their own
+static const size_t DEDICATED_CHUNK_LENGTH = 4 * 1024;
+
+// Immutable tree node that refers to the piece data[0, length) of a chunk
+struct CharRope::Node
+{
+    std::shared_ptr<const Node> left;
+    std::shared_ptr<const Node> right;
+    std::shared_ptr<const CharBuffer> chunk;
+    const char* data;
+    size_t length;
+    // Length and piece count of the subtree rooted at this node
+    size_t subtree_length;
+    size_t subtree_pieces;
+};
+
+typedef std::shared_ptr<const CharRope::Node> NodePtr;
+
+inline static uint32_t next_random() noexcept;
+
+// @throws std::bad_alloc
+inline static NodePtr make_node(
+    const CharRope::Node& piece,
+    const char* data,
+    size_t length,
+    const NodePtr& left,
+    const NodePtr& right
+);
+
+// @throws std::bad_alloc
+inline static NodePtr make_piece(const std::shared_ptr<const CharBuffer>& chunk, const char* data, size_t length);
+
+inline static size_t subtree_length(const NodePtr& node) noexcept;
+inline static size_t subtree_pieces(const NodePtr& node) noexcept;
+
+// @throws std::bad_alloc
+static NodePtr merge(const NodePtr& left, const NodePtr& right);
+
+// @throws std::bad_alloc
+static void split(const NodePtr& node, size_t index, NodePtr& left, NodePtr& right);
+
+static void visit(const NodePtr& node, const std::function<void(const CharBufferView& piece)>& consumer);
+
+CharRope::CharRope() noexcept:
+    tail_start(0)
+{
+}
+
+// @throws std::bad_alloc
+CharRope::CharRope(const CharBuffer& text):
+    tail_start(0)
+{
+    append_raw(text.c_str(), text.length());
+}
+
+// @throws std::bad_alloc, RangeException
+CharRope::CharRope(const char* const text):
+    tail_start(0)
+{
+    const CharBufferView text_view(text);
+    append_raw(text_view.data(), text_view.length());
+}
+
+CharRope::~CharRope() noexcept
+{
+}
+
+// The copy shares the tree and the chunks, but not the tail chunk
+// @throws std::bad_alloc
+CharRope::CharRope(const CharRope& orig):
+    root(orig.full_tree()),
+    tail_start(0)
+{
+}
+
+CharRope::CharRope(CharRope&& orig) noexcept:
+    root(std::move(orig.root)),
+    tail_chunk(std::move(orig.tail_chunk)),
+    tail_start(orig.tail_start)
+{
+    orig.tail_start = 0;
+}
+
+// @throws std::bad_alloc
+CharRope& CharRope::operator=(const CharRope& orig)
+{
+    if (this != &orig)
+    {
+        root = orig.full_tree();
+        tail_chunk.reset();
+        tail_start = 0;
+    }
+    return *this;
+}
+
+CharRope& CharRope::operator=(CharRope&& orig) noexcept
+{
+    if (this != &orig)
+    {
+        root = std::move(orig.root);
+        tail_chunk = std::move(orig.tail_chunk);
+        tail_start = orig.tail_start;
+        orig.tail_start = 0;
+    }
+    return *this;
+}
+
+// @throws std::bad_alloc
+void CharRope::operator+=(const CharBuffer& other)
+{
+    append_raw(other.c_str(), other.length());
+}
+
+// @throws std::bad_alloc, RangeException
+void CharRope::operator+=(const char* const text)
+{
+    const CharBufferView text_view(text);
+    append_raw(text_view.data(), text_view.length());
+}
+
+// @throws std::bad_alloc
+void CharRope::operator+=(const char in_char)
+{
+    append_raw(&in_char, 1);
+}
+
+// @throws RangeException
+char CharRope::operator[](const size_t index) const
+{
+    size_t offset = index;
+    const char* location = nullptr;
+    const size_t tree_length = subtree_length(root);
+    if (offset < tree_length)
+    {
+        const Node* node = root.get();
+        while (location == nullptr)
+        {
+            const size_t left_length = subtree_length(node->left);
+            if (offset < left_length)
+            {
+                node = node->left.get();
+            }
+            else if (offset - left_length < node->length)
+            {
+                location = &(node->data[offset - left_length]);
+            }
+            else
+            {
+                offset -= left_length + node->length;
+                node = node->right.get();
+            }
+        }
+    }
+    else
+    {
+        offset -= tree_length;
+        if (offset >= pending_length())
+        {
+            throw RangeException();
+        }
+        location = &(tail_chunk->c_str()[tail_start + offset]);
+    }
+    return *location;
+}
+
+bool CharRope::is_empty() const noexcept
+{
+    return length() == 0;
+}
+
+size_t CharRope::length() const noexcept
+{
+    return subtree_length(root) + pending_length();
+}
+
+size_t CharRope::piece_count() const noexcept
+{
+    return subtree_pieces(root) + (pending_length() > 0 ? 1 : 0);
+}
+
+void CharRope::clear() noexcept
+{
+    root.reset();
+    if (tail_chunk != nullptr)
+    {
+        tail_start = tail_chunk->length();
+    }
+}
+
+// @throws std::bad_alloc
+void CharRope::append(const CharRope& other)
+{
+    NodePtr other_tree = other.full_tree();
+    flush();
+    root = merge(root, other_tree);
+}
+
+// @throws std::bad_alloc
+void CharRope::append(const CharBuffer& text)
+{
+    append_raw(text.c_str(), text.length());
+}
+
+// @throws std::bad_alloc
+void CharRope::append(const CharBufferView& text)
+{
+    append_raw(text.data(), text.length());
+}
+
+// @throws std::bad_alloc
+void CharRope::append_raw(const char* const data, const size_t length)
+{
+    if (length >= DEDICATED_CHUNK_LENGTH)
+    {
+        flush();
+        root = merge(root, store(data, length));
+    }
+    else if (length > 0)
+    {
+        if (tail_chunk == nullptr || length > tail_chunk->capacity() - tail_chunk->length())
+        {
+            flush();
+            tail_chunk = std::make_shared<CharBuffer>(CHUNK_CAPACITY);
+            tail_start = 0;
+        }
+        // Extends the pending tail, which is added to the tree as a single piece
+        tail_chunk->append_raw(data, length);
+    }
+}
+
+// @throws std::bad_alloc, RangeException
+void CharRope::insert(const size_t index, const CharRope& other)
+{
+    if (index > length())
+    {
+        throw RangeException();
+    }
+    NodePtr other_tree = other.full_tree();
+    flush();
+    NodePtr prefix;
+    NodePtr suffix;
+    split(root, index, prefix, suffix);
+    root = merge(merge(prefix, other_tree), suffix);
+}
+
+// @throws std::bad_alloc, RangeException
+void CharRope::insert(const size_t index, const CharBuffer& text)
+{
+    insert_raw(index, text.c_str(), text.length());
+}
+
+// @throws std::bad_alloc, RangeException
+void CharRope::insert(const size_t index, const char* const text)
+{
+    const CharBufferView text_view(text);
+    insert_raw(index, text_view.data(), text_view.length());
+}
+
+// @throws std::bad_alloc, RangeException
+void CharRope::insert_raw(const size_t index, const char* const data, const size_t length)
+{
+    if (index > this->length())
+    {
+        throw RangeException();
+    }
+    if (length > 0)
+    {
+        flush();
+        NodePtr piece = store(data, length);
+        NodePtr prefix;
+        NodePtr suffix;
+        split(root, index, prefix, suffix);
+        root = merge(merge(prefix, piece), suffix);
+    }
+}
+
+// @throws std::bad_alloc, RangeException
+void CharRope::erase(const size_t start, const size_t end)
+{
+    if (start > end || end > length())
+    {
+        throw RangeException();
+    }
+    if (start < end)
+    {
+        flush();
+        NodePtr prefix;
+        NodePtr rest;
+        NodePtr erased;
+        NodePtr suffix;
+        split(root, end, rest, suffix);
+        split(rest, start, prefix, erased);
+        root = merge(prefix, suffix);
+    }
+}
+
+// @throws std::bad_alloc, RangeException
+CharRope CharRope::slice(const size_t start, const size_t end) const
+{
+    if (start > end || end > length())
+    {
+        throw RangeException();
+    }
+    NodePtr rest;
+    NodePtr suffix;
+    NodePtr prefix;
+    CharRope result;
+    split(full_tree(), end, rest, suffix);
+    split(rest, start, prefix, result.root);
+    return result;
+}
+
+// @throws std::bad_alloc, RangeException
+void CharRope::append_to(CharBuffer& target) const
+{
+    const size_t content_length = length();
+    if (content_length > target.capacity() - target.length())
+    {
+        if (!target.is_growable())
+        {
+            throw RangeException();
+        }
+        target.reserve(target.length() + content_length);
+    }
+    for_each_piece(
+        [&target](const CharBufferView& piece)
+        {
+            target.append_raw(piece.data(), piece.length());
+        }
+    );
+}
+
+// @throws std::bad_alloc
+std::unique_ptr<CharBuffer> CharRope::flatten() const
+{
+    std::unique_ptr<CharBuffer> result(new CharBuffer(length()));
+    append_to(*result);
+    return result;
+}
+
+void CharRope::for_each_piece(const std::function<void(const CharBufferView& piece)>& consumer) const
+{
+    visit(root, consumer);
+    const size_t tail_length = pending_length();
+    if (tail_length > 0)
+    {
+        consumer(CharBufferView(&(tail_chunk->c_str()[tail_start]), tail_length));
+    }
+}
+
+// Adds the pending tail to the tree
+// @throws std::bad_alloc
+inline void CharRope::flush()
+{
+    const size_t tail_length = pending_length();
+    if (tail_length > 0)
+    {
+        root = merge(root, make_piece(tail_chunk, &(tail_chunk->c_str()[tail_start]), tail_length));
+        tail_start = tail_chunk->length();
+    }
+}
+
+// @throws std::bad_alloc
+inline NodePtr CharRope::store(const char* const data, const size_t length)
+{
+    NodePtr piece;
+    if (length >= DEDICATED_CHUNK_LENGTH)
+    {
+        std::shared_ptr<CharBuffer> chunk = std::make_shared<CharBuffer>(length);
+        chunk->append_raw(data, length);
+        piece = make_piece(chunk, chunk->c_str(), length);
+    }
+    else
+    {
+        if (tail_chunk == nullptr || length > tail_chunk->capacity() - tail_chunk->length())
+        {
+            tail_chunk = std::make_shared<CharBuffer>(CHUNK_CAPACITY);
+        }
+        const size_t offset = tail_chunk->length();
+        tail_chunk->append_raw(data, length);
+        tail_start = tail_chunk->length();
+        piece = make_piece(tail_chunk, &(tail_chunk->c_str()[offset]), length);
+    }
+    return piece;
+}
+
+// @throws std::bad_alloc
+inline NodePtr CharRope::full_tree() const
+{
+    NodePtr tree = root;
+    const size_t tail_length = pending_length();
+    if (tail_length > 0)
+    {
+        tree = merge(tree, make_piece(tail_chunk, &(tail_chunk->c_str()[tail_start]), tail_length));
+    }
+    return tree;
+}
+
+inline size_t CharRope::pending_length() const noexcept
+{
+    return tail_chunk != nullptr ? tail_chunk->length() - tail_start : 0;
+}
+
+// Thread-local xorshift generator for the merge decisions
+inline static uint32_t next_random() noexcept
+{
+    static thread_local uint32_t state = 0x9E3779B9U;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// @throws std::bad_alloc
+inline static NodePtr make_node(
+    const CharRope::Node& piece,
+    const char* const data,
+    const size_t length,
+    const NodePtr& left,
+    const NodePtr& right
+)
+{
+    std::shared_ptr<CharRope::Node> node = std::make_shared<CharRope::Node>();
+    node->left = left;
+    node->right = right;
+    node->chunk = piece.chunk;
+    node->data = data;
+    node->length = length;
+    node->subtree_length = subtree_length(left) + length + subtree_length(right);
+    node->subtree_pieces = subtree_pieces(left) + 1 + subtree_pieces(right);
+    return node;
+}
+
+// @throws std::bad_alloc
+inline static NodePtr make_piece(
+    const std::shared_ptr<const CharBuffer>& chunk,
+    const char* const data,
+    const size_t length
+)
+{
+    std::shared_ptr<CharRope::Node> node = std::make_shared<CharRope::Node>();
+    node->chunk = chunk;
+    node->data = data;
+    node->length = length;
+    node->subtree_length = length;
+    node->subtree_pieces = 1;
+    return node;
+}
+
+inline static size_t subtree_length(const NodePtr& node) noexcept
+{
+    return node != nullptr ? node->subtree_length : 0;
+}
+
+inline static size_t subtree_pieces(const NodePtr& node) noexcept
+{
+    return node != nullptr ? node->subtree_pieces : 0;
+}
+
+// Concatenates two trees, the nodes on the merge path are copied
+// The root is taken from either tree with a probability proportional to its number of pieces,
+// which keeps the expected depth logarithmic. Unlike fixed treap priorities, this also holds if
+// the same subtree occurs several times, as after appending a rope to itself.
+// @throws std::bad_alloc
+static NodePtr merge(const NodePtr& left, const NodePtr& right)
+{
+    NodePtr result;
+    if (left == nullptr)
+    {
+        result = right;
+    }
+    else if (right == nullptr)
+    {
+        result = left;
+    }
+    else if (next_random() % (left->subtree_pieces + right->subtree_pieces) < left->subtree_pieces)
+    {
+        result = make_node(*left, left->data, left->length, left->left, merge(left->right, right));
+    }
+    else
+    {
+        result = make_node(*right, right->data, right->length, merge(left, right->left), right->right);
+    }
+    return result;
+}
+
+// Splits a tree into the content before index and the content from index onwards
+// A piece that contains index is divided into two pieces that refer to the same chunk
+// @throws std::bad_alloc
+static void split(const NodePtr& node, const size_t index, NodePtr& left, NodePtr& right)
+{
+    if (node == nullptr)
+    {
+        left.reset();
+        right.reset();
+    }
+    else
+    {
+        const size_t left_length = subtree_length(node->left);
+        if (index <= left_length)
+        {
+            NodePtr sub_right;
+            split(node->left, index, left, sub_right);
+            right = make_node(*node, node->data, node->length, sub_right, node->right);
+        }
+        else if (index >= left_length + node->length)
+        {
+            NodePtr sub_left;
+            split(node->right, index - left_length - node->length, sub_left, right);
+            left = make_node(*node, node->data, node->length, node->left, sub_left);
+        }
+        else
+        {
+            const size_t piece_offset = index - left_length;
+            NodePtr node_left = node->left;
+            NodePtr node_right = node->right;
+            left = make_node(*node, node->data, piece_offset, node_left, NodePtr());
+            right = make_node(
+                *node, &(node->data[piece_offset]), node->length - piece_offset, NodePtr(), node_right
+            );
+        }
+    }
+}
+
+static void visit(const NodePtr& node, const std::function<void(const CharBufferView& piece)>& consumer)
+{
+    if (node != nullptr)
+    {
+        visit(node->left, consumer);
+        consumer(CharBufferView(node->data, node->length));
+        visit(node->right, consumer);
+    }
+}
@@ -0,0 +1,132 @@
+#ifndef CHARROPE_H
+#define CHARROPE_H
+
+#include <new>
+#include <memory>
+#include <functional>
+
+#include <CharBuffer.h>
+#include <CharBufferView.h>
+
+// Rope of character data for building and editing very large texts
+// The content is a sequence of pieces, each of which refers to a range of an immutable chunk.
+// Pieces are kept in a persistent randomized tree that is merged by subtree sizes, so that insert,
+// erase and slice take expected O(log n) time in the number of pieces, independent of the length
+// of the content.
+// Copies and slices share the tree and the chunks with the original.
+// Short texts are copied into a common chunk of CHUNK_CAPACITY characters, and consecutive
+// appends are coalesced into a single piece.
+// Not thread-safe for modification, but distinct ropes that share data may be used by different threads.
+class CharRope
+{
+  public:
+    static const size_t CHUNK_CAPACITY;
+
+    CharRope() noexcept;
+
+    // @throws std::bad_alloc
+    explicit CharRope(const CharBuffer& text);
+
+    // @throws std::bad_alloc, RangeException
+    explicit CharRope(const char* text);
+
+    virtual ~CharRope() noexcept;
+
+    // @throws std::bad_alloc
+    CharRope(const CharRope& orig);
+    CharRope(CharRope&& orig) noexcept;
+
+    // @throws std::bad_alloc
+    CharRope& operator=(const CharRope& orig);
+    CharRope& operator=(CharRope&& orig) noexcept;
+
+    // @throws std::bad_alloc
+    virtual void operator+=(const CharBuffer& other);
+
+    // @throws std::bad_alloc, RangeException
+    virtual void operator+=(const char* text);
+
+    // @throws std::bad_alloc
+    virtual void operator+=(char in_char);
+
+    // @throws RangeException
+    virtual char operator[](size_t index) const;
+
+    virtual bool is_empty() const noexcept;
+    virtual size_t length() const noexcept;
+
+    // Number of pieces that the content consists of
+    virtual size_t piece_count() const noexcept;
+
+    virtual void clear() noexcept;
+
+    // @throws std::bad_alloc
+    virtual void append(const CharRope& other);
+
+    // @throws std::bad_alloc
+    virtual void append(const CharBuffer& text);
+
+    // @throws std::bad_alloc
+    virtual void append(const CharBufferView& text);
+
+    // @throws std::bad_alloc
+    virtual void append_raw(const char* data, size_t length);
+
+    // @throws std::bad_alloc, RangeException
+    virtual void insert(size_t index, const CharRope& other);
+
+    // @throws std::bad_alloc, RangeException
+    virtual void insert(size_t index, const CharBuffer& text);
+
+    // @throws std::bad_alloc, RangeException
+    virtual void insert(size_t index, const char* text);
+
+    // @throws std::bad_alloc, RangeException
+    virtual void insert_raw(size_t index, const char* data, size_t length);
+
+    // Removes the range [start, end)
+    // @throws std::bad_alloc, RangeException
+    virtual void erase(size_t start, size_t end);
+
+    // Returns a rope with the content of the range [start, end)
+    // @throws std::bad_alloc, RangeException
+    virtual CharRope slice(size_t start, size_t end) const;
+
+    // Appends the content to the target buffer
+    // @throws std::bad_alloc, RangeException
+    virtual void append_to(CharBuffer& target) const;
+
+    // Returns a buffer with the content and a capacity of the content's length
+    // @throws std::bad_alloc
+    virtual std::unique_ptr<CharBuffer> flatten() const;
+
+    // Calls the consumer with a view of each piece, in order
+    // The views are valid for as long as this rope is not modified.
+    virtual void for_each_piece(const std::function<void(const CharBufferView& piece)>& consumer) const;
+
+    struct Node;
+
+  private:
+    std::shared_ptr<const Node> root;
+    // Chunk that receives copied text, the range [tail_start, tail_chunk->length()) is appended
+    // content that has not been added to the tree yet
+    // Only the rope that holds a chunk as its tail chunk writes to it, and only beyond its length.
+    std::shared_ptr<CharBuffer> tail_chunk;
+    size_t tail_start;
+
+    // @throws std::bad_alloc
+    inline void flush();
+
+    // Copies data into the tail chunk, or into a chunk of its own if it is long,
+    // and returns the tree of a single piece that refers to the copy
+    // @throws std::bad_alloc
+    inline std::shared_ptr<const Node> store(const char* data, size_t length);
+
+    // Returns the tree including the pending tail
+    // @throws std::bad_alloc
+    inline std::shared_ptr<const Node> full_tree() const;
+
+    inline size_t pending_length() const noexcept;
+};
+
+#endif /* CHARROPE_H */
@@ -0,0 +1,188 @@
+#include <CharSplitter.h>
+
+#include <CharBuffer.h>
+#include <CharPattern.h>
+#include <RangeException.h>
+
+CharSplitter::CharSplitter(const CharBufferView& text, const char delimiter) noexcept:
+    text_data(text.data()),
+    text_length(text.length()),
+    position(0),
+    finished(false),
+    skip_empty(false),
+    separator(nullptr),
+    block_start(0),
+    block_end(0),
+    block_mask(0)
+{
+    CharKernels::prepare_set(&delimiter, 1, delimiters);
+}
+
+// @throws RangeException
+CharSplitter::CharSplitter(const CharBufferView& text, const char* const delimiter_set, const size_t set_length):
+    text_data(text.data()),
+    text_length(text.length()),
+    position(0),
+    finished(false),
+    skip_empty(false),
+    separator(nullptr),
+    block_start(0),
+    block_end(0),
+    block_mask(0)
+{
+    if (set_length == 0)
+    {
+        throw RangeException();
+    }
+    CharKernels::prepare_set(delimiter_set, set_length, delimiters);
+}
+
+// @throws RangeException
+CharSplitter::CharSplitter(const CharBufferView& text, const CharPattern& separator_pattern):
+    text_data(text.data()),
+    text_length(text.length()),
+    position(0),
+    finished(false),
+    skip_empty(false),
+    separator(&separator_pattern),
+    block_start(0),
+    block_end(0),
+    block_mask(0)
+{
+    if (separator_pattern.length() == 0)
+    {
+        throw RangeException();
+    }
+    CharKernels::prepare_set(nullptr, 0, delimiters);
+}
+
+CharSplitter::~CharSplitter() noexcept
+{
+}
+
+void CharSplitter::set_skip_empty(const bool skip) noexcept
+{
+    skip_empty = skip;
+}
+
+bool CharSplitter::is_skip_empty() const noexcept
+{
+    return skip_empty;
+}
+
+bool CharSplitter::next(CharBufferView& field) noexcept
+{
+    bool have_field = false;
+    while (!have_field && !finished)
+    {
+        const size_t field_start = position;
+        const size_t field_end = next_separator();
+        if (field_end < text_length)
+        {
+            position = field_end + (separator != nullptr ? separator->length() : 1);
+        }
+        else
+        {
+            finished = true;
+        }
+        if (!skip_empty || field_end > field_start)
+        {
+            field = CharBufferView(text_data + field_start, field_end - field_start);
+            have_field = true;
+        }
+    }
+    return have_field;
+}
+
+void CharSplitter::reset() noexcept
+{
+    position = 0;
+    finished = false;
+    block_start = 0;
+    block_end = 0;
+    block_mask = 0;
+}
+
+CharSplitter::Iterator CharSplitter::begin() noexcept
+{
+    return Iterator(*this);
+}
+
+CharSplitter::Iterator CharSplitter::end() noexcept
+{
+    return Iterator();
+}
+
+inline size_t CharSplitter::next_separator() noexcept
+{
+    size_t separator_start = text_length;
+    if (separator != nullptr)
+    {
+        const size_t match_start = separator->find_in(text_data, text_length, position);
+        if (match_start != CharBuffer::NPOS)
+        {
+            separator_start = match_start;
+        }
+    }
+    else
+    {
+        // Each block is classified once, the delimiters within it are then taken from the mask
+        // in ascending order. Since every field starts after the previous delimiter, the mask
+        // never contains delimiters before position.
+        while (block_mask == 0 && block_end < text_length)
+        {
+            block_start = block_end;
+            block_mask = CharKernels::match_set(&(text_data[block_start]), text_length - block_start, delimiters);
+            block_end = text_length - block_start < CharKernels::MATCH_BLOCK_LENGTH ?
+                text_length : block_start + CharKernels::MATCH_BLOCK_LENGTH;
+        }
+        if (block_mask != 0)
+        {
+            separator_start = block_start + static_cast<size_t> (__builtin_ctzll(block_mask));
+            block_mask &= block_mask - 1;
+        }
+    }
+    return separator_start;
+}
+
+CharSplitter::Iterator::Iterator() noexcept:
+    splitter(nullptr)
+{
+}
+
+CharSplitter::Iterator::Iterator(CharSplitter& splitter) noexcept:
+    splitter(&splitter)
+{
+    ++(*this);
+}
+
+const CharBufferView& CharSplitter::Iterator::operator*() const noexcept
+{
+    return field;
+}
+
+const CharBufferView* CharSplitter::Iterator::operator->() const noexcept
+{
+    return &field;
+}
+
+CharSplitter::Iterator& CharSplitter::Iterator::operator++() noexcept
+{
+    if (splitter != nullptr && !splitter->next(field))
+    {
+        splitter = nullptr;
+    }
+    return *this;
+}
+
+// Iterators are equal if both are end iterators, or if both refer to the same position of the same splitter
+bool CharSplitter::Iterator::operator==(const Iterator& other) const noexcept
+{
+    return splitter == other.splitter &&
+        (splitter == nullptr || field.data() == other.field.data());
+}
+
+bool CharSplitter::Iterator::operator!=(const Iterator& other) const noexcept
+{
+    return !(*this == other);
+}
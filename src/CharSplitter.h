@@ -0,0 +1,98 @@
+#ifndef CHARSPLITTER_H
+#define CHARSPLITTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include <CharBufferView.h>
+#include <CharKernels.h>
+
+class CharPattern;
+
+// Splits text into fields without copying them
+// The fields are views of the text, which must remain valid and unmodified while the splitter is used.
+// Fields are separated by a single delimiter character, by any character of a set of delimiters,
+// or by a multi-character separator. Like the delimiters, empty fields are reported by default,
+// e.g. splitting ",a,,b" at ',' yields "", "a", "" and "b", and empty text yields one empty field.
+// Delimiter characters are located by classifying blocks of 64 characters at a time, see
+// CharKernels::match_set().
+class CharSplitter
+{
+  public:
+    // Input iterator over the remaining fields
+    class Iterator
+    {
+      public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef CharBufferView value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const CharBufferView* pointer;
+        typedef const CharBufferView& reference;
+
+        // Constructs the end iterator
+        Iterator() noexcept;
+        explicit Iterator(CharSplitter& splitter) noexcept;
+
+        const CharBufferView& operator*() const noexcept;
+        const CharBufferView* operator->() const noexcept;
+        Iterator& operator++() noexcept;
+        bool operator==(const Iterator& other) const noexcept;
+        bool operator!=(const Iterator& other) const noexcept;
+
+      private:
+        CharSplitter* splitter;
+        CharBufferView field;
+    };
+
+    explicit CharSplitter(const CharBufferView& text, char delimiter) noexcept;
+
+    // Each of the set_length characters of delimiter_set is a delimiter
+    // @throws RangeException
+    explicit CharSplitter(const CharBufferView& text, const char* delimiter_set, size_t set_length);
+
+    // The separator must remain valid while the splitter is used
+    // @throws RangeException
+    explicit CharSplitter(const CharBufferView& text, const CharPattern& separator_pattern);
+
+    virtual ~CharSplitter() noexcept;
+
+    CharSplitter(const CharSplitter& orig) = default;
+    CharSplitter& operator=(const CharSplitter& orig) = default;
+    CharSplitter(CharSplitter&& orig) = default;
+    CharSplitter& operator=(CharSplitter&& orig) = default;
+
+    // If enabled, empty fields are not reported
+    virtual void set_skip_empty(bool skip) noexcept;
+    virtual bool is_skip_empty() const noexcept;
+
+    // Stores the next field in field and returns true, or returns false if there are no more fields
+    virtual bool next(CharBufferView& field) noexcept;
+
+    // Restarts splitting at the beginning of the text
+    virtual void reset() noexcept;
+
+    virtual Iterator begin() noexcept;
+    virtual Iterator end() noexcept;
+
+  private:
+    const char* text_data;
+    size_t text_length;
+    size_t position;
+    bool finished;
+    bool skip_empty;
+
+    // Multi-character separator, or nullptr for delimiter characters
+    const CharPattern* separator;
+    CharKernels::CharSet delimiters;
+
+    // Delimiters in the block text_data[block_start, block_end) at or after position
+    size_t block_start;
+    size_t block_end;
+    uint64_t block_mask;
+
+    // Returns the index of the next separator at or after position, or text_length if there is none
+    inline size_t next_separator() noexcept;
+};
+
+#endif /* CHARSPLITTER_H */
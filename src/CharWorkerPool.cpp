@@ -0,0 +1,384 @@
+#include <CharWorkerPool.h>
+
+#include <exception>
+
+#include <CharBuffer.h>
+#include <CharPattern.h>
+
+const size_t CharWorkerPool::MIN_CHUNK_LENGTH = 256 * 1024;
+
+// Number of chunks per thread, more chunks than threads allow for load balancing by stealing
+static const size_t CHUNKS_PER_THREAD = 4;
+
+// Tasks of a single run() call
+struct CharWorkerPool::Batch
+{
+    const std::function<void(size_t index)>* task;
+    std::mutex batch_lock;
+    std::condition_variable done_signal;
+    size_t remaining;
+    std::exception_ptr error;
+};
+
+// @throws std::bad_alloc, std::system_error
+CharWorkerPool::CharWorkerPool(const size_t thread_count):
+    queued_jobs(0),
+    stopping(false)
+{
+    size_t worker_count = thread_count;
+    if (worker_count == 0)
+    {
+        worker_count = std::thread::hardware_concurrency();
+        if (worker_count == 0)
+        {
+            worker_count = 1;
+        }
+    }
+
+    workers.reserve(worker_count);
+    for (size_t idx = 0; idx < worker_count; ++idx)
+    {
+        workers.push_back(std::unique_ptr<Worker>(new Worker));
+    }
+    try
+    {
+        for (size_t idx = 0; idx < worker_count; ++idx)
+        {
+            workers[idx]->thread = std::thread(&CharWorkerPool::worker_loop, this, idx);
+        }
+    }
+    catch (std::exception&)
+    {
+        {
+            std::lock_guard<std::mutex> guard(idle_lock);
+            stopping = true;
+        }
+        idle_signal.notify_all();
+        for (std::unique_ptr<Worker>& worker : workers)
+        {
+            if (worker->thread.joinable())
+            {
+                worker->thread.join();
+            }
+        }
+        throw;
+    }
+}
+
+CharWorkerPool::~CharWorkerPool() noexcept
+{
+    {
+        std::lock_guard<std::mutex> guard(idle_lock);
+        stopping = true;
+    }
+    idle_signal.notify_all();
+    for (std::unique_ptr<Worker>& worker : workers)
+    {
+        worker->thread.join();
+    }
+}
+
+size_t CharWorkerPool::thread_count() const noexcept
+{
+    return workers.size();
+}
+
+// @throws std::bad_alloc, any exception thrown by task
+void CharWorkerPool::run(const size_t task_count, const std::function<void(size_t index)>& task)
+{
+    if (task_count > 0)
+    {
+        Batch batch;
+        batch.task = &task;
+        batch.remaining = task_count;
+
+        // The jobs are counted before they are published, so that a job can never be taken, and the
+        // count decremented, before it has been counted
+        {
+            std::lock_guard<std::mutex> guard(idle_lock);
+            queued_jobs.fetch_add(task_count);
+        }
+
+        // Each worker receives a contiguous range of tasks
+        const size_t worker_count = workers.size();
+        size_t queued_count = 0;
+        try
+        {
+            for (size_t worker_idx = 0; worker_idx < worker_count; ++worker_idx)
+            {
+                const size_t range_start = task_count * worker_idx / worker_count;
+                const size_t range_end = task_count * (worker_idx + 1) / worker_count;
+                Worker& worker = *(workers[worker_idx]);
+                std::lock_guard<std::mutex> guard(worker.queue_lock);
+                for (size_t index = range_start; index < range_end; ++index)
+                {
+                    worker.queue.push_back(Job {&batch, index});
+                    ++queued_count;
+                }
+            }
+        }
+        catch (std::bad_alloc&)
+        {
+            // Tasks that could not be queued are executed by this thread
+            queued_jobs.fetch_sub(task_count - queued_count);
+            for (size_t index = queued_count; index < task_count; ++index)
+            {
+                execute(Job {&batch, index});
+            }
+        }
+        idle_signal.notify_all();
+
+        // Helps with the execution until no more jobs can be taken, then waits for the workers
+        Job job;
+        while (take_job(worker_count, job))
+        {
+            execute(job);
+        }
+        std::unique_lock<std::mutex> batch_guard(batch.batch_lock);
+        batch.done_signal.wait(batch_guard, [&batch] { return batch.remaining == 0; });
+
+        if (batch.error != nullptr)
+        {
+            std::rethrow_exception(batch.error);
+        }
+    }
+}
+
+// @throws std::bad_alloc
+size_t CharWorkerPool::parallel_index_of(const CharBufferView& text, const CharPattern& pattern)
+{
+    const char* const data = text.data();
+    const size_t length = text.length();
+    const size_t pat_length = pattern.length();
+    size_t chunk_count = 0;
+    size_t chunk_length = 0;
+    plan_chunks(length, chunk_count, chunk_length);
+
+    std::atomic<size_t> first_match(CharBuffer::NPOS);
+    if (pat_length == 0)
+    {
+        // The empty pattern matches at the start of the text
+        first_match.store(0);
+    }
+    else
+    {
+        run(
+            chunk_count,
+            [&](const size_t chunk_idx)
+            {
+                const size_t chunk_start = chunk_idx * chunk_length;
+                // Chunks after the first match that has been found so far are skipped
+                if (chunk_start < first_match.load(std::memory_order_relaxed))
+                {
+                    const size_t chunk_end = length - chunk_start > chunk_length ? chunk_start + chunk_length : length;
+                    const size_t scan_end = length - chunk_end > pat_length - 1 ? chunk_end + pat_length - 1 : length;
+                    const size_t index = pattern.find_in(data, scan_end, chunk_start);
+                    if (index != CharBuffer::NPOS)
+                    {
+                        size_t current = first_match.load(std::memory_order_relaxed);
+                        while (index < current && !first_match.compare_exchange_weak(current, index))
+                        {
+                        }
+                    }
+                }
+            }
+        );
+    }
+    return first_match.load();
+}
+
+// @throws std::bad_alloc
+size_t CharWorkerPool::parallel_count_of(const CharBufferView& text, const CharPattern& pattern)
+{
+    const char* const data = text.data();
+    const size_t length = text.length();
+    const size_t pat_length = pattern.length();
+    size_t total = 0;
+    if (pat_length == 0)
+    {
+        // The empty pattern matches at every position, including the end of the text
+        total = length + 1;
+    }
+    else
+    {
+        size_t chunk_count = 0;
+        size_t chunk_length = 0;
+        plan_chunks(length, chunk_count, chunk_length);
+
+        std::atomic<size_t> match_count(0);
+        run(
+            chunk_count,
+            [&](const size_t chunk_idx)
+            {
+                const size_t chunk_start = chunk_idx * chunk_length;
+                const size_t chunk_end = length - chunk_start > chunk_length ? chunk_start + chunk_length : length;
+                const size_t scan_end = length - chunk_end > pat_length - 1 ? chunk_end + pat_length - 1 : length;
+                size_t chunk_matches = 0;
+                size_t index = pattern.find_in(data, scan_end, chunk_start);
+                while (index != CharBuffer::NPOS)
+                {
+                    ++chunk_matches;
+                    index = pattern.find_in(data, scan_end, index + 1);
+                }
+                match_count.fetch_add(chunk_matches, std::memory_order_relaxed);
+            }
+        );
+        total = match_count.load();
+    }
+    return total;
+}
+
+// @throws std::bad_alloc
+void CharWorkerPool::parallel_find_all(
+    const CharBufferView& text,
+    const CharPattern& pattern,
+    std::vector<size_t>& matches
+)
+{
+    const char* const data = text.data();
+    const size_t length = text.length();
+    const size_t pat_length = pattern.length();
+    if (pat_length == 0)
+    {
+        for (size_t index = 0; index <= length; ++index)
+        {
+            matches.push_back(index);
+        }
+    }
+    else
+    {
+        size_t chunk_count = 0;
+        size_t chunk_length = 0;
+        plan_chunks(length, chunk_count, chunk_length);
+
+        std::vector<std::vector<size_t>> chunk_matches(chunk_count);
+        run(
+            chunk_count,
+            [&](const size_t chunk_idx)
+            {
+                const size_t chunk_start = chunk_idx * chunk_length;
+                const size_t chunk_end = length - chunk_start > chunk_length ? chunk_start + chunk_length : length;
+                const size_t scan_end = length - chunk_end > pat_length - 1 ? chunk_end + pat_length - 1 : length;
+                std::vector<size_t>& found = chunk_matches[chunk_idx];
+                size_t index = pattern.find_in(data, scan_end, chunk_start);
+                while (index != CharBuffer::NPOS)
+                {
+                    found.push_back(index);
+                    index = pattern.find_in(data, scan_end, index + 1);
+                }
+            }
+        );
+
+        size_t total = matches.size();
+        for (const std::vector<size_t>& found : chunk_matches)
+        {
+            total += found.size();
+        }
+        matches.reserve(total);
+        for (const std::vector<size_t>& found : chunk_matches)
+        {
+            matches.insert(matches.end(), found.begin(), found.end());
+        }
+    }
+}
+
+void CharWorkerPool::worker_loop(const size_t worker_idx) noexcept
+{
+    bool running = true;
+    while (running)
+    {
+        Job job;
+        if (take_job(worker_idx, job))
+        {
+            execute(job);
+        }
+        else
+        {
+            std::unique_lock<std::mutex> guard(idle_lock);
+            idle_signal.wait(guard, [this] { return stopping || queued_jobs.load() > 0; });
+            running = !stopping || queued_jobs.load() > 0;
+        }
+    }
+}
+
+inline bool CharWorkerPool::take_job(const size_t worker_idx, Job& job) noexcept
+{
+    bool have_job = false;
+    const size_t worker_count = workers.size();
+    if (worker_idx < worker_count)
+    {
+        Worker& worker = *(workers[worker_idx]);
+        std::lock_guard<std::mutex> guard(worker.queue_lock);
+        if (!worker.queue.empty())
+        {
+            job = worker.queue.front();
+            worker.queue.pop_front();
+            have_job = true;
+        }
+    }
+    for (size_t offset = 1; offset <= worker_count && !have_job; ++offset)
+    {
+        Worker& victim = *(workers[(worker_idx + offset) % worker_count]);
+        std::lock_guard<std::mutex> guard(victim.queue_lock);
+        if (!victim.queue.empty())
+        {
+            job = victim.queue.back();
+            victim.queue.pop_back();
+            have_job = true;
+        }
+    }
+    if (have_job)
+    {
+        queued_jobs.fetch_sub(1);
+    }
+    return have_job;
+}
+
+inline void CharWorkerPool::execute(const Job& job) noexcept
+{
+    Batch& batch = *(job.batch);
+    std::exception_ptr error;
+    try
+    {
+        (*(batch.task))(job.index);
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    // The batch may be destroyed by the thread that runs it as soon as the lock is released
+    std::lock_guard<std::mutex> guard(batch.batch_lock);
+    if (error != nullptr && batch.error == nullptr)
+    {
+        batch.error = error;
+    }
+    --batch.remaining;
+    if (batch.remaining == 0)
+    {
+        batch.done_signal.notify_all();
+    }
+}
+
+inline void CharWorkerPool::plan_chunks(
+    const size_t length,
+    size_t& chunk_count,
+    size_t& chunk_length
+) const noexcept
+{
+    const size_t max_chunk_count = workers.size() * CHUNKS_PER_THREAD;
+    chunk_count = length / MIN_CHUNK_LENGTH;
+    if (chunk_count > max_chunk_count)
+    {
+        chunk_count = max_chunk_count;
+    }
+    if (chunk_count == 0)
+    {
+        chunk_count = 1;
+    }
+    chunk_length = length / chunk_count + (length % chunk_count != 0 ? 1 : 0);
+    if (chunk_length == 0)
+    {
+        chunk_length = 1;
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef CHARWORKERPOOL_H
+#define CHARWORKERPOOL_H
+
+#include <new>
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <condition_variable>
+
+#include <CharBufferView.h>
+
+class CharPattern;
+
+// Work-stealing thread pool for searching large texts in parallel
+// Each worker thread has a queue of its own. A batch of tasks is distributed across the queues in
+// contiguous ranges; workers take tasks from the front of their own queue and, once it is empty,
+// steal tasks from the back of other workers' queues. The thread that runs a batch helps to
+// execute its tasks, so that batches may also be run from within a task.
+// The parallel search functions split the text into chunks that overlap by the length of the
+// pattern minus one, so that matches that cross a chunk boundary are found exactly once.
+class CharWorkerPool
+{
+  public:
+    // Texts shorter than this are not split into multiple chunks
+    static const size_t MIN_CHUNK_LENGTH;
+
+    // Starts thread_count worker threads, or one per hardware thread if thread_count is 0
+    // @throws std::bad_alloc, std::system_error
+    explicit CharWorkerPool(size_t thread_count);
+
+    // Waits for the worker threads to finish
+    virtual ~CharWorkerPool() noexcept;
+
+    CharWorkerPool(const CharWorkerPool& orig) = delete;
+    CharWorkerPool& operator=(const CharWorkerPool& orig) = delete;
+    CharWorkerPool(CharWorkerPool&& orig) = delete;
+    CharWorkerPool& operator=(CharWorkerPool&& orig) = delete;
+
+    virtual size_t thread_count() const noexcept;
+
+    // Calls task(index) for each index in [0, task_count) and returns when all calls have finished
+    // If any of the calls throws, the first exception is rethrown after all calls have finished.
+    // @throws std::bad_alloc, any exception thrown by task
+    virtual void run(size_t task_count, const std::function<void(size_t index)>& task);
+
+    // Returns the same result as the serial search, the index of the first occurrence of pattern
+    // in text, or CharBuffer::NPOS if there is none
+    // @throws std::bad_alloc
+    virtual size_t parallel_index_of(const CharBufferView& text, const CharPattern& pattern);
+
+    // Returns the number of occurrences of pattern in text, including overlapping ones
+    // @throws std::bad_alloc
+    virtual size_t parallel_count_of(const CharBufferView& text, const CharPattern& pattern);
+
+    // Appends the indexes of all occurrences of pattern in text, including overlapping ones,
+    // in ascending order
+    // @throws std::bad_alloc
+    virtual void parallel_find_all(
+        const CharBufferView& text,
+        const CharPattern& pattern,
+        std::vector<size_t>& matches
+    );
+
+    struct Batch;
+
+  private:
+    struct Job
+    {
+        Batch* batch;
+        size_t index;
+    };
+
+    struct Worker
+    {
+        std::mutex queue_lock;
+        std::deque<Job> queue;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // Number of jobs in all queues, changes are signaled through idle_signal
+    std::mutex idle_lock;
+    std::condition_variable idle_signal;
+    std::atomic<size_t> queued_jobs;
+    bool stopping;
+
+    void worker_loop(size_t worker_idx) noexcept;
+
+    // Takes a job from the front of the worker's own queue, or steals one from the back of another queue
+    // worker_idx may be workers.size() for threads that are not workers of this pool
+    inline bool take_job(size_t worker_idx, Job& job) noexcept;
+
+    inline static void execute(const Job& job) noexcept;
+
+    // Number of chunks and length of each chunk for searching a text of the specified length
+    inline void plan_chunks(size_t length, size_t& chunk_count, size_t& chunk_length) const noexcept;
+};
+
+#endif /* CHARWORKERPOOL_H */
@@ -0,0 +1,741 @@
+#ifndef FIXEDCHARBUFFER_H
+#define FIXEDCHARBUFFER_H
+
+#include <cstddef>
+
+#include <CharBuffer.h>
+#include <RangeException.h>
+
+// Character buffer with a compile-time capacity of N characters and storage inside the object
+// All operations that do not involve a CharBuffer are constexpr, so constant buffers can be
+// built at compile time. An operation that would exceed the capacity or access characters
+// beyond the length throws RangeException, or fails to compile during constant evaluation.
+template<size_t N>
+class FixedCharBuffer
+{
+  public:
+    static constexpr size_t CAPACITY = N;
+    static constexpr size_t NPOS = ~static_cast<size_t> (0);
+
+    constexpr FixedCharBuffer() noexcept;
+
+    // @throws RangeException
+    constexpr explicit FixedCharBuffer(const char* text);
+
+    // @throws RangeException
+    explicit FixedCharBuffer(const CharBuffer& other);
+
+    constexpr FixedCharBuffer(const FixedCharBuffer& orig) = default;
+    constexpr FixedCharBuffer(FixedCharBuffer&& orig) = default;
+    FixedCharBuffer& operator=(const FixedCharBuffer& orig) = default;
+    FixedCharBuffer& operator=(FixedCharBuffer&& orig) = default;
+
+    // @throws RangeException
+    constexpr FixedCharBuffer& operator=(const char* text);
+
+    template<size_t M>
+    constexpr bool operator==(const FixedCharBuffer<M>& other) const noexcept;
+    constexpr bool operator==(const char* text) const noexcept;
+    template<size_t M>
+    constexpr bool operator!=(const FixedCharBuffer<M>& other) const noexcept;
+    constexpr bool operator!=(const char* text) const noexcept;
+
+    template<size_t M>
+    constexpr bool operator<(const FixedCharBuffer<M>& other) const noexcept;
+    template<size_t M>
+    constexpr bool operator>(const FixedCharBuffer<M>& other) const noexcept;
+    template<size_t M>
+    constexpr bool operator<=(const FixedCharBuffer<M>& other) const noexcept;
+    template<size_t M>
+    constexpr bool operator>=(const FixedCharBuffer<M>& other) const noexcept;
+
+    // @throws RangeException
+    template<size_t M>
+    constexpr void operator+=(const FixedCharBuffer<M>& other);
+
+    // @throws RangeException
+    constexpr void operator+=(const char* text);
+
+    // @throws RangeException
+    constexpr void operator+=(char in_char);
+
+    // @throws RangeException
+    void operator+=(const CharBuffer& other);
+
+    // @throws RangeException
+    constexpr char& operator[](size_t index);
+
+    // @throws RangeException
+    constexpr const char& operator[](size_t index) const;
+
+    constexpr bool is_empty() const noexcept;
+    constexpr size_t length() const noexcept;
+    constexpr size_t capacity() const noexcept;
+    constexpr void clear() noexcept;
+    constexpr void truncate(size_t new_length) noexcept;
+
+    // @throws RangeException
+    constexpr void copy_raw(const char* data, size_t length);
+
+    // @throws RangeException
+    constexpr void substring(size_t start, size_t end);
+
+    // @throws RangeException
+    template<size_t M>
+    constexpr void append(const FixedCharBuffer<M>& other, size_t start, size_t end);
+
+    // @throws RangeException
+    void append(const CharBuffer& other, size_t start, size_t end);
+
+    // @throws RangeException
+    constexpr void append_raw(const char* data, size_t data_length);
+
+    // @throws RangeException
+    template<size_t M>
+    constexpr void overwrite_with(size_t dst_start, const FixedCharBuffer<M>& other);
+
+    // @throws RangeException
+    constexpr void overwrite_with(size_t dst_start, const char* text);
+
+    // @throws RangeException
+    void overwrite_with(size_t dst_start, const CharBuffer& other);
+
+    constexpr void fill(char fill_char) noexcept;
+
+    // @throws RangeException
+    constexpr void fill(char fill_char, size_t target_length);
+
+    template<size_t M>
+    constexpr int compare_to(const FixedCharBuffer<M>& other) const noexcept;
+    constexpr int compare_to(const char* text) const noexcept;
+    int compare_to(const CharBuffer& other) const noexcept;
+
+    template<size_t M>
+    constexpr bool starts_with(const FixedCharBuffer<M>& other) const noexcept;
+    constexpr bool starts_with(const char* text) const noexcept;
+    bool starts_with(const CharBuffer& other) const noexcept;
+
+    template<size_t M>
+    constexpr bool ends_with(const FixedCharBuffer<M>& other) const noexcept;
+    constexpr bool ends_with(const char* text) const noexcept;
+    bool ends_with(const CharBuffer& other) const noexcept;
+
+    constexpr size_t index_of(char letter) const noexcept;
+
+    // @throws RangeException
+    constexpr size_t index_of(char letter, size_t start) const;
+
+    template<size_t M>
+    constexpr size_t index_of(const FixedCharBuffer<M>& other) const noexcept;
+    constexpr size_t index_of(const char* text) const noexcept;
+
+    // @throws RangeException
+    template<size_t M>
+    constexpr size_t index_of(const FixedCharBuffer<M>& other, size_t start) const;
+
+    // @throws RangeException
+    constexpr size_t index_of(const char* text, size_t start) const;
+
+    constexpr const char* c_str() const noexcept;
+
+  private:
+    size_t bfr_length;
+    char buffer[N + 1];
+
+    // Returns the length of text, or N + 1 if text is longer than N characters
+    static constexpr size_t text_length(const char* text) noexcept;
+
+    static constexpr int compare_impl(
+        const char* data,
+        size_t length,
+        const char* other_data,
+        size_t other_length
+    ) noexcept;
+
+    static constexpr bool match_impl(const char* data, const char* other_data, size_t length) noexcept;
+
+    static constexpr size_t index_of_impl(
+        const char* data,
+        size_t length,
+        const char* pattern,
+        size_t pat_length,
+        size_t start
+    ) noexcept;
+
+    // @throws RangeException
+    constexpr void append_impl(const char* data, size_t data_length);
+
+    // @throws RangeException
+    constexpr void overwrite_impl(size_t dst_start, const char* data, size_t data_length);
+};
+
+template<size_t N>
+constexpr size_t FixedCharBuffer<N>::CAPACITY;
+
+template<size_t N>
+constexpr size_t FixedCharBuffer<N>::NPOS;
+
+template<size_t N>
+constexpr FixedCharBuffer<N>::FixedCharBuffer() noexcept:
+    bfr_length(0),
+    buffer {}
+{
+}
+
+// @throws RangeException
+template<size_t N>
+constexpr FixedCharBuffer<N>::FixedCharBuffer(const char* const text):
+    bfr_length(0),
+    buffer {}
+{
+    append_impl(text, text_length(text));
+}
+
+// @throws RangeException
+template<size_t N>
+FixedCharBuffer<N>::FixedCharBuffer(const CharBuffer& other):
+    bfr_length(0),
+    buffer {}
+{
+    append_impl(other.c_str(), other.length());
+}
+
+// @throws RangeException
+template<size_t N>
+constexpr FixedCharBuffer<N>& FixedCharBuffer<N>::operator=(const char* const text)
+{
+    copy_raw(text, text_length(text));
+    return *this;
+}
+
+template<size_t N>
+template<size_t M>
+constexpr bool FixedCharBuffer<N>::operator==(const FixedCharBuffer<M>& other) const noexcept
+{
+    return bfr_length == other.length() && match_impl(buffer, other.c_str(), bfr_length);
+}
+
+template<size_t N>
+constexpr bool FixedCharBuffer<N>::operator==(const char* const text) const noexcept
+{
+    return compare_to(text) == 0;
+}
+
+template<size_t N>
+template<size_t M>
+constexpr bool FixedCharBuffer<N>::operator!=(const FixedCharBuffer<M>& other) const noexcept
+{
+    return !(*this == other);
+}
+
+template<size_t N>
+constexpr bool FixedCharBuffer<N>::operator!=(const char* const text) const noexcept
+{
+    return !(*this == text);
+}
+
+template<size_t N>
+template<size_t M>
+constexpr bool FixedCharBuffer<N>::operator<(const FixedCharBuffer<M>& other) const noexcept
+{
+    return compare_to(other) < 0;
+}
+
+template<size_t N>
+template<size_t M>
+constexpr bool FixedCharBuffer<N>::operator>(const FixedCharBuffer<M>& other) const noexcept
+{
+    return compare_to(other) > 0;
+}
+
+template<size_t N>
+template<size_t M>
+constexpr bool FixedCharBuffer<N>::operator<=(const FixedCharBuffer<M>& other) const noexcept
+{
+    return compare_to(other) <= 0;
+}
+
+template<size_t N>
+template<size_t M>
+constexpr bool FixedCharBuffer<N>::operator>=(const FixedCharBuffer<M>& other) const noexcept
+{
+    return compare_to(other) >= 0;
+}
+
+// @throws RangeException
+template<size_t N>
+template<size_t M>
+constexpr void FixedCharBuffer<N>::operator+=(const FixedCharBuffer<M>& other)
+{
+    append_impl(other.c_str(), other.length());
+}
+
+// @throws RangeException
+template<size_t N>
+constexpr void FixedCharBuffer<N>::operator+=(const char* const text)
+{
+    append_impl(text, text_length(text));
+}
+
+// @throws RangeException
+template<size_t N>
+constexpr void FixedCharBuffer<N>::operator+=(const char in_char)
+{
+    if (bfr_length >= N)
+    {
+        throw RangeException();
+    }
+    buffer[bfr_length] = in_char;
+    ++bfr_length;
+    buffer[bfr_length] = '\0';
+}
+
+// @throws RangeException
+template<size_t N>
+void FixedCharBuffer<N>::operator+=(const CharBuffer& other)
+{
+    append_impl(other.c_str(), other.length());
+}
+
+// @throws RangeException
+template<size_t N>
+constexpr char& FixedCharBuffer<N>::operator[](const size_t index)
+{
+    if (index >= bfr_length)
+    {
+        throw RangeException();
+    }
+    return buffer[index];
+}
+
+// @throws RangeException
+template<size_t N>
+constexpr const char& FixedCharBuffer<N>::operator[](const size_t index) const
+{
+    if (index >= bfr_length)
+    {
+        throw RangeException();
+    }
+    return buffer[index];
+}
+
+template<size_t N>
+constexpr bool FixedCharBuffer<N>::is_empty() const noexcept
+{
+    return bfr_length == 0;
+}
+
+template<size_t N>
+constexpr size_t FixedCharBuffer<N>::length() const noexcept
+{
+    return bfr_length;
+}
+
+template<size_t N>
+constexpr size_t FixedCharBuffer<N>::capacity() const noexcept
+{
+    return N;
+}
+
+template<size_t N>
+constexpr void FixedCharBuffer<N>::clear() noexcept
+{
+    bfr_length = 0;
+    buffer[bfr_length] = '\0';
+}
+
+template<size_t N>
+constexpr void FixedCharBuffer<N>::truncate(const size_t new_length) noexcept
+{
+    if (new_length < bfr_length)
+    {
+        bfr_length = new_length;
+        buffer[bfr_length] = '\0';
+    }
+}
+
+// @throws RangeException
+template<size_t N>
+constexpr void FixedCharBuffer<N>::copy_raw(const char* const data, const size_t length)
+{
+    if (length > N)
+    {
+        throw RangeException();
+    }
+    for (size_t idx = 0; idx < length; ++idx)
+    {
+        buffer[idx] = data[idx];
+    }
+    bfr_length = length;
+    buffer[bfr_length] = '\0';
+}
+
+// @throws RangeException
+template<size_t N>
+constexpr void FixedCharBuffer<N>::substring(const size_t start, const size_t end)
+{
+    if (start > end || end > bfr_length)
+    {
+        throw RangeException();
+    }
+    // Copying forward is safe, because the target never follows the source
+    const size_t new_length = end - start;
+    for (size_t idx = 0; idx < new_length; ++idx)
+    {
+        buffer[idx] = buffer[start + idx];
+    }
+    bfr_length = new_length;
+    buffer[bfr_length] = '\0';
+}
+
+// @throws RangeException
+template<size_t N>
+template<size_t M>
+constexpr void FixedCharBuffer<N>::append(const FixedCharBuffer<M>& other, const size_t start, const size_t end)
+{
+    if (start > end || end > other.length())
+    {
+        throw RangeException();
+    }
+    append_impl(&(other.c_str()[start]), end - start);
+}
+
+// @throws RangeException
+template<size_t N>
+void FixedCharBuffer<N>::append(const CharBuffer& other, const size_t start, const size_t end)
+{
+    if (start > end || end > other.length())
+    {
+        throw RangeException();
+    }
+    append_impl(&(other.c_str()[start]), end - start);
+}
+
+// @throws RangeException
+template<size_t N>
+constexpr void FixedCharBuffer<N>::append_raw(const char* const data, const size_t data_length)
+{
+    append_impl(data, data_length);
+}
+
+// @throws RangeException
+template<size_t N>
+template<size_t M>
+constexpr void FixedCharBuffer<N>::overwrite_with(const size_t dst_start, const FixedCharBuffer<M>& other)
+{
+    overwrite_impl(dst_start, other.c_str(), other.length());
+}
+
+// @throws RangeException
+template<size_t N>
+constexpr void FixedCharBuffer<N>::overwrite_with(const size_t dst_start, const char* const text)
+{
+    overwrite_impl(dst_start, text, text_length(text));
+}
+
+// @throws RangeException
+template<size_t N>
+void FixedCharBuffer<N>::overwrite_with(const size_t dst_start, const CharBuffer& other)
+{
+    overwrite_impl(dst_start, other.c_str(), other.length());
+}
+
+template<size_t N>
+constexpr void FixedCharBuffer<N>::fill(const char fill_char) noexcept
+{
+    for (size_t idx = bfr_length; idx < N; ++idx)
+    {
+        buffer[idx] = fill_char;
+    }
+    bfr_length = N;
+    buffer[bfr_length] = '\0';
+}
+
+// @throws RangeException
+template<size_t N>
+constexpr void FixedCharBuffer<N>::fill(const char fill_char, const size_t target_length)
+{
+    if (target_length > N)
+    {
+        throw RangeException();
+    }
+    for (size_t idx = bfr_length; idx < target_length; ++idx)
+    {
+        buffer[idx] = fill_char;
+    }
+    bfr_length = target_length;
+    buffer[bfr_length] = '\0';
+}
+
+template<size_t N>
+template<size_t M>
+constexpr int FixedCharBuffer<N>::compare_to(const FixedCharBuffer<M>& other) const noexcept
+{
+    return compare_impl(buffer, bfr_length, other.c_str(), other.length());
+}
+
+template<size_t N>
+constexpr int FixedCharBuffer<N>::compare_to(const char* const text) const noexcept
+{
+    return compare_impl(buffer, bfr_length, text, text_length(text));
+}
+
+template<size_t N>
+int FixedCharBuffer<N>::compare_to(const CharBuffer& other) const noexcept
+{
+    return compare_impl(buffer, bfr_length, other.c_str(), other.length());
+}
+
+template<size_t N>
+template<size_t M>
+constexpr bool FixedCharBuffer<N>::starts_with(const FixedCharBuffer<M>& other) const noexcept
+{
+    return bfr_length >= other.length() && match_impl(buffer, other.c_str(), other.length());
+}
+
+template<size_t N>
+constexpr bool FixedCharBuffer<N>::starts_with(const char* const text) const noexcept
+{
+    const size_t other_length = text_length(text);
+    return bfr_length >= other_length && match_impl(buffer, text, other_length);
+}
+
+template<size_t N>
+bool FixedCharBuffer<N>::starts_with(const CharBuffer& other) const noexcept
+{
+    return bfr_length >= other.length() && match_impl(buffer, other.c_str(), other.length());
+}
+
+template<size_t N>
+template<size_t M>
+constexpr bool FixedCharBuffer<N>::ends_with(const FixedCharBuffer<M>& other) const noexcept
+{
+    return bfr_length >= other.length() &&
+        match_impl(&(buffer[bfr_length - other.length()]), other.c_str(), other.length());
+}
+
+template<size_t N>
+constexpr bool FixedCharBuffer<N>::ends_with(const char* const text) const noexcept
+{
+    const size_t other_length = text_length(text);
+    return bfr_length >= other_length && match_impl(&(buffer[bfr_length - other_length]), text, other_length);
+}
+
+template<size_t N>
+bool FixedCharBuffer<N>::ends_with(const CharBuffer& other) const noexcept
+{
+    return bfr_length >= other.length() &&
+        match_impl(&(buffer[bfr_length - other.length()]), other.c_str(), other.length());
+}
+
+template<size_t N>
+constexpr size_t FixedCharBuffer<N>::index_of(const char letter) const noexcept
+{
+    return index_of_impl(buffer, bfr_length, &letter, 1, 0);
+}
+
+// @throws RangeException
+template<size_t N>
+constexpr size_t FixedCharBuffer<N>::index_of(const char letter, const size_t start) const
+{
+    if (start > bfr_length)
+    {
+        throw RangeException();
+    }
+    return index_of_impl(buffer, bfr_length, &letter, 1, start);
+}
+
+template<size_t N>
+template<size_t M>
+constexpr size_t FixedCharBuffer<N>::index_of(const FixedCharBuffer<M>& other) const noexcept
+{
+    return index_of_impl(buffer, bfr_length, other.c_str(), other.length(), 0);
+}
+
+template<size_t N>
+constexpr size_t FixedCharBuffer<N>::index_of(const char* const text) const noexcept
+{
+    return index_of_impl(buffer, bfr_length, text, text_length(text), 0);
+}
+
+// @throws RangeException
+template<size_t N>
+template<size_t M>
+constexpr size_t FixedCharBuffer<N>::index_of(const FixedCharBuffer<M>& other, const size_t start) const
+{
+    if (start > bfr_length)
+    {
+        throw RangeException();
+    }
+    return index_of_impl(buffer, bfr_length, other.c_str(), other.length(), start);
+}
+
+// @throws RangeException
+template<size_t N>
+constexpr size_t FixedCharBuffer<N>::index_of(const char* const text, const size_t start) const
+{
+    if (start > bfr_length)
+    {
+        throw RangeException();
+    }
+    return index_of_impl(buffer, bfr_length, text, text_length(text), start);
+}
+
+template<size_t N>
+constexpr const char* FixedCharBuffer<N>::c_str() const noexcept
+{
+    return buffer;
+}
+
+template<size_t N>
+constexpr size_t FixedCharBuffer<N>::text_length(const char* const text) noexcept
+{
+    // Stops after N + 1 characters, because a longer text does not fit, does not compare equal and
+    // is not contained either, so its exact length does not matter
+    size_t length = 0;
+    while (length <= N && text[length] != '\0')
+    {
+        ++length;
+    }
+    return length;
+}
+
+template<size_t N>
+constexpr int FixedCharBuffer<N>::compare_impl(
+    const char* const data,
+    const size_t length,
+    const char* const other_data,
+    const size_t other_length
+) noexcept
+{
+    const size_t cmp_length = length <= other_length ? length : other_length;
+    for (size_t idx = 0; idx < cmp_length; ++idx)
+    {
+        if (data[idx] != other_data[idx])
+        {
+            return data[idx] < other_data[idx] ? -1 : 1;
+        }
+    }
+    return length == other_length ? 0 : (length < other_length ? -1 : 1);
+}
+
+template<size_t N>
+constexpr bool FixedCharBuffer<N>::match_impl(
+    const char* const data,
+    const char* const other_data,
+    const size_t length
+) noexcept
+{
+    for (size_t idx = 0; idx < length; ++idx)
+    {
+        if (data[idx] != other_data[idx])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<size_t N>
+constexpr size_t FixedCharBuffer<N>::index_of_impl(
+    const char* const data,
+    const size_t length,
+    const char* const pattern,
+    const size_t pat_length,
+    const size_t start
+) noexcept
+{
+    if (pat_length == 0)
+    {
+        return start;
+    }
+    if (length - start >= pat_length)
+    {
+        const size_t end_offset = length - pat_length;
+        for (size_t idx = start; idx <= end_offset; ++idx)
+        {
+            if (data[idx] == pattern[0] && match_impl(&(data[idx + 1]), &(pattern[1]), pat_length - 1))
+            {
+                return idx;
+            }
+        }
+    }
+    return NPOS;
+}
+
+// @throws RangeException
+template<size_t N>
+constexpr void FixedCharBuffer<N>::append_impl(const char* const data, const size_t data_length)
+{
+    if (data_length > N - bfr_length)
+    {
+        throw RangeException();
+    }
+    for (size_t idx = 0; idx < data_length; ++idx)
+    {
+        buffer[bfr_length + idx] = data[idx];
+    }
+    bfr_length += data_length;
+    buffer[bfr_length] = '\0';
+}
+
+// @throws RangeException
+template<size_t N>
+constexpr void FixedCharBuffer<N>::overwrite_impl(
+    const size_t dst_start,
+    const char* const data,
+    const size_t data_length
+)
+{
+    if (dst_start > bfr_length || data_length > N - dst_start)
+    {
+        throw RangeException();
+    }
+    // The source never overlaps the target, unless it is this buffer itself
+    if (data == buffer && dst_start > 0)
+    {
+        for (size_t idx = data_length; idx > 0; --idx)
+        {
+            buffer[dst_start + idx - 1] = data[idx - 1];
+        }
+    }
+    else
+    {
+        for (size_t idx = 0; idx < data_length; ++idx)
+        {
+            buffer[dst_start + idx] = data[idx];
+        }
+    }
+    const size_t new_length = dst_start + data_length;
+    if (new_length > bfr_length)
+    {
+        bfr_length = new_length;
+        buffer[bfr_length] = '\0';
+    }
+}
+
+template<size_t N>
+bool operator==(const FixedCharBuffer<N>& fixed_buffer, const CharBuffer& other) noexcept
+{
+    return fixed_buffer.compare_to(other) == 0;
+}
+
+template<size_t N>
+bool operator==(const CharBuffer& other, const FixedCharBuffer<N>& fixed_buffer) noexcept
+{
+    return fixed_buffer.compare_to(other) == 0;
+}
+
+template<size_t N>
+bool operator!=(const FixedCharBuffer<N>& fixed_buffer, const CharBuffer& other) noexcept
+{
+    return fixed_buffer.compare_to(other) != 0;
+}
+
+template<size_t N>
+bool operator!=(const CharBuffer& other, const FixedCharBuffer<N>& fixed_buffer) noexcept
+{
+    return fixed_buffer.compare_to(other) != 0;
+}
+
+#endif /* FIXEDCHARBUFFER_H */
@@ -0,0 +1,15 @@
+#include "IoException.h"
+
+IoException::IoException(const int error_number):
+    io_errno(error_number)
+{
+}
+
+IoException::~IoException() noexcept
+{
+}
+
+int IoException::error_number() const noexcept
+{
+    return io_errno;
+}
@@ -0,0 +1,25 @@
+#ifndef IOEXCEPTION_H
+#define IOEXCEPTION_H
+
+#include <stdexcept>
+
+// Thrown when an operating system I/O function fails
+// Holds the errno value that was reported by the failed function.
+class IoException : public std::exception
+{
+  public:
+    explicit IoException(int error_number);
+    virtual ~IoException() noexcept;
+
+    IoException(const IoException& orig) = delete;
+    IoException& operator=(const IoException& orig) = delete;
+    IoException(IoException&& orig) = default;
+    IoException& operator=(IoException&& orig) = default;
+
+    virtual int error_number() const noexcept;
+
+  private:
+    int io_errno;
+};
+
+#endif	/* IOEXCEPTION_H */
@@ -0,0 +1,260 @@
+// Checks the state of moved-from buffers, inline storage and allocator handling of BasicCharBuffer,
+// and compares random operation sequences on BasicCharBuffer and CharBuffer against std::string
+
+#include <string>
+#include <random>
+#include <cstring>
+#include <utility>
+
+#include <BasicCharBuffer.h>
+#include <CharAllocator.h>
+#include <CharBuffer.h>
+#include <RangeException.h>
+
+#include "TestSupport.h"
+
+typedef BasicCharBuffer<CheckedBounds, FixedCapacity> FixedBuffer;
+typedef BasicCharBuffer<CheckedBounds, GeometricGrowth> GrowingBuffer;
+typedef BasicCharBuffer<CheckedBounds, FixedCapacity, std::allocator<char>, 15> InlineBuffer;
+
+static std::mt19937 random_engine(20181019);
+
+// Counts the storage that is currently allocated through it
+class CountingAllocator : public CharAllocator
+{
+  public:
+    CountingAllocator():
+        allocated(0)
+    {
+    }
+
+    virtual char* allocate(const size_t size) override
+    {
+        allocated += size;
+        return new char[size];
+    }
+
+    virtual void deallocate(char* const storage, const size_t size) noexcept override
+    {
+        allocated -= size;
+        delete[] storage;
+    }
+
+    size_t allocated;
+};
+
+template<typename Buffer>
+static void check_moved_from(Buffer& moved)
+{
+    CHECK(moved.length() == 0);
+    CHECK(moved.capacity() == 0);
+    CHECK(std::strcmp(moved.c_str(), "") == 0);
+    moved.clear();
+    CHECK(std::strcmp(moved.c_str(), "") == 0);
+    moved = "";
+    CHECK(moved.is_empty());
+    moved.fill('x');
+    CHECK(moved.is_empty());
+    moved.truncate(0);
+    CHECK(moved == "");
+}
+
+static void test_moved_from()
+{
+    FixedBuffer fixed_source("some longer content");
+    FixedBuffer fixed_target(std::move(fixed_source));
+    CHECK(fixed_target == "some longer content");
+    check_moved_from(fixed_source);
+
+    // A buffer with a fixed capacity can be reused after reserving new storage
+    CHECK_THROWS(RangeException, fixed_source = "abc");
+    fixed_source.reserve(8);
+    fixed_source = "abc";
+    CHECK(fixed_source == "abc");
+    fixed_source += "defgh";
+    CHECK(fixed_source == "abcdefgh");
+
+    GrowingBuffer growing_source("content");
+    GrowingBuffer growing_target(std::move(growing_source));
+    check_moved_from(growing_source);
+    growing_source = "reused content";
+    CHECK(growing_source == "reused content");
+
+    // Move assignment releases the storage of the target and leaves the source empty as well
+    growing_target = std::move(growing_source);
+    CHECK(growing_target == "reused content");
+    check_moved_from(growing_source);
+    growing_target = std::move(growing_target);
+    CHECK(growing_target == "reused content");
+
+    InlineBuffer inline_source("short");
+    InlineBuffer inline_target(std::move(inline_source));
+    CHECK(inline_target == "short");
+    check_moved_from(inline_source);
+
+    CharBuffer source("a CharBuffer that does not fit into inline storage");
+    CharBuffer target(std::move(source));
+    CHECK(target == "a CharBuffer that does not fit into inline storage");
+    CHECK(source.capacity() == 0);
+    source.clear();
+    source = "";
+    CHECK(source.is_empty());
+    source.set_growable(true);
+    source += "reused";
+    CHECK(source == "reused");
+}
+
+static void test_inline_storage()
+{
+    InlineBuffer buffer(15);
+    const char* const object_start = reinterpret_cast<const char*> (&buffer);
+    CHECK(buffer.c_str() >= object_start && buffer.c_str() < object_start + sizeof(buffer));
+    buffer = "fifteen letters";
+    CHECK(buffer.length() == 15);
+
+    // Storage moves to the heap and back into the object
+    buffer.reserve(100);
+    CHECK(buffer.c_str() < object_start || buffer.c_str() >= object_start + sizeof(buffer));
+    CHECK(buffer == "fifteen letters");
+    buffer.truncate(4);
+    buffer.shrink_to_fit();
+    CHECK(buffer.capacity() == 4);
+    CHECK(buffer.c_str() >= object_start && buffer.c_str() < object_start + sizeof(buffer));
+    CHECK(buffer == "fift");
+
+    const CharBuffer small(CharBuffer::INLINE_CAPACITY);
+    const char* const small_start = reinterpret_cast<const char*> (&small);
+    CHECK(small.c_str() >= small_start && small.c_str() < small_start + sizeof(small));
+}
+
+static void test_char_allocator()
+{
+    CountingAllocator allocator;
+    {
+        CharBuffer buffer(100, "allocated text", allocator);
+        CHECK(buffer.has_custom_allocator());
+        CHECK(allocator.allocated == 101);
+
+        // Copies use the heap, moves take the storage together with the allocator
+        const CharBuffer copy(buffer);
+        CHECK(!copy.has_custom_allocator());
+        CHECK(copy == "allocated text");
+        CharBuffer moved(std::move(buffer));
+        CHECK(moved.has_custom_allocator());
+        CHECK(allocator.allocated == 101);
+
+        moved.set_growable(true);
+        moved.fill('x', 300);
+        CHECK(moved.length() == 300);
+        CHECK(allocator.allocated == moved.capacity() + 1);
+
+        CharBuffer heap_buffer("heap text that does not fit into inline storage");
+        heap_buffer = std::move(moved);
+        CHECK(heap_buffer.has_custom_allocator());
+        CHECK(heap_buffer.length() == 300);
+        moved = "reused";
+        CHECK(moved == "reused");
+    }
+    CHECK(allocator.allocated == 0);
+
+    // Storage for small capacities is inline, even if there is an allocator
+    const CharBuffer small(10, allocator);
+    CHECK(allocator.allocated == 0);
+}
+
+static void test_growth_policies()
+{
+    FixedBuffer fixed(4, "abcd");
+    CHECK(!fixed.is_growable());
+    CHECK_THROWS(RangeException, fixed += 'e');
+    CHECK(fixed == "abcd");
+
+    GrowingBuffer growing(4, "abcdefgh");
+    CHECK(growing.is_growable());
+    CHECK(growing.capacity() == 8);
+    growing += 'i';
+    CHECK(growing.capacity() == 16);
+
+    CharBuffer buffer(4, "abcd");
+    CHECK_THROWS(RangeException, buffer += 'e');
+    buffer.set_growable(true);
+    buffer += 'e';
+    CHECK(buffer == "abcde");
+    CHECK(buffer.capacity() == 8);
+    CHECK(buffer.is_growable());
+    const CharBuffer copy(buffer);
+    CHECK(copy.is_growable());
+}
+
+// Applies the same random operations to a buffer and to a string
+template<typename Buffer>
+static void check_random_operations(Buffer& buffer)
+{
+    std::string expected;
+    for (size_t step = 0; step < 2000; ++step)
+    {
+        const std::string text(random_engine() % 40, static_cast<char> ('a' + random_engine() % 3));
+        const size_t start = expected.empty() ? 0 : random_engine() % (expected.length() + 1);
+        const size_t end = start + (expected.length() > start ? random_engine() % (expected.length() - start + 1) : 0);
+        switch (random_engine() % 7)
+        {
+            case 0:
+                buffer = text.c_str();
+                expected = text;
+                break;
+            case 1:
+                buffer += text.c_str();
+                expected += text;
+                break;
+            case 2:
+                buffer.append_raw(text.c_str(), text.length());
+                expected += text;
+                break;
+            case 3:
+                buffer.substring(start, end);
+                expected = expected.substr(start, end - start);
+                break;
+            case 4:
+                buffer.overwrite_with(start, text.c_str());
+                expected.replace(start, text.length(), text);
+                break;
+            case 5:
+                buffer.truncate(start);
+                expected.resize(start < expected.length() ? start : expected.length());
+                break;
+            default:
+                buffer.fill('z', end);
+                expected.resize(end, 'z');
+                break;
+        }
+        if (expected.length() > 400)
+        {
+            buffer.clear();
+            expected.clear();
+        }
+        CHECK(buffer.length() == expected.length());
+        CHECK(buffer == expected.c_str());
+        CHECK(buffer.compare_to(expected.c_str()) == 0);
+        CHECK(buffer.ends_with(expected.c_str()));
+    }
+}
+
+static void test_random_operations()
+{
+    GrowingBuffer growing(16);
+    check_random_operations(growing);
+
+    CharBuffer buffer(16);
+    buffer.set_growable(true);
+    check_random_operations(buffer);
+}
+
+int main()
+{
+    test_moved_from();
+    test_inline_storage();
+    test_char_allocator();
+    test_growth_policies();
+    test_random_operations();
+    return test_result("BasicCharBufferTest");
+}
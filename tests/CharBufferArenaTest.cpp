@@ -0,0 +1,111 @@
+// Checks the block handling of CharBufferArena: sequential allocation from a block, separate blocks
+// for large requests, and reuse of the regular block after reset()
+
+#include <CharBuffer.h>
+#include <CharBufferArena.h>
+
+#include "TestSupport.h"
+
+static const size_t BLOCK_SIZE = 1024;
+
+static void test_sequential_allocation()
+{
+    CharBufferArena arena(BLOCK_SIZE);
+    CHECK(arena.used_bytes() == 0);
+    CHECK(arena.reserved_bytes() == 0);
+
+    char* const first = arena.allocate(100);
+    char* const second = arena.allocate(50);
+    CHECK(second == first + 100);
+    CHECK(arena.used_bytes() == 150);
+    CHECK(arena.reserved_bytes() == BLOCK_SIZE);
+
+    // Deallocation does not return storage to the block
+    arena.deallocate(second, 50);
+    char* const third = arena.allocate(10);
+    CHECK(third == second + 50);
+
+    // A request that does not fit into the rest of the block starts a new block
+    char* const fourth = arena.allocate(250);
+    char* const fifth = arena.allocate(250);
+    char* const sixth = arena.allocate(250);
+    char* const seventh = arena.allocate(200);
+    CHECK(fifth == fourth + 250);
+    CHECK(sixth == fifth + 250);
+    CHECK(seventh < first || seventh >= first + BLOCK_SIZE);
+    CHECK(arena.allocate(10) == seventh + 200);
+    CHECK(arena.reserved_bytes() == 2 * BLOCK_SIZE);
+    CHECK(arena.used_bytes() == 1120);
+}
+
+static void test_large_allocation()
+{
+    CharBufferArena arena(BLOCK_SIZE);
+    char* const small = arena.allocate(10);
+    CHECK(arena.allocate(900) == small + 10);
+
+    // A request above a quarter of the block size that does not fit into the rest of the block
+    // gets a block of its own, so that the free space of the current block is kept
+    char* const large = arena.allocate(BLOCK_SIZE / 4 + 1);
+    CHECK(large < small || large >= small + BLOCK_SIZE);
+    CHECK(arena.reserved_bytes() == BLOCK_SIZE + BLOCK_SIZE / 4 + 1);
+    CHECK(arena.allocate(10) == small + 910);
+
+    char* const huge = arena.allocate(10 * BLOCK_SIZE);
+    huge[10 * BLOCK_SIZE - 1] = 'x';
+    CHECK(arena.reserved_bytes() == 11 * BLOCK_SIZE + BLOCK_SIZE / 4 + 1);
+    CHECK(arena.used_bytes() == 920 + BLOCK_SIZE / 4 + 1 + 10 * BLOCK_SIZE);
+    CHECK(arena.allocate(10) == small + 920);
+}
+
+static void test_reset()
+{
+    CharBufferArena empty_arena(BLOCK_SIZE);
+    empty_arena.reset();
+    CHECK(empty_arena.reserved_bytes() == 0);
+
+    CharBufferArena arena(BLOCK_SIZE);
+    char* const first = arena.allocate(100);
+    arena.allocate(BLOCK_SIZE - 100);
+    arena.allocate(100);
+    arena.allocate(BLOCK_SIZE);
+    CHECK(arena.reserved_bytes() == 3 * BLOCK_SIZE);
+
+    // The first regular block is kept and reused from its start
+    arena.reset();
+    CHECK(arena.used_bytes() == 0);
+    CHECK(arena.reserved_bytes() == BLOCK_SIZE);
+    CHECK(arena.allocate(BLOCK_SIZE) == first);
+    CHECK(arena.reserved_bytes() == BLOCK_SIZE);
+}
+
+static void test_buffers()
+{
+    CharBufferArena arena(BLOCK_SIZE);
+    {
+        CharBuffer first(100, "first", arena);
+        CharBuffer second(100, "second", arena);
+        CHECK(first.has_custom_allocator());
+        CHECK(first == "first");
+        CHECK(second == "second");
+        CHECK(arena.used_bytes() == 202);
+
+        second.set_growable(true);
+        second.fill('x', 2 * BLOCK_SIZE);
+        CHECK(second.length() == 2 * BLOCK_SIZE);
+        CHECK(first == "first");
+    }
+    arena.reset();
+    CharBuffer reused(100, "reused", arena);
+    CHECK(reused == "reused");
+    CHECK(arena.used_bytes() == 101);
+}
+
+int main()
+{
+    test_sequential_allocation();
+    test_large_allocation();
+    test_reset();
+    test_buffers();
+    return test_result("CharBufferArenaTest");
+}
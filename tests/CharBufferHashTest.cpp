@@ -0,0 +1,174 @@
+// Checks that CharBuffer, CharBufferView and C strings with the same content hash equal, that the
+// cached hash value follows each modification, and that concurrent hash() calls agree
+
+#include <string>
+#include <random>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <unordered_set>
+
+#include <CharBuffer.h>
+#include <CharBufferHash.h>
+#include <CharBufferView.h>
+#include <CharPattern.h>
+
+#include "TestSupport.h"
+
+static std::mt19937 random_engine(20181022);
+
+static std::string random_text(const size_t length)
+{
+    std::string text(length, ' ');
+    for (char& letter : text)
+    {
+        letter = static_cast<char> ('a' + random_engine() % 26);
+    }
+    return text;
+}
+
+// Lengths up to 100 cover each of the input length classes of the hash function
+static void test_equal_content()
+{
+    const CharBufferHash hasher;
+    for (size_t length = 0; length <= 100; ++length)
+    {
+        const std::string text = random_text(length);
+        const std::string padded = "<" + text + ">";
+        const CharBuffer buffer(text.c_str());
+        const CharBufferView view = CharBufferView(padded.c_str()).view(1, length + 1);
+        const size_t expected = static_cast<size_t> (CharBufferHash::hash(text.c_str(), length));
+        CHECK(buffer.hash() == expected);
+        CHECK(view.hash() == expected);
+        CHECK(hasher(buffer) == expected);
+        CHECK(hasher(view) == expected);
+        CHECK(hasher(text.c_str()) == expected);
+        CHECK(std::hash<CharBuffer>()(buffer) == expected);
+        CHECK(std::hash<CharBufferView>()(view) == expected);
+        if (length > 0)
+        {
+            CHECK(CharBufferHash::hash(padded.c_str(), length) != CharBufferHash::hash(padded.c_str(), length + 1));
+        }
+    }
+
+    std::unordered_set<CharBuffer, CharBufferHash, CharBufferEqual> set;
+    set.insert(CharBuffer("key"));
+    CHECK(set.count(CharBuffer("key")) == 1);
+    CHECK(set.count(CharBuffer("other")) == 0);
+    const CharBufferEqual equal;
+    CHECK(equal(CharBuffer("key"), CharBufferView("key")));
+    CHECK(equal("key", CharBuffer("key")));
+    CHECK(!equal(CharBufferView("key"), "keys"));
+}
+
+// Each mutation is applied to a buffer whose hash is cached, and the hash must then match the
+// new content
+static void test_cache_invalidation()
+{
+    const CharBuffer other("other content");
+    const std::vector<std::function<void(CharBuffer&)>> mutations = {
+        [&](CharBuffer& buffer) { buffer = other; },
+        [&](CharBuffer& buffer) { buffer = CharBuffer("moved"); },
+        [](CharBuffer& buffer) { buffer = "assigned"; },
+        [&](CharBuffer& buffer) { buffer += other; },
+        [](CharBuffer& buffer) { buffer += "appended"; },
+        [](CharBuffer& buffer) { buffer += '!'; },
+        [](CharBuffer& buffer) { buffer[0] = 'X'; },
+        [](CharBuffer& buffer) { buffer.clear(); },
+        [](CharBuffer& buffer) { buffer.wipe(); },
+        [](CharBuffer& buffer) { buffer.truncate(3); },
+        [](CharBuffer& buffer) { buffer.copy_raw("raw", 3); },
+        [](CharBuffer& buffer) { buffer.substring(1, 4); },
+        [&](CharBuffer& buffer) { buffer.substring_from(other, 1, 4); },
+        [](CharBuffer& buffer) { buffer.substring_from("substring", 1, 4); },
+        [](CharBuffer& buffer) { buffer.substring_raw_from("substring", 1, 4); },
+        [&](CharBuffer& buffer) { buffer.append(other, 0, 5); },
+        [](CharBuffer& buffer) { buffer.append_raw("raw", 3); },
+        [](CharBuffer& buffer) { buffer.append_raw("raw", 1, 3); },
+        [&](CharBuffer& buffer) { buffer.append_all("a", other, 'c'); },
+        [&](CharBuffer& buffer) { const CharBufferView view(other); buffer.append_views(&view, 1); },
+        [](CharBuffer& buffer) { buffer.append_int(-42); },
+        [](CharBuffer& buffer) { buffer.append_uint(42); },
+        [](CharBuffer& buffer) { buffer.append_hex(0x42); },
+        [](CharBuffer& buffer) { buffer.append_double(4.2); },
+        [&](CharBuffer& buffer) { buffer.overwrite_with(1, other); },
+        [&](CharBuffer& buffer) { buffer.overwrite_with(1, other, 2, 4); },
+        [](CharBuffer& buffer) { buffer.overwrite_with(1, "xy"); },
+        [](CharBuffer& buffer) { buffer.overwrite_with(1, "xyz", 1, 2); },
+        [](CharBuffer& buffer) { buffer.overwrite_with_raw(1, "xy", 2); },
+        [](CharBuffer& buffer) { buffer.fill('f'); },
+        [](CharBuffer& buffer) { buffer.fill('f', 20); },
+        [](CharBuffer& buffer) { buffer.to_lower(); },
+        [](CharBuffer& buffer) { buffer.to_upper(); },
+        [](CharBuffer& buffer) { buffer.replace_all("a", "bb"); },
+        [](CharBuffer& buffer) { buffer.replace_all(CharPattern("b"), CharBuffer("")); },
+        [&](CharBuffer& buffer) { buffer.replace_all_from(other, "o", "0"); },
+        [&](CharBuffer& buffer) { buffer.replace_all_from(other, CharPattern("t"), CharBuffer("T")); },
+        [](CharBuffer& buffer) { buffer.set_hash_caching(false); buffer += 'x'; buffer.set_hash_caching(true); }
+    };
+    for (const std::function<void(CharBuffer&)>& mutation : mutations)
+    {
+        CharBuffer buffer(64, "Initial content abab");
+        buffer.set_growable(true);
+        buffer.set_hash_caching(true);
+        CHECK(buffer.hash() == CharBufferHash::hash(buffer.c_str(), buffer.length()));
+        mutation(buffer);
+        CHECK(buffer.hash() == CharBufferHash::hash(buffer.c_str(), buffer.length()));
+
+        // Copies and moves keep a valid cache
+        const CharBuffer copy(buffer);
+        CHECK(copy.hash() == buffer.hash());
+        CharBuffer moved(std::move(buffer));
+        CHECK(moved.hash() == copy.hash());
+        CHECK(buffer.hash() == CharBufferHash::hash("", 0));
+    }
+}
+
+// Threads that call hash() on a shared buffer with caching enabled all get the same value
+static void test_concurrent_hash()
+{
+    static const size_t THREAD_COUNT = 8;
+    CharBuffer buffer(random_text(1000).c_str());
+    buffer.set_growable(true);
+    buffer.set_hash_caching(true);
+    const size_t expected = static_cast<size_t> (CharBufferHash::hash(buffer.c_str(), buffer.length()));
+    for (size_t round = 0; round < 50; ++round)
+    {
+        buffer += 'x';
+        const size_t round_expected = static_cast<size_t> (CharBufferHash::hash(buffer.c_str(), buffer.length()));
+        std::vector<size_t> results(THREAD_COUNT);
+        std::vector<std::thread> threads;
+        const CharBuffer& shared = buffer;
+        for (size_t idx = 0; idx < THREAD_COUNT; ++idx)
+        {
+            threads.emplace_back(
+                [&shared, &results, idx]
+                {
+                    size_t result = shared.hash();
+                    for (size_t repeat = 0; repeat < 100; ++repeat)
+                    {
+                        result = shared.hash() == result ? result : 0;
+                    }
+                    results[idx] = result;
+                }
+            );
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        for (const size_t result : results)
+        {
+            CHECK(result == round_expected);
+        }
+        CHECK(round_expected != expected);
+    }
+}
+
+int main()
+{
+    test_equal_content();
+    test_cache_invalidation();
+    test_concurrent_hash();
+    return test_result("CharBufferHashTest");
+}
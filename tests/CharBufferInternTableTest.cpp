@@ -0,0 +1,178 @@
+// Checks that CharBufferInternTable returns the same canonical buffer for equal content, across
+// the argument types, for entries stored in the shard arenas, and for concurrent intern() calls
+
+#include <algorithm>
+#include <string>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <CharBuffer.h>
+#include <CharBufferInternTable.h>
+#include <CharBufferView.h>
+
+#include "TestSupport.h"
+
+static std::mt19937 random_engine(20181023);
+
+static std::string random_text(const size_t length)
+{
+    std::string text(length, ' ');
+    for (char& letter : text)
+    {
+        letter = static_cast<char> ('a' + random_engine() % 26);
+    }
+    return text;
+}
+
+static void test_identity()
+{
+    CharBufferInternTable table;
+    CHECK(table.entry_count() == 0);
+
+    const CharBuffer* const entry = table.intern("key");
+    CHECK(*entry == "key");
+    CHECK(entry->is_hash_caching());
+    CHECK(table.intern("key") == entry);
+    CHECK(table.intern(CharBuffer("key")) == entry);
+    CHECK(table.intern(CharBufferView("monkeys").view(3, 6)) == entry);
+    CHECK(table.intern("keys", 3) == entry);
+    CHECK(table.find("key", 3) == entry);
+    CHECK(table.find(CharBufferView("key")) == entry);
+
+    const CharBuffer* const empty = table.intern("");
+    CHECK(empty->is_empty());
+    CHECK(empty != entry);
+    CHECK(table.intern(CharBufferView()) == empty);
+    CHECK(table.entry_count() == 2);
+    CHECK(table.content_bytes() == 3);
+
+    // Many entries force the slot arrays of the shards to grow, which must not move the entries
+    std::vector<std::string> texts;
+    std::vector<const CharBuffer*> entries;
+    for (size_t idx = 0; idx < 5000; ++idx)
+    {
+        texts.push_back(std::to_string(idx));
+        entries.push_back(table.intern(texts.back().c_str()));
+    }
+    for (size_t idx = 0; idx < texts.size(); ++idx)
+    {
+        CHECK(*(entries[idx]) == texts[idx].c_str());
+        CHECK(table.intern(texts[idx].c_str()) == entries[idx]);
+        CHECK(table.find(CharBufferView(texts[idx].c_str())) == entries[idx]);
+    }
+    CHECK(table.intern("key") == entry);
+    CHECK(table.entry_count() == 5002);
+}
+
+static void test_find_miss()
+{
+    CharBufferInternTable table;
+    CHECK(table.find("key", 3) == nullptr);
+    CHECK(table.find(CharBufferView()) == nullptr);
+    table.intern("key");
+    CHECK(table.find("ke", 2) == nullptr);
+    CHECK(table.find("keys", 4) == nullptr);
+    CHECK(table.find("KEY", 3) == nullptr);
+    CHECK(table.find("", 0) == nullptr);
+
+    // A miss does not add an entry
+    CHECK(table.entry_count() == 1);
+}
+
+// Entries that do not fit into the inline storage of a CharBuffer are stored in the arena of
+// their shard
+static void test_long_entries()
+{
+    CharBufferInternTable table;
+    const size_t empty_bytes = table.memory_bytes();
+
+    const std::string text = random_text(1000);
+    const CharBuffer* const entry = table.intern(text.c_str());
+    CHECK(entry->has_custom_allocator());
+    CHECK(*entry == text.c_str());
+    CHECK(table.content_bytes() == 1000);
+    CHECK(table.memory_bytes() >= empty_bytes + 1000);
+
+    // The source may change afterwards without affecting the entry
+    CharBuffer source(text.c_str());
+    CHECK(table.intern(source) == entry);
+    source[0] = source[0] == 'a' ? 'b' : 'a';
+    CHECK(*entry == text.c_str());
+    const CharBuffer* const other = table.intern(source);
+    CHECK(other != entry);
+    CHECK(*other == source);
+    CHECK(table.find(CharBufferView(text.c_str())) == entry);
+
+    for (size_t idx = 0; idx < 200; ++idx)
+    {
+        const std::string long_text = random_text(32 + random_engine() % 300);
+        const CharBuffer* const long_entry = table.intern(long_text.c_str());
+        CHECK(*long_entry == long_text.c_str());
+        CHECK(table.intern(long_text.c_str()) == long_entry);
+    }
+    CHECK(*entry == text.c_str());
+}
+
+// Threads intern the same keys in different orders, and all of them must get the same buffer
+// for each key
+static void test_concurrent_intern()
+{
+    static const size_t THREAD_COUNT = 8;
+    static const size_t KEY_COUNT = 2000;
+    std::vector<std::string> keys;
+    for (size_t idx = 0; idx < KEY_COUNT; ++idx)
+    {
+        keys.push_back(random_text(1 + random_engine() % 64));
+    }
+
+    for (size_t round = 0; round < 5; ++round)
+    {
+        CharBufferInternTable table;
+        std::vector<std::vector<const CharBuffer*>> results(THREAD_COUNT);
+        std::vector<std::thread> threads;
+        for (size_t thread_idx = 0; thread_idx < THREAD_COUNT; ++thread_idx)
+        {
+            threads.emplace_back(
+                [&table, &keys, &results, thread_idx]
+                {
+                    std::vector<const CharBuffer*>& result = results[thread_idx];
+                    result.resize(KEY_COUNT);
+                    for (size_t idx = 0; idx < KEY_COUNT; ++idx)
+                    {
+                        const size_t key_idx = thread_idx % 2 == 0 ? idx : KEY_COUNT - 1 - idx;
+                        result[key_idx] = table.intern(keys[key_idx].c_str());
+                    }
+                }
+            );
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        // Keys may repeat, so the number of entries is counted from the distinct pointers
+        std::vector<const CharBuffer*> distinct(results[0]);
+        std::sort(distinct.begin(), distinct.end());
+        distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+        CHECK(table.entry_count() == distinct.size());
+        for (size_t idx = 0; idx < KEY_COUNT; ++idx)
+        {
+            CHECK(*(results[0][idx]) == keys[idx].c_str());
+            CHECK(table.find(CharBufferView(keys[idx].c_str())) == results[0][idx]);
+            for (size_t thread_idx = 1; thread_idx < THREAD_COUNT; ++thread_idx)
+            {
+                CHECK(results[thread_idx][idx] == results[0][idx]);
+            }
+        }
+    }
+}
+
+int main()
+{
+    test_identity();
+    test_find_miss();
+    test_long_entries();
+    test_concurrent_intern();
+    return test_result("CharBufferInternTableTest");
+}
@@ -0,0 +1,219 @@
+// Reads into buffers from pipes and checks the growth of growable and the limits of fixed buffers,
+// and writes many buffers with write_all_to() while a timer interrupts the writes, so that batches
+// are written partially
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+#include <CharBuffer.h>
+#include <IoException.h>
+#include <RangeException.h>
+
+#include "TestSupport.h"
+
+static std::mt19937 random_engine(20181028);
+
+static std::string random_text(const size_t length)
+{
+    std::string text(length, ' ');
+    for (char& letter : text)
+    {
+        letter = static_cast<char> ('a' + random_engine() % 26);
+    }
+    return text;
+}
+
+static void write_text(const int fd, const std::string& text)
+{
+    CHECK(write(fd, text.data(), text.length()) == static_cast<ssize_t> (text.length()));
+}
+
+// Reads from fd until the end of file
+static std::string read_text(const int fd)
+{
+    std::string text;
+    char chunk[1000];
+    ssize_t result = 0;
+    do
+    {
+        result = read(fd, chunk, 1 + random_engine() % sizeof(chunk));
+        if (result > 0)
+        {
+            text.append(chunk, static_cast<size_t> (result));
+        }
+    }
+    while (result > 0 || (result == -1 && errno == EINTR));
+    CHECK(result == 0);
+    return text;
+}
+
+// Only interrupts the system call, which is not restarted
+static void interrupt(int)
+{
+}
+
+static void test_partial_reads()
+{
+    int pipe_fds[2];
+    CHECK(pipe(pipe_fds) == 0);
+
+    // A read returns what is available, which is less than max_length
+    CharBuffer growable(16, "0123456789abcdef");
+    growable.set_growable(true);
+    write_text(pipe_fds[1], "ghij");
+    CHECK(growable.read_from(pipe_fds[0], 1000) == 4);
+    CHECK(growable == "0123456789abcdefghij");
+
+    // The buffer grows by one step of the growth policy rather than by max_length
+    CHECK(growable.capacity() == 32);
+    write_text(pipe_fds[1], random_text(20));
+    CHECK(growable.read_from(pipe_fds[0], CharBuffer::MAX_CAPACITY) == 12);
+    CHECK(growable.length() == 32);
+    CHECK(growable.capacity() == 32);
+    CHECK(growable.read_from(pipe_fds[0], CharBuffer::MAX_CAPACITY) == 8);
+    CHECK(growable.capacity() == 64);
+
+    // Growth stops at max_length characters of remaining capacity
+    write_text(pipe_fds[1], "klmno");
+    CHECK(growable.read_from(pipe_fds[0], 3) == 3);
+    CHECK(growable.length() == 43);
+    CharBuffer small(4, "abcd");
+    small.set_growable(true);
+    CHECK(small.read_from(pipe_fds[0], 2) == 2);
+    CHECK(small == "abcdno");
+    CHECK(small.capacity() == 6);
+    CHECK(small.read_from(pipe_fds[0], 0) == 0);
+    CHECK(small.capacity() == 6);
+
+    // A fixed buffer reads what fits into its remaining capacity
+    CharBuffer fixed(8, "abc");
+    write_text(pipe_fds[1], "defghijk");
+    CHECK(fixed.read_from(pipe_fds[0], 100) == 5);
+    CHECK(fixed == "abcdefgh");
+    CHECK(fixed.capacity() == 8);
+    CHECK_THROWS(RangeException, fixed.read_from(pipe_fds[0], 1));
+    CHECK(fixed.read_from(pipe_fds[0], 0) == 0);
+    CHECK(fixed == "abcdefgh");
+
+    // The end of file is a read of 0 characters
+    close(pipe_fds[1]);
+    CharBuffer rest(16);
+    CHECK(rest.read_from(pipe_fds[0], 16) == 3);
+    CHECK(rest == "ijk");
+    CHECK(rest.read_from(pipe_fds[0], 16) == 0);
+    CHECK(rest == "ijk");
+    close(pipe_fds[0]);
+
+    CharBuffer closed(16);
+    CHECK_THROWS(IoException, closed.read_from(pipe_fds[0], 16));
+    CHECK(closed.length() == 0);
+}
+
+// Reads the output of a writer thread in pieces of random sizes, more than fits into the pipe
+static void test_read_all()
+{
+    int pipe_fds[2];
+    CHECK(pipe(pipe_fds) == 0);
+    const std::string text = random_text(300000);
+    std::thread writer([&]()
+    {
+        std::mt19937 writer_engine(20181029);
+        size_t written = 0;
+        while (written < text.length())
+        {
+            const size_t count = std::min(text.length() - written, static_cast<size_t> (1 + writer_engine() % 5000));
+            write_text(pipe_fds[1], text.substr(written, count));
+            written += count;
+        }
+        close(pipe_fds[1]);
+    });
+
+    CharBuffer buffer(1);
+    buffer.set_growable(true);
+    while (buffer.read_from(pipe_fds[0], 1 + random_engine() % 100000) > 0)
+    {
+        CHECK(buffer.capacity() < 2 * text.length());
+    }
+    writer.join();
+    close(pipe_fds[0]);
+    CHECK(buffer.equals_raw(text.data(), text.length()));
+}
+
+static void test_write_all_to()
+{
+    // Blocked for the reader thread, so that the timer only interrupts the writes
+    sigset_t alarm_set;
+    sigemptyset(&alarm_set);
+    sigaddset(&alarm_set, SIGALRM);
+    pthread_sigmask(SIG_BLOCK, &alarm_set, nullptr);
+
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = interrupt;
+    sigaction(SIGALRM, &action, nullptr);
+
+    for (const size_t buffer_count : {0, 1, 255, 256, 257, 1000, 5000})
+    {
+        std::vector<std::unique_ptr<CharBuffer>> buffers;
+        std::vector<const CharBuffer*> fragments;
+        std::string expected;
+        for (size_t index = 0; index < buffer_count; ++index)
+        {
+            const size_t length = random_engine() % 4 == 0 ? 0 : random_engine() % 300;
+            const std::string text = random_text(length);
+            buffers.emplace_back(new CharBuffer(length, text.c_str()));
+            fragments.push_back(buffers.back().get());
+            expected += text;
+        }
+
+        int pipe_fds[2];
+        CHECK(pipe(pipe_fds) == 0);
+        std::string received;
+        std::thread reader([&]()
+        {
+            received = read_text(pipe_fds[0]);
+        });
+
+        // Writes into a full pipe are interrupted after a part of the batch is written
+        pthread_sigmask(SIG_UNBLOCK, &alarm_set, nullptr);
+        struct itimerval interval;
+        interval.it_interval.tv_sec = 0;
+        interval.it_interval.tv_usec = 200;
+        interval.it_value = interval.it_interval;
+        setitimer(ITIMER_REAL, &interval, nullptr);
+        CharBuffer::write_all_to(pipe_fds[1], fragments);
+        std::memset(&interval, 0, sizeof(interval));
+        setitimer(ITIMER_REAL, &interval, nullptr);
+        pthread_sigmask(SIG_BLOCK, &alarm_set, nullptr);
+
+        close(pipe_fds[1]);
+        reader.join();
+        close(pipe_fds[0]);
+        CHECK(received == expected);
+    }
+    pthread_sigmask(SIG_UNBLOCK, &alarm_set, nullptr);
+
+    std::vector<const CharBuffer*> fragments;
+    const CharBuffer text("abc");
+    fragments.push_back(&text);
+    CHECK_THROWS(IoException, CharBuffer::write_all_to(-1, fragments));
+}
+
+int main()
+{
+    test_partial_reads();
+    test_read_all();
+    test_write_all_to();
+    return test_result("CharBufferIoTest");
+}
@@ -0,0 +1,241 @@
+// Maps temporary files and compares the mapped content with the written content, and checks the
+// errors for files that cannot be mapped, the alignment of advised ranges and moves
+
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <random>
+#include <utility>
+
+#include <unistd.h>
+
+#include <CharBuffer.h>
+#include <CharBufferMapping.h>
+#include <CharBufferView.h>
+#include <IoException.h>
+#include <RangeException.h>
+
+#include "TestSupport.h"
+
+static std::mt19937 random_engine(20181027);
+
+static const CharBufferMapping::Access ACCESSES[] = {
+    CharBufferMapping::Access::NORMAL,
+    CharBufferMapping::Access::SEQUENTIAL,
+    CharBufferMapping::Access::RANDOM,
+    CharBufferMapping::Access::WILL_NEED,
+    CharBufferMapping::Access::DONT_NEED
+};
+
+// Creates a temporary file with the given content and length, the part after the content is a hole
+static std::string create_file(const std::string& content, const off_t length)
+{
+    char path[] = "/tmp/CharBufferMappingTest.XXXXXX";
+    const int fd = mkstemp(path);
+    CHECK(fd != -1);
+    size_t written = 0;
+    while (fd != -1 && written < content.length())
+    {
+        const ssize_t count = write(fd, content.data() + written, content.length() - written);
+        CHECK(count > 0 || errno == EINTR);
+        written += count > 0 ? static_cast<size_t> (count) : 0;
+    }
+    CHECK(ftruncate(fd, length) == 0);
+    close(fd);
+    return path;
+}
+
+static std::string create_file(const std::string& content)
+{
+    return create_file(content, static_cast<off_t> (content.length()));
+}
+
+static std::string random_text(const size_t length)
+{
+    std::string text(length, ' ');
+    for (char& letter : text)
+    {
+        letter = static_cast<char> ('a' + random_engine() % 26);
+    }
+    return text;
+}
+
+static int error_number_of(const char* const path)
+{
+    int error_number = 0;
+    try
+    {
+        CharBufferMapping mapping(path);
+    }
+    catch (IoException& e)
+    {
+        error_number = e.error_number();
+    }
+    return error_number;
+}
+
+static void test_content()
+{
+    const size_t page_size = static_cast<size_t> (sysconf(_SC_PAGESIZE));
+    for (const size_t length : {static_cast<size_t> (1), static_cast<size_t> (100), page_size, 3 * page_size + 17})
+    {
+        const std::string text = random_text(length);
+        const std::string path = create_file(text);
+        const CharBufferMapping mapping(path.c_str());
+        unlink(path.c_str());
+
+        // The mapping remains valid after the file is unlinked
+        CHECK(!mapping.is_empty());
+        CHECK(mapping.length() == length);
+        CHECK(std::string(mapping.data(), mapping.length()) == text);
+        CHECK(mapping[length - 1] == text[length - 1]);
+        CHECK_THROWS(RangeException, mapping[length]);
+        CHECK(mapping.view(length / 2, length) == text.substr(length / 2).c_str());
+        CHECK_THROWS(RangeException, mapping.view(1, length + 1));
+
+        const std::string needle = text.substr(length - 1 - length / 3, 1 + length / 3);
+        const CharBufferView needle_view(needle.data(), needle.length());
+        CHECK(mapping.index_of(needle_view) == text.find(needle));
+        CHECK(mapping.index_of(text[length / 2], length / 2) == length / 2);
+        CHECK(mapping.ends_with(needle_view));
+        CHECK(mapping.starts_with(CharBufferView(text.data(), length / 2)));
+        CHECK(mapping.compare_to(CharBufferView(text.data(), length)) == 0);
+        CHECK(mapping.compare_to(CharBufferView(text.data(), length - 1)) > 0);
+    }
+}
+
+static void test_empty_file()
+{
+    const std::string path = create_file("");
+    const CharBufferMapping mapping(path.c_str());
+    unlink(path.c_str());
+
+    // Empty files are not mapped, the content is an empty string
+    CHECK(mapping.is_empty());
+    CHECK(mapping.length() == 0);
+    CHECK(mapping.data() != nullptr);
+    CHECK(mapping.view().is_empty());
+    CHECK(mapping.compare_to(CharBufferView("")) == 0);
+    CHECK(mapping.index_of('a') == CharBuffer::NPOS);
+    CHECK_THROWS(RangeException, mapping[0]);
+}
+
+static void test_errors()
+{
+    CHECK(error_number_of("/tmp/CharBufferMappingTest.missing/file") == ENOENT);
+
+    // Only regular files are mapped
+    CHECK(error_number_of("/dev/null") == ENODEV);
+    CHECK(error_number_of("/tmp") == ENODEV);
+    int pipe_fds[2];
+    CHECK(pipe(pipe_fds) == 0);
+    const std::string pipe_path = "/proc/self/fd/" + std::to_string(pipe_fds[0]);
+    CHECK(error_number_of(pipe_path.c_str()) == ENODEV);
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+
+    // A file of 2^32 + 1 bytes exceeds the capacity of a 32-bit size_t, otherwise it is mapped
+    // entirely; the file is sparse and only its last page is read
+    const uint64_t large_length = (static_cast<uint64_t> (1) << 32) + 1;
+    const std::string path = create_file("x", static_cast<off_t> (large_length));
+    if (static_cast<uint64_t> (CharBuffer::MAX_CAPACITY) < large_length)
+    {
+        CHECK(error_number_of(path.c_str()) == EFBIG);
+    }
+    else
+    {
+        const CharBufferMapping mapping(path.c_str());
+        CHECK(mapping.length() == large_length);
+        CHECK(mapping[0] == 'x');
+        CHECK(mapping[static_cast<size_t> (large_length - 1)] == '\0');
+    }
+    unlink(path.c_str());
+}
+
+static void test_advise()
+{
+    const size_t page_size = static_cast<size_t> (sysconf(_SC_PAGESIZE));
+    const size_t length = 4 * page_size + 5;
+    const std::string text = random_text(length);
+    const std::string path = create_file(text);
+    CharBufferMapping mapping(path.c_str());
+    unlink(path.c_str());
+
+    // Ranges that start anywhere within a page are advised from the start of the page
+    const size_t starts[] = {0, 1, page_size - 1, page_size, page_size + 1, 3 * page_size + 7, length - 1};
+    for (const CharBufferMapping::Access access : ACCESSES)
+    {
+        mapping.advise(access);
+        for (const size_t start : starts)
+        {
+            mapping.advise(access, start, start + 1);
+            mapping.advise(access, start, length);
+            mapping.advise(access, start, start);
+        }
+        mapping.advise(access, length, length);
+    }
+
+    // Dropped pages are read again from the file
+    CHECK(std::string(mapping.data(), mapping.length()) == text);
+
+    CHECK_THROWS(RangeException, mapping.advise(CharBufferMapping::Access::NORMAL, 2, 1));
+    CHECK_THROWS(RangeException, mapping.advise(CharBufferMapping::Access::NORMAL, 0, length + 1));
+    CHECK_THROWS(RangeException, mapping.advise(CharBufferMapping::Access::NORMAL, length + 1, length + 1));
+
+    const std::string empty_path = create_file("");
+    CharBufferMapping empty(empty_path.c_str());
+    unlink(empty_path.c_str());
+    for (const CharBufferMapping::Access access : ACCESSES)
+    {
+        empty.advise(access);
+        empty.advise(access, 0, 0);
+    }
+    CHECK_THROWS(RangeException, empty.advise(CharBufferMapping::Access::NORMAL, 0, 1));
+}
+
+static void test_move()
+{
+    const std::string first_text = random_text(1000);
+    const std::string second_text = random_text(5000);
+    const std::string first_path = create_file(first_text);
+    const std::string second_path = create_file(second_text);
+
+    CharBufferMapping first(first_path.c_str());
+    const char* const first_data = first.data();
+    CharBufferMapping moved(std::move(first));
+    CHECK(moved.data() == first_data);
+    CHECK(std::string(moved.data(), moved.length()) == first_text);
+    CHECK(first.is_empty());
+    CHECK(first.data() != nullptr);
+    CHECK(first.index_of('a') == CharBuffer::NPOS);
+
+    // The mapping that is assigned to is unmapped, the source becomes empty
+    CharBufferMapping second(second_path.c_str());
+    const char* const second_data = second.data();
+    moved = std::move(second);
+    CHECK(moved.data() == second_data);
+    CHECK(std::string(moved.data(), moved.length()) == second_text);
+    CHECK(second.is_empty());
+
+    CharBufferMapping& self = moved;
+    moved = std::move(self);
+    CHECK(std::string(moved.data(), moved.length()) == second_text);
+
+    // A moved-from mapping can be assigned to again
+    first = std::move(moved);
+    CHECK(std::string(first.data(), first.length()) == second_text);
+    CHECK(moved.is_empty());
+
+    unlink(first_path.c_str());
+    unlink(second_path.c_str());
+}
+
+int main()
+{
+    test_content();
+    test_empty_file();
+    test_errors();
+    test_advise();
+    test_move();
+    return test_result("CharBufferMappingTest");
+}
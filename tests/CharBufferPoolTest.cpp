@@ -0,0 +1,66 @@
+// Checks that recycled buffers are returned in the state of new buffers, and that the pool
+// does not retain buffers whose storage it does not own
+
+#include <memory>
+#include <utility>
+
+#include <CharBuffer.h>
+#include <CharBufferArena.h>
+#include <CharBufferPool.h>
+
+#include "TestSupport.h"
+
+static void test_recycled_state()
+{
+    CharBufferPool pool(1024 * 1024);
+    CharBuffer* recycled = nullptr;
+    {
+        CharBufferPool::Handle handle = pool.acquire(100);
+        recycled = handle.get();
+        handle->set_growable(true);
+        handle->set_hash_caching(true);
+        *handle = "content";
+        handle->hash();
+    }
+    CHECK(pool.retained_buffers() == 1);
+
+    CharBufferPool::Handle handle = pool.acquire(100);
+    CHECK(handle.get() == recycled);
+    CHECK(pool.hit_count() == 1);
+    CHECK(handle->is_empty());
+    CHECK(!handle->is_growable());
+    CHECK(!handle->is_hash_caching());
+    CHECK(handle->capacity() >= 100);
+}
+
+static void test_custom_allocator()
+{
+    CharBufferPool pool(1024 * 1024);
+    {
+        CharBufferArena arena;
+        std::unique_ptr<CharBuffer> buffer(new CharBuffer(100, arena));
+        CHECK(buffer->has_custom_allocator());
+        pool.release(std::move(buffer));
+        CHECK(pool.retained_buffers() == 0);
+        CHECK(pool.retained_bytes() == 0);
+    }
+
+    // A buffer that was allocated from the heap is retained, even if it was not acquired from the pool
+    std::unique_ptr<CharBuffer> buffer(new CharBuffer(100));
+    CHECK(!buffer->has_custom_allocator());
+    pool.release(std::move(buffer));
+    CHECK(pool.retained_buffers() == 1);
+
+    // The retained buffer does not reference storage of the destroyed arena
+    CharBufferPool::Handle handle = pool.acquire(64);
+    CHECK(!handle->has_custom_allocator());
+    *handle = "reused";
+    CHECK(*handle == "reused");
+}
+
+int main()
+{
+    test_recycled_state();
+    test_custom_allocator();
+    return test_result("CharBufferPoolTest");
+}
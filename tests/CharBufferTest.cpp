@@ -0,0 +1,384 @@
+// Compares the CharBuffer, C string and _raw variants of the comparison, prefix, suffix and search
+// functions with each other and against std::string, and checks append_all() and concat() with
+// mixed arguments
+
+#include <memory>
+#include <string>
+#include <random>
+#include <vector>
+
+#include <CharBuffer.h>
+#include <CharBufferView.h>
+#include <CharPattern.h>
+#include <RangeException.h>
+
+#include "TestSupport.h"
+
+static std::mt19937 random_engine(20181020);
+
+static std::string random_text(const size_t length)
+{
+    std::string text(length, ' ');
+    for (char& letter : text)
+    {
+        letter = "ab"[random_engine() % 2];
+    }
+    return text;
+}
+
+static int sign(const int value)
+{
+    return value < 0 ? -1 : (value > 0 ? 1 : 0);
+}
+
+static bool std_starts_with(const std::string& text, const std::string& prefix)
+{
+    return prefix.length() <= text.length() && text.compare(0, prefix.length(), prefix) == 0;
+}
+
+static bool std_ends_with(const std::string& text, const std::string& suffix)
+{
+    return suffix.length() <= text.length() &&
+        text.compare(text.length() - suffix.length(), suffix.length(), suffix) == 0;
+}
+
+// ends_with compared the wrong range whenever the suffix was not exactly half of the buffer
+static void test_ends_with()
+{
+    const CharBuffer buffer("abcdef");
+    CHECK(buffer.ends_with("f"));
+    CHECK(buffer.ends_with("ef"));
+    CHECK(buffer.ends_with("def"));
+    CHECK(buffer.ends_with("bcdef"));
+    CHECK(buffer.ends_with("abcdef"));
+    CHECK(buffer.ends_with(""));
+    CHECK(!buffer.ends_with("e"));
+    CHECK(!buffer.ends_with("cd"));
+    CHECK(!buffer.ends_with("abcde"));
+    CHECK(!buffer.ends_with("xabcdef"));
+    CHECK(buffer.ends_with(CharBuffer("ef")));
+    CHECK(!buffer.ends_with(CharBuffer("ab")));
+    CHECK(buffer.ends_with_raw("efX", 2));
+    CHECK(!buffer.ends_with_raw("abX", 2));
+
+    const CharBuffer empty(16);
+    CHECK(empty.ends_with(""));
+    CHECK(!empty.ends_with("a"));
+}
+
+// The _raw variants must not read past length, so the data is followed by a letter that would
+// change the result if it were included
+static void test_random_raw_variants()
+{
+    for (size_t round = 0; round < 2000; ++round)
+    {
+        const std::string text = random_text(random_engine() % 40);
+        std::string other = random_text(random_engine() % 8);
+        if (round % 2 == 0 && !text.empty())
+        {
+            // A piece of the text, so that the prefix, suffix and search functions also find matches
+            const size_t start = random_engine() % text.length();
+            other = text.substr(start, random_engine() % (text.length() - start + 1));
+        }
+        const CharBuffer buffer(text.c_str());
+        const CharBuffer other_buffer(other.c_str());
+        const std::string padded = other + "c";
+        const char* const data = padded.c_str();
+        const size_t length = other.length();
+
+        CHECK(buffer.equals_raw(data, length) == (text == other));
+        CHECK((buffer == other.c_str()) == (text == other));
+        CHECK((buffer == other_buffer) == (text == other));
+
+        const int expected_order = sign(text.compare(other));
+        CHECK(sign(buffer.compare_to_raw(data, length)) == expected_order);
+        CHECK(sign(buffer.compare_to(other.c_str())) == expected_order);
+        CHECK(sign(buffer.compare_to(other_buffer)) == expected_order);
+
+        const bool expected_prefix = std_starts_with(text, other);
+        CHECK(buffer.starts_with_raw(data, length) == expected_prefix);
+        CHECK(buffer.starts_with(other.c_str()) == expected_prefix);
+        CHECK(buffer.starts_with(other_buffer) == expected_prefix);
+
+        const bool expected_suffix = std_ends_with(text, other);
+        CHECK(buffer.ends_with_raw(data, length) == expected_suffix);
+        CHECK(buffer.ends_with(other.c_str()) == expected_suffix);
+        CHECK(buffer.ends_with(other_buffer) == expected_suffix);
+
+        const size_t start = random_engine() % (text.length() + 1);
+        const size_t expected_index = text.find(other, start);
+        CHECK(buffer.index_of_raw(data, length) == text.find(other));
+        CHECK(buffer.index_of_raw(data, length, start) == expected_index);
+        CHECK(buffer.index_of(other.c_str(), start) == expected_index);
+        CHECK(buffer.index_of(other_buffer, start) == expected_index);
+
+        if (!other.empty())
+        {
+            // The last occurrence that lies entirely within [0, start)
+            const size_t expected_last = text.substr(0, start).rfind(other);
+            CHECK(buffer.last_index_of_raw(data, length) == text.rfind(other));
+            CHECK(buffer.last_index_of_raw(data, length, start) == expected_last);
+            CHECK(buffer.last_index_of(other.c_str(), start) == expected_last);
+            CHECK(buffer.last_index_of(other_buffer, start) == expected_last);
+        }
+
+        CharBuffer target(text.c_str());
+        target.set_growable(true);
+        std::string expected = text;
+        target.overwrite_with_raw(start, data, length);
+        expected.replace(start, length, other);
+        CHECK(target.length() == expected.length());
+        CHECK(target == expected.c_str());
+    }
+
+    const CharBuffer buffer("abc");
+    CHECK_THROWS(RangeException, buffer.index_of_raw("a", 1, 4));
+    CHECK_THROWS(RangeException, buffer.last_index_of_raw("a", 1, 4));
+    CharBuffer target("abc");
+    CHECK_THROWS(RangeException, target.overwrite_with_raw(4, "d", 1));
+    CHECK(target == "abc");
+}
+
+// Number of matches of pattern in text, counted with std::string
+static size_t std_count_of(const std::string& text, const std::string& pattern, const CharBuffer::MatchMode mode)
+{
+    const size_t step = mode == CharBuffer::MatchMode::NON_OVERLAPPING ? pattern.length() : 1;
+    size_t count = 0;
+    size_t index = text.find(pattern);
+    while (index != std::string::npos)
+    {
+        ++count;
+        index = text.find(pattern, index + step);
+    }
+    return count;
+}
+
+// Patterns that are longer than CharPattern::SHORT_PATTERN_LENGTH and match at almost every
+// position, so that each match is followed by another search with the same pattern
+static void test_dense_long_pattern_matches()
+{
+    const CharBuffer::MatchMode modes[] = {CharBuffer::MatchMode::OVERLAPPING, CharBuffer::MatchMode::NON_OVERLAPPING};
+    const std::string texts[] = {std::string(5000, 'a'), std::string(5000, 'a') + "b" + std::string(300, 'a')};
+    const std::string patterns[] = {
+        std::string(CharPattern::SHORT_PATTERN_LENGTH + 1, 'a'),
+        std::string(100, 'a'),
+        std::string(40, 'a') + "b" + std::string(40, 'a')
+    };
+    for (const std::string& text : texts)
+    {
+        const CharBuffer buffer(text.c_str());
+        for (const std::string& pattern : patterns)
+        {
+            const CharBuffer pattern_buffer(pattern.c_str());
+            const CharPattern compiled(pattern_buffer);
+            for (const CharBuffer::MatchMode mode : modes)
+            {
+                const size_t expected_count = std_count_of(text, pattern, mode);
+                CHECK(buffer.count_of(pattern_buffer, mode) == expected_count);
+                CHECK(buffer.count_of(compiled, mode) == expected_count);
+            }
+
+            CharBuffer target(text.c_str());
+            const size_t replace_count = target.replace_all(pattern.c_str(), "x");
+            CHECK(replace_count == std_count_of(text, pattern, CharBuffer::MatchMode::NON_OVERLAPPING));
+            std::string expected = text;
+            size_t index = expected.find(pattern);
+            while (index != std::string::npos)
+            {
+                expected.replace(index, pattern.length(), "x");
+                index = expected.find(pattern, index + 1);
+            }
+            CHECK(target == expected.c_str());
+        }
+    }
+    CHECK(CharBuffer(std::string(5000, 'a').c_str()).count_of(
+        CharBuffer(std::string(40, 'a').c_str()), CharBuffer::MatchMode::OVERLAPPING
+    ) == 4961);
+}
+
+// Replaces the non-overlapping matches of pattern from left to right with std::string
+static std::string std_replace_all(const std::string& text, const std::string& pattern, const std::string& replacement)
+{
+    std::string result = text;
+    size_t index = result.find(pattern);
+    while (index != std::string::npos)
+    {
+        result.replace(index, pattern.length(), replacement);
+        index = result.find(pattern, index + replacement.length());
+    }
+    return result;
+}
+
+static void test_random_replace_all()
+{
+    for (size_t round = 0; round < 1000; ++round)
+    {
+        const std::string text = random_text(random_engine() % 60);
+        const std::string pattern = random_text(1 + random_engine() % 3);
+        const std::string replacement = random_text(random_engine() % 6);
+        const std::string expected = std_replace_all(text, pattern, replacement);
+        const size_t expected_count = std_count_of(text, pattern, CharBuffer::MatchMode::NON_OVERLAPPING);
+        const CharBuffer source(text.c_str());
+        const CharPattern compiled(pattern.c_str());
+        const CharBuffer replacement_buffer(replacement.c_str());
+
+        CharBuffer target(text.c_str());
+        target.set_growable(true);
+        CHECK(target.replace_all(pattern.c_str(), replacement.c_str()) == expected_count);
+        CHECK(target == expected.c_str());
+
+        target = text.c_str();
+        CHECK(target.replace_all(compiled, replacement_buffer) == expected_count);
+        CHECK(target == expected.c_str());
+
+        // A target that has to grow is allocated with exactly the length of the result
+        CharBuffer from_target(1);
+        from_target.set_growable(true);
+        CHECK(from_target.replace_all_from(source, pattern.c_str(), replacement.c_str()) == expected_count);
+        CHECK(from_target == expected.c_str());
+        CHECK(from_target.capacity() == (expected.length() > 1 ? expected.length() : 1));
+
+        CharBuffer exact_target(expected.length());
+        CHECK(exact_target.replace_all_from(source, compiled, replacement_buffer) == expected_count);
+        CHECK(exact_target == expected.c_str());
+        CHECK(exact_target.capacity() == expected.length());
+    }
+}
+
+// The content is unchanged if replace_all or replace_all_from throws
+static void test_replace_all_errors()
+{
+    CharBuffer buffer("abcabc");
+    CHECK_THROWS(RangeException, buffer.replace_all("", "x"));
+    CHECK_THROWS(RangeException, buffer.replace_all(CharPattern(""), CharBuffer("x")));
+    CHECK_THROWS(RangeException, buffer.replace_all_from(CharBuffer("abc"), "", "x"));
+    CHECK(buffer == "abcabc");
+
+    CharBuffer fixed(6, "abcabc");
+    CHECK_THROWS(RangeException, fixed.replace_all("b", "xyz"));
+    CHECK(fixed == "abcabc");
+    CHECK_THROWS(RangeException, fixed.replace_all(CharPattern("c"), CharBuffer("cc")));
+    CHECK(fixed == "abcabc");
+    CHECK_THROWS(RangeException, fixed.replace_all_from(CharBuffer("aaaa"), "a", "xx"));
+    CHECK(fixed == "abcabc");
+    CHECK(fixed.replace_all_from(CharBuffer("aaa"), "a", "xx") == 3);
+    CHECK(fixed == "xxxxxx");
+}
+
+// The buffer itself is used as the replacement, as the source, or as both
+static void test_replace_all_aliasing()
+{
+    CharBuffer buffer("a-b");
+    buffer.set_growable(true);
+    CHECK(buffer.replace_all(CharPattern("-"), buffer) == 1);
+    CHECK(buffer == "aa-bb");
+
+    CHECK(buffer.replace_all_from(buffer, "a", "x") == 2);
+    CHECK(buffer == "xx-bb");
+    CHECK(buffer.replace_all_from(buffer, CharPattern("b"), CharBuffer("yy")) == 2);
+    CHECK(buffer == "xx-yyyy");
+    CHECK(buffer.replace_all_from(buffer, CharPattern("-"), buffer) == 1);
+    CHECK(buffer == "xxxx-yyyyyyyy");
+
+    CharBuffer target("<>");
+    target.set_growable(true);
+    CHECK(target.replace_all_from(CharBuffer("1,2,3"), CharPattern(","), target) == 2);
+    CHECK(target == "1<>2<>3");
+
+    // The pattern is compiled from the buffer that is searched
+    CharBuffer repeated("abab");
+    repeated.set_growable(true);
+    const CharPattern pattern(repeated);
+    CHECK(repeated.replace_all(pattern, CharBuffer("x")) == 1);
+    CHECK(repeated == "x");
+}
+
+// Appends each kind of argument, including views of and C strings from the buffer itself,
+// which must survive the reallocation of the buffer
+static void test_append_all()
+{
+    const CharBuffer other("buffer");
+    const CharBuffer source("<view>");
+    const CharBufferView view = source.view(1, 5);
+    CharBuffer buffer(4);
+    buffer.set_growable(true);
+    buffer.append_all(other, ' ', view, " c-string", '!');
+    CHECK(buffer == "buffer view c-string!");
+    buffer.append_all();
+    buffer.append_all("", CharBuffer(""), CharBufferView());
+    CHECK(buffer == "buffer view c-string!");
+
+    CharBuffer self("ab");
+    self.set_growable(true);
+    self.append_all(self, '-', self.view(1, 2), self.c_str());
+    CHECK(self == "abab-bab");
+
+    for (size_t round = 0; round < 200; ++round)
+    {
+        std::string expected = random_text(random_engine() % 20);
+        CharBuffer target(expected.c_str());
+        target.set_growable(true);
+        std::vector<std::string> texts;
+        for (size_t idx = random_engine() % 12; idx > 0; --idx)
+        {
+            texts.push_back(random_text(random_engine() % 40));
+        }
+        std::vector<CharBufferView> pieces;
+        for (const std::string& text : texts)
+        {
+            pieces.push_back(CharBufferView(text.c_str()));
+            expected += text;
+        }
+        target.append_views(pieces.data(), pieces.size());
+        CHECK(target == expected.c_str());
+    }
+}
+
+static void test_append_all_capacity_exceeded()
+{
+    const CharBuffer other("xyz");
+    CharBuffer buffer(8, "abcdef");
+    CHECK_THROWS(RangeException, buffer.append_all(other));
+    CHECK_THROWS(RangeException, buffer.append_all('x', CharBufferView("y"), "z"));
+    CHECK_THROWS(RangeException, buffer.append_all("x", "y", other));
+
+    // Nothing is appended if the arguments do not fit
+    CHECK(buffer == "abcdef");
+    buffer.append_all('x', CharBufferView("y"));
+    CHECK(buffer == "abcdefxy");
+    buffer.append_all("", CharBufferView());
+    CHECK_THROWS(RangeException, buffer.append_all('z'));
+    CHECK(buffer == "abcdefxy");
+    CHECK(buffer.capacity() == 8);
+}
+
+static void test_concat()
+{
+    const CharBuffer other("buffer");
+    const std::unique_ptr<CharBuffer> result = CharBuffer::concat("c-string", ' ', other, ' ', other.view(0, 3));
+    CHECK(*result == "c-string buffer buf");
+    CHECK(result->capacity() == result->length());
+
+    const std::unique_ptr<CharBuffer> empty = CharBuffer::concat();
+    CHECK(empty->is_empty());
+    CHECK(CharBuffer::concat("", CharBufferView())->is_empty());
+
+    const std::string long_text = random_text(1000);
+    const std::unique_ptr<CharBuffer> long_result = CharBuffer::concat(long_text.c_str(), '.', long_text.c_str());
+    CHECK(*long_result == (long_text + "." + long_text).c_str());
+    CHECK(long_result->capacity() == 2001);
+}
+
+int main()
+{
+    test_ends_with();
+    test_random_raw_variants();
+    test_dense_long_pattern_matches();
+    test_random_replace_all();
+    test_replace_all_errors();
+    test_replace_all_aliasing();
+    test_append_all();
+    test_append_all_capacity_exceeded();
+    test_concat();
+    return test_result("CharBufferTest");
+}
@@ -0,0 +1,124 @@
+// Compares views of random ranges of a buffer against std::string, and checks the comparison
+// of views with CharBuffer instances and C strings
+
+#include <string>
+#include <random>
+
+#include <CharBuffer.h>
+#include <CharBufferView.h>
+#include <CharPattern.h>
+#include <RangeException.h>
+
+#include "TestSupport.h"
+
+static std::mt19937 random_engine(20181021);
+
+static std::string random_text(const size_t length)
+{
+    std::string text(length, ' ');
+    for (char& letter : text)
+    {
+        letter = "abc"[random_engine() % 3];
+    }
+    return text;
+}
+
+static int sign(const int value)
+{
+    return value < 0 ? -1 : (value > 0 ? 1 : 0);
+}
+
+static void test_substring_views()
+{
+    const CharBuffer buffer("one two three");
+    const CharBufferView two = buffer.view(4, 7);
+    CHECK(two.length() == 3);
+    CHECK(two.data() == buffer.c_str() + 4);
+    CHECK(two == "two");
+    CHECK(two[2] == 'o');
+    CHECK_THROWS(RangeException, two[3]);
+
+    // A view of a view refers to the same storage, and its characters are not terminated
+    const CharBufferView whole(buffer);
+    CHECK(whole == buffer);
+    CHECK(buffer == whole);
+    const CharBufferView tw = whole.view(4, 7).view(0, 2);
+    CHECK(tw == "tw");
+    CHECK(tw.data() == buffer.c_str() + 4);
+    CHECK(tw != "two");
+    CHECK(whole.view(13, 13).is_empty());
+    CHECK_THROWS(RangeException, whole.view(5, 4));
+    CHECK_THROWS(RangeException, whole.view(0, 14));
+    CHECK_THROWS(RangeException, two.view(0, 4));
+
+    const CharBufferView empty;
+    CHECK(empty.is_empty());
+    CHECK(empty == "");
+    CHECK(empty == CharBuffer(16));
+}
+
+static void test_random_views()
+{
+    for (size_t round = 0; round < 1000; ++round)
+    {
+        const std::string text = random_text(random_engine() % 80);
+        const CharBuffer buffer(text.c_str());
+        const size_t start = random_engine() % (text.length() + 1);
+        const size_t end = start + random_engine() % (text.length() - start + 1);
+        const CharBufferView view = buffer.view(start, end);
+        const std::string expected = text.substr(start, end - start);
+        CHECK(view.length() == expected.length());
+
+        const std::string other = round % 2 == 0 ? random_text(random_engine() % 4) : expected.substr(0, 2);
+        const CharBuffer other_buffer(other.c_str());
+        const CharBufferView other_view(other_buffer);
+
+        // Comparison, against each kind of operand
+        const int expected_order = sign(expected.compare(other));
+        CHECK(sign(view.compare_to(other_view)) == expected_order);
+        CHECK(sign(view.compare_to(other_buffer)) == expected_order);
+        CHECK(sign(view.compare_to(other.c_str())) == expected_order);
+        CHECK((view == other_view) == (expected == other));
+        CHECK((view == other_buffer) == (expected == other));
+        CHECK((other_buffer == view) == (expected == other));
+        CHECK((view == other.c_str()) == (expected == other));
+        CHECK((view != other.c_str()) == (expected != other));
+        CHECK((view < other_view) == (expected < other));
+        CHECK((view >= other_view) == (expected >= other));
+
+        const bool expected_prefix = expected.compare(0, other.length(), other) == 0 &&
+            other.length() <= expected.length();
+        CHECK(view.starts_with(other_view) == expected_prefix);
+        CHECK(view.starts_with(other_buffer) == expected_prefix);
+        CHECK(view.starts_with(other.c_str()) == expected_prefix);
+
+        const bool expected_suffix = other.length() <= expected.length() &&
+            expected.compare(expected.length() - other.length(), other.length(), other) == 0;
+        CHECK(view.ends_with(other_view) == expected_suffix);
+        CHECK(view.ends_with(other_buffer) == expected_suffix);
+        CHECK(view.ends_with(other.c_str()) == expected_suffix);
+
+        // Searches stay within the view, although the buffer continues after it
+        const size_t search_start = random_engine() % (expected.length() + 1);
+        const CharPattern pattern(other_buffer);
+        const size_t expected_index = expected.find(other, search_start);
+        CHECK(view.index_of(other_view) == expected.find(other));
+        CHECK(view.index_of(other_view, search_start) == expected_index);
+        CHECK(view.index_of(other_buffer, search_start) == expected_index);
+        CHECK(view.index_of(other.c_str(), search_start) == expected_index);
+        CHECK(view.index_of(pattern) == expected.find(other));
+        CHECK(view.index_of(pattern, search_start) == expected_index);
+        CHECK(view.index_of('c') == expected.find('c'));
+        CHECK(view.index_of('c', search_start) == expected.find('c', search_start));
+        CHECK_THROWS(RangeException, view.index_of('c', expected.length() + 1));
+        CHECK_THROWS(RangeException, view.index_of(other_view, expected.length() + 1));
+        CHECK_THROWS(RangeException, view.index_of(pattern, expected.length() + 1));
+    }
+}
+
+int main()
+{
+    test_substring_views();
+    test_random_views();
+    return test_result("CharBufferViewTest");
+}
@@ -0,0 +1,232 @@
+// Throughput of each kernel set that the CPU supports, and of the CharBuffer operations that are
+// based on them, compared with the byte-at-a-time loops that they replaced
+// Each measurement repeats an operation on the same data, which therefore stays in the cache for
+// the shorter lengths, until MIN_DURATION has passed, and reports the processed bytes per second.
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <functional>
+
+#include <CharBuffer.h>
+#include <CharKernels.h>
+
+static const char* const ISA_NAMES[] = {"scalar", "sse2", "avx2", "avx512"};
+
+static const size_t LENGTHS[] = {16, 64, 256, 4096, 65536, 1048576};
+
+static const std::chrono::duration<double> MIN_DURATION(0.05);
+
+// Results are accumulated here, so that the compiler cannot discard the measured operations
+static volatile size_t result_sink;
+
+// The loops that the kernels replaced, kept as byte loops regardless of the optimization level
+#define BYTE_LOOP __attribute__((noinline, optimize("no-tree-loop-distribute-patterns", "no-tree-vectorize")))
+
+BYTE_LOOP static size_t loop_find_char(const char* const data, const size_t length, const char letter)
+{
+    size_t idx = 0;
+    while (idx < length && data[idx] != letter)
+    {
+        ++idx;
+    }
+    return idx;
+}
+
+BYTE_LOOP static bool loop_match(const char* const data, const char* const other_data, const size_t length)
+{
+    size_t idx = 0;
+    while (idx < length && data[idx] == other_data[idx])
+    {
+        ++idx;
+    }
+    return idx == length;
+}
+
+BYTE_LOOP static int loop_compare(const char* const data, const char* const other_data, const size_t length)
+{
+    int result = 0;
+    for (size_t idx = 0; idx < length && result == 0; ++idx)
+    {
+        if (data[idx] != other_data[idx])
+        {
+            result = data[idx] < other_data[idx] ? -1 : 1;
+        }
+    }
+    return result;
+}
+
+BYTE_LOOP static void loop_copy(const char* const src_data, const size_t length, char* const dst_data)
+{
+    for (size_t idx = 0; idx < length; ++idx)
+    {
+        dst_data[idx] = src_data[idx];
+    }
+    dst_data[length] = '\0';
+}
+
+BYTE_LOOP static size_t loop_c_str_length(const char* const text)
+{
+    size_t length = 0;
+    while (text[length] != '\0')
+    {
+        ++length;
+    }
+    return length;
+}
+
+// Returns the throughput of operation, which processes length bytes per call, in GB/s
+static double measure(const size_t length, const std::function<size_t()>& operation)
+{
+    typedef std::chrono::steady_clock clock;
+    size_t call_count = 0;
+    size_t result = 0;
+    const clock::time_point start_time = clock::now();
+    std::chrono::duration<double> duration(0);
+    while (duration < MIN_DURATION)
+    {
+        for (size_t idx = 0; idx < 64; ++idx)
+        {
+            result += operation();
+        }
+        call_count += 64;
+        duration = clock::now() - start_time;
+    }
+    result_sink = result;
+    return static_cast<double> (length) * static_cast<double> (call_count) / duration.count() / 1e9;
+}
+
+static void report(const char* const operation_name, const char* const variant, const size_t length, const double rate)
+{
+    std::printf("%-24s %-8s %9zu %10.2f\n", operation_name, variant, length, rate);
+}
+
+// Equal texts of the specified length, so that the compare and match operations scan all of it
+class BenchmarkData
+{
+  public:
+    explicit BenchmarkData(const size_t length):
+        text(length, 'a'),
+        buffer(text.c_str()),
+        other_buffer(text.c_str()),
+        target(length + 1)
+    {
+    }
+
+    std::string text;
+    CharBuffer buffer;
+    CharBuffer other_buffer;
+    CharBuffer target;
+};
+
+// Operations whose implementation is selected through CharKernels
+static void run_kernel_benchmarks(const char* const isa_name, const size_t length)
+{
+    BenchmarkData data(length);
+    const char* const text = data.text.c_str();
+    const std::string pattern = std::string(7, 'a') + "b";
+
+    report("find_char", isa_name, length, measure(
+        length,
+        [&] { return CharKernels::find_char(text, 0, length, 'b'); }
+    ));
+    report("find_substring", isa_name, length, measure(
+        length,
+        [&] { return CharKernels::find_substring(text, 0, length, pattern.c_str(), pattern.length()); }
+    ));
+    report("find_mismatch", isa_name, length, measure(
+        length,
+        [&] { return CharKernels::find_mismatch(text, data.other_buffer.c_str(), length); }
+    ));
+    report("find_terminator", isa_name, length, measure(
+        length,
+        [&] { return CharKernels::find_terminator(text, length + 1); }
+    ));
+    report("operator== (match)", isa_name, length, measure(
+        length,
+        [&] { return static_cast<size_t> (data.buffer == data.other_buffer); }
+    ));
+    report("compare_to (compare)", isa_name, length, measure(
+        length,
+        [&] { return static_cast<size_t> (data.buffer.compare_to(data.other_buffer) + 1); }
+    ));
+    report("ends_with (match)", isa_name, length, measure(
+        length,
+        [&] { return static_cast<size_t> (data.buffer.ends_with(data.other_buffer)); }
+    ));
+}
+
+// The loops that the kernels replaced
+static void run_loop_benchmarks(const size_t length)
+{
+    BenchmarkData data(length);
+    const char* const text = data.text.c_str();
+    const char* const other_text = data.other_buffer.c_str();
+
+    report("find_char", "loop", length, measure(
+        length,
+        [&] { return loop_find_char(text, length, 'b'); }
+    ));
+    report("find_terminator", "loop", length, measure(
+        length,
+        [&] { return loop_c_str_length(text); }
+    ));
+    report("operator== (match)", "loop", length, measure(
+        length,
+        [&] { return static_cast<size_t> (loop_match(text, other_text, length)); }
+    ));
+    report("compare_to (compare)", "loop", length, measure(
+        length,
+        [&] { return static_cast<size_t> (loop_compare(text, other_text, length) + 1); }
+    ));
+}
+
+// Copies are based on std::memmove, which does not depend on the selected kernels
+static void run_copy_benchmarks(const size_t length)
+{
+    BenchmarkData data(length);
+    std::vector<char> target_storage(length + 1);
+    char* const target_data = target_storage.data();
+
+    report("copy", "loop", length, measure(
+        length,
+        [&] { loop_copy(data.text.c_str(), length, target_data); return static_cast<size_t> (target_data[0]); }
+    ));
+    report("copy", "memmove", length, measure(
+        length,
+        [&] { std::memmove(target_data, data.text.c_str(), length); return static_cast<size_t> (target_data[0]); }
+    ));
+    report("substring_from", "memmove", length, measure(
+        length,
+        [&] { data.target.substring_from(data.buffer, 0, length); return data.target.length(); }
+    ));
+    report("operator=", "memmove", length, measure(
+        length,
+        [&] { data.target = data.buffer; return data.target.length(); }
+    ));
+    report("append", "memmove", length, measure(
+        length,
+        [&] { data.target.clear(); data.target.append(data.buffer, 0, length); return data.target.length(); }
+    ));
+}
+
+int main()
+{
+    std::printf("%-24s %-8s %9s %10s\n", "operation", "variant", "length", "GB/s");
+    for (const size_t length : LENGTHS)
+    {
+        run_loop_benchmarks(length);
+        for (const char* const isa_name : ISA_NAMES)
+        {
+            if (CharKernels::select_isa(isa_name))
+            {
+                run_kernel_benchmarks(isa_name, length);
+            }
+        }
+        run_copy_benchmarks(length);
+    }
+    return EXIT_SUCCESS;
+}
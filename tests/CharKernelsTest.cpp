@@ -0,0 +1,449 @@
+// Compares each kernel set that the CPU supports against plain loops, the way the kernels'
+// operations were implemented before they were vectorized, across alignments, lengths and
+// start and end offsets
+// The data is placed at the end of its allocation, followed only by space for a terminator, so
+// that reads beyond the end of the range are reported when the tests are built with an address
+// sanitizer.
+
+#include <random>
+#include <algorithm>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <CharKernels.h>
+#include <RangeException.h>
+
+#include "TestSupport.h"
+
+static const char* const ISA_NAMES[] = {"scalar", "sse2", "avx2", "avx512"};
+
+// Alignments relative to the start of an allocation, covering all positions within a 64 byte block
+static const size_t MAX_ALIGNMENT = 64;
+
+// Lengths up to this one are tested at every alignment, longer ones at a few alignments only
+static const size_t SHORT_LENGTH_LIMIT = 140;
+
+static const size_t LONG_LENGTHS[] = {191, 192, 193, 255, 256, 257, 511, 1000, 4099};
+static const size_t LONG_ALIGNMENTS[] = {0, 1, 31, 63};
+
+// Data placed at a specific alignment at the end of an allocation, followed by one spare character
+class TestData
+{
+  public:
+    explicit TestData(const size_t alignment, const size_t length):
+        storage(new char[alignment + length + 1]),
+        data_length(length)
+    {
+        data_ptr = storage.get() + alignment;
+    }
+
+    char* data() noexcept
+    {
+        return data_ptr;
+    }
+
+    size_t length() const noexcept
+    {
+        return data_length;
+    }
+
+  private:
+    std::unique_ptr<char[]> storage;
+    char* data_ptr;
+    size_t data_length;
+};
+
+static std::mt19937 random_engine(20181016);
+
+static void fill_random(char* const data, const size_t length, const char* const alphabet, const size_t alphabet_length)
+{
+    for (size_t idx = 0; idx < length; ++idx)
+    {
+        data[idx] = alphabet[random_engine() % alphabet_length];
+    }
+}
+
+// Calls test(alignment, length) for each combination that is tested
+template<typename Test>
+static void for_each_layout(Test&& test)
+{
+    for (size_t length = 0; length <= SHORT_LENGTH_LIMIT; ++length)
+    {
+        for (size_t alignment = 0; alignment < MAX_ALIGNMENT; ++alignment)
+        {
+            test(alignment, length);
+        }
+    }
+    for (const size_t length : LONG_LENGTHS)
+    {
+        for (const size_t alignment : LONG_ALIGNMENTS)
+        {
+            test(alignment, length);
+        }
+    }
+}
+
+// Start and end offsets that are tested for a range of the specified length
+static std::vector<size_t> boundary_offsets(const size_t length)
+{
+    static const size_t OFFSETS[] = {0, 1, 2, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65};
+    std::vector<size_t> offsets;
+    for (const size_t offset : OFFSETS)
+    {
+        if (offset <= length)
+        {
+            offsets.push_back(offset);
+        }
+    }
+    return offsets;
+}
+
+static char ascii_lower(const char letter)
+{
+    return letter >= 'A' && letter <= 'Z' ? static_cast<char> (letter - 'A' + 'a') : letter;
+}
+
+static size_t loop_find_char(const char* const data, const size_t start, const size_t end, const char letter)
+{
+    size_t idx = start;
+    while (idx < end && data[idx] != letter)
+    {
+        ++idx;
+    }
+    return idx;
+}
+
+static size_t loop_find_last_char(const char* const data, const size_t start, const size_t end, const char letter)
+{
+    size_t idx = end;
+    while (idx > start && data[idx - 1] != letter)
+    {
+        --idx;
+    }
+    return idx > start ? idx - 1 : end;
+}
+
+static size_t loop_count_char(const char* const data, const size_t start, const size_t end, const char letter)
+{
+    size_t count = 0;
+    for (size_t idx = start; idx < end; ++idx)
+    {
+        if (data[idx] == letter)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+static bool loop_matches_at(
+    const char* const data,
+    const char* const pattern,
+    const size_t pat_length,
+    const bool ignore_case
+)
+{
+    size_t idx = 0;
+    while (idx < pat_length &&
+        (ignore_case ? ascii_lower(data[idx]) == ascii_lower(pattern[idx]) : data[idx] == pattern[idx]))
+    {
+        ++idx;
+    }
+    return idx == pat_length;
+}
+
+static size_t loop_find_substring(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length,
+    const bool ignore_case
+)
+{
+    size_t index = end;
+    for (size_t idx = start; idx + pat_length <= end && index == end; ++idx)
+    {
+        if (loop_matches_at(&(data[idx]), pattern, pat_length, ignore_case))
+        {
+            index = idx;
+        }
+    }
+    return index;
+}
+
+static size_t loop_find_last_substring(
+    const char* const data,
+    const size_t start,
+    const size_t end,
+    const char* const pattern,
+    const size_t pat_length
+)
+{
+    size_t index = end;
+    for (size_t idx = start; idx + pat_length <= end; ++idx)
+    {
+        if (loop_matches_at(&(data[idx]), pattern, pat_length, false))
+        {
+            index = idx;
+        }
+    }
+    return index;
+}
+
+static size_t loop_find_mismatch(
+    const char* const data,
+    const char* const other_data,
+    const size_t length,
+    const bool ignore_case
+)
+{
+    size_t idx = 0;
+    while (idx < length &&
+        (ignore_case ? ascii_lower(data[idx]) == ascii_lower(other_data[idx]) : data[idx] == other_data[idx]))
+    {
+        ++idx;
+    }
+    return idx;
+}
+
+static void test_find_char()
+{
+    for_each_layout(
+        [](const size_t alignment, const size_t length)
+        {
+            TestData text(alignment, length);
+            char* const data = text.data();
+            // Sparse data with at most one match, then dense data with many matches
+            std::memset(data, 'x', length);
+            if (length > 0 && random_engine() % 4 != 0)
+            {
+                data[random_engine() % length] = 'a';
+            }
+            for (size_t pass = 0; pass < 2; ++pass)
+            {
+                for (const size_t start : boundary_offsets(length))
+                {
+                    for (const size_t end_offset : boundary_offsets(length - start))
+                    {
+                        const size_t end = length - end_offset;
+                        CHECK(CharKernels::find_char(data, start, end, 'a') == loop_find_char(data, start, end, 'a'));
+                        CHECK(CharKernels::find_last_char(data, start, end, 'a') ==
+                            loop_find_last_char(data, start, end, 'a'));
+                        CHECK(CharKernels::count_char(data, start, end, 'a') == loop_count_char(data, start, end, 'a'));
+                    }
+                }
+                fill_random(data, length, "abc\x80\xff", 5);
+            }
+            // Characters with the high bit set must not be confused with other characters
+            CHECK(CharKernels::find_char(data, 0, length, '\xff') == loop_find_char(data, 0, length, '\xff'));
+            CHECK(CharKernels::count_char(data, 0, length, '\x80') == loop_count_char(data, 0, length, '\x80'));
+        }
+    );
+}
+
+static void test_find_substring()
+{
+    static const size_t PAT_LENGTHS[] = {1, 2, 3, 5, 16, 17, 32, 33, 40};
+    for_each_layout(
+        [](const size_t alignment, const size_t length)
+        {
+            TestData text(alignment, length);
+            char* const data = text.data();
+            fill_random(data, length, "abAB", length % 3 == 0 ? 4 : 2);
+            for (const size_t pat_length : PAT_LENGTHS)
+            {
+                std::vector<char> pattern(pat_length);
+                if (length >= pat_length && random_engine() % 2 == 0)
+                {
+                    // A pattern taken from the data, so that there is at least one match
+                    std::memcpy(pattern.data(), &(data[random_engine() % (length - pat_length + 1)]), pat_length);
+                }
+                else
+                {
+                    fill_random(pattern.data(), pat_length, "ab", 2);
+                }
+                const char* const pat_data = pattern.data();
+                for (const size_t start : boundary_offsets(length))
+                {
+                    const size_t end = length - (random_engine() % 2 == 0 ? 0 : (length - start) / 2);
+                    if (pat_length >= 2)
+                    {
+                        CHECK(CharKernels::find_substring(data, start, end, pat_data, pat_length) ==
+                            loop_find_substring(data, start, end, pat_data, pat_length, false));
+                        CHECK(CharKernels::find_last_substring(data, start, end, pat_data, pat_length) ==
+                            loop_find_last_substring(data, start, end, pat_data, pat_length));
+                    }
+                    CHECK(CharKernels::find_substring_icase(data, start, end, pat_data, pat_length) ==
+                        loop_find_substring(data, start, end, pat_data, pat_length, true));
+                }
+            }
+        }
+    );
+}
+
+static void test_find_mismatch()
+{
+    for_each_layout(
+        [](const size_t alignment, const size_t length)
+        {
+            TestData text(alignment, length);
+            TestData other_text((alignment * 7) % MAX_ALIGNMENT, length);
+            char* const data = text.data();
+            char* const other_data = other_text.data();
+            fill_random(data, length, "aAzZ@[`{\xc1", 9);
+            for (size_t idx = 0; idx < length; ++idx)
+            {
+                other_data[idx] = random_engine() % 2 == 0 ? data[idx] : static_cast<char> (data[idx] ^ 0x20);
+            }
+            CHECK(CharKernels::find_mismatch_icase(data, other_data, length) ==
+                loop_find_mismatch(data, other_data, length, true));
+            std::memcpy(other_data, data, length);
+            CHECK(CharKernels::find_mismatch(data, other_data, length) == length);
+            CHECK(CharKernels::compare(data, length, other_data, length) == 0);
+            if (length > 0)
+            {
+                CHECK(CharKernels::compare(data, length, other_data, length - 1) == 1);
+                CHECK(CharKernels::compare(data, length - 1, other_data, length) == -1);
+                const size_t diff_idx = random_engine() % length;
+                other_data[diff_idx] = static_cast<char> (other_data[diff_idx] + 1);
+                CHECK(CharKernels::find_mismatch(data, other_data, length) ==
+                    loop_find_mismatch(data, other_data, length, false));
+                CHECK(CharKernels::compare(data, length, other_data, length) ==
+                    (data[diff_idx] < other_data[diff_idx] ? -1 : 1));
+                CHECK(CharKernels::find_mismatch_icase(data, other_data, length) ==
+                    loop_find_mismatch(data, other_data, length, true));
+            }
+        }
+    );
+}
+
+static void test_change_case()
+{
+    for_each_layout(
+        [](const size_t alignment, const size_t length)
+        {
+            TestData text(alignment, length);
+            char* const data = text.data();
+            fill_random(data, length, "aAzZ@[`{\x7f\xc1\xe1", 11);
+            std::vector<char> expected(data, data + length);
+            for (char& letter : expected)
+            {
+                letter = ascii_lower(letter);
+            }
+            CharKernels::to_lower(data, length);
+            CHECK(std::equal(expected.begin(), expected.end(), data));
+            for (char& letter : expected)
+            {
+                letter = letter >= 'a' && letter <= 'z' ? static_cast<char> (letter - 'a' + 'A') : letter;
+            }
+            CharKernels::to_upper(data, length);
+            CHECK(std::equal(expected.begin(), expected.end(), data));
+        }
+    );
+}
+
+static void test_match_set()
+{
+    CharKernels::CharSet single_set;
+    CharKernels::prepare_set(",", 1, single_set);
+    CharKernels::CharSet multi_set;
+    CharKernels::prepare_set(",;\t\xe9", 4, multi_set);
+    for_each_layout(
+        [&](const size_t alignment, const size_t length)
+        {
+            TestData text(alignment, length);
+            char* const data = text.data();
+            fill_random(data, length, "ab,;\t\xe9\x69", 7);
+            for (size_t block_start = 0; block_start < length; block_start += CharKernels::MATCH_BLOCK_LENGTH)
+            {
+                const size_t block_length = length - block_start;
+                uint64_t single_expected = 0;
+                uint64_t multi_expected = 0;
+                for (size_t idx = 0; idx < block_length && idx < CharKernels::MATCH_BLOCK_LENGTH; ++idx)
+                {
+                    const char letter = data[block_start + idx];
+                    if (letter == ',')
+                    {
+                        single_expected |= static_cast<uint64_t> (1) << idx;
+                    }
+                    if (letter == ',' || letter == ';' || letter == '\t' || letter == '\xe9')
+                    {
+                        multi_expected |= static_cast<uint64_t> (1) << idx;
+                    }
+                }
+                CHECK(CharKernels::match_set(&(data[block_start]), block_length, single_set) == single_expected);
+                CHECK(CharKernels::match_set(&(data[block_start]), block_length, multi_set) == multi_expected);
+            }
+        }
+    );
+}
+
+static void test_find_terminator()
+{
+    for_each_layout(
+        [](const size_t alignment, const size_t length)
+        {
+            TestData text(alignment, length);
+            char* const data = text.data();
+            fill_random(data, length, "ab", 2);
+            data[length] = '\0';
+            CHECK(CharKernels::find_terminator(data, length + 1) == length);
+            CHECK(CharKernels::find_terminator(data, length) == length);
+            CHECK(CharKernels::bounded_c_str_length(data, length) == length);
+            if (length > 0)
+            {
+                CHECK(CharKernels::find_terminator(data, length / 2) == length / 2);
+                CHECK_THROWS(RangeException, CharKernels::bounded_c_str_length(data, length - 1));
+            }
+        }
+    );
+
+    // Strings that end at the end of a page must not cause reads from the following page,
+    // which is made inaccessible
+    const size_t page_size = static_cast<size_t> (sysconf(_SC_PAGESIZE));
+    void* const pages = mmap(nullptr, 2 * page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (CHECK(pages != MAP_FAILED))
+    {
+        char* const page = static_cast<char*> (pages);
+        CHECK(mprotect(page + page_size, page_size, PROT_NONE) == 0);
+        std::memset(page, 'a', page_size);
+        for (size_t length = 0; length < 2 * MAX_ALIGNMENT + 1; ++length)
+        {
+            char* const data = page + page_size - length - 1;
+            data[length] = '\0';
+            CHECK(CharKernels::find_terminator(data, page_size) == length);
+            data[length] = 'a';
+        }
+        munmap(pages, 2 * page_size);
+    }
+}
+
+int main()
+{
+    for (const char* const isa_name : ISA_NAMES)
+    {
+        if (CharKernels::select_isa(isa_name))
+        {
+            CHECK(std::strcmp(CharKernels::isa_name(), isa_name) == 0);
+            test_find_char();
+            test_find_substring();
+            test_find_mismatch();
+            test_change_case();
+            test_match_set();
+            test_find_terminator();
+            std::printf("CharKernelsTest: tested the %s kernels\n", isa_name);
+        }
+        else
+        {
+            std::printf("CharKernelsTest: the %s kernels are not supported, skipped\n", isa_name);
+        }
+    }
+    CHECK(!CharKernels::select_isa("unknown"));
+    return test_result("CharKernelsTest");
+}
@@ -0,0 +1,91 @@
+// Compares the Aho-Corasick automaton against a plain search for each of the patterns
+
+#include <string>
+#include <random>
+#include <vector>
+
+#include <CharBuffer.h>
+#include <CharMultiPattern.h>
+
+#include "TestSupport.h"
+
+static std::mt19937 random_engine(20181018);
+
+static std::string random_text(const size_t length)
+{
+    std::string text(length, ' ');
+    for (char& letter : text)
+    {
+        letter = "abc"[random_engine() % 3];
+    }
+    return text;
+}
+
+static void test_random_patterns()
+{
+    for (size_t round = 0; round < 200; ++round)
+    {
+        const std::string text = random_text(random_engine() % 500);
+        std::vector<std::string> patterns;
+        const size_t pattern_count = 1 + random_engine() % 8;
+        for (size_t idx = 0; idx < pattern_count; ++idx)
+        {
+            patterns.push_back(random_text(random_engine() % 6));
+        }
+        std::vector<const char*> pattern_texts;
+        for (const std::string& pattern : patterns)
+        {
+            pattern_texts.push_back(pattern.c_str());
+        }
+        const CharMultiPattern automaton(pattern_texts);
+        CHECK(automaton.pattern_count() == pattern_count);
+
+        // Number of matches of all patterns, and the leftmost, shortest match
+        size_t expected_count = 0;
+        size_t leftmost_index = CharBuffer::NPOS;
+        size_t leftmost_length = 0;
+        for (size_t idx = 0; idx < pattern_count; ++idx)
+        {
+            const std::string& pattern = patterns[idx];
+            for (size_t pos = 0; !pattern.empty() && pos + pattern.length() <= text.length(); ++pos)
+            {
+                if (text.compare(pos, pattern.length(), pattern) == 0)
+                {
+                    ++expected_count;
+                    if (pos < leftmost_index || (pos == leftmost_index && pattern.length() < leftmost_length))
+                    {
+                        leftmost_index = pos;
+                        leftmost_length = pattern.length();
+                    }
+                }
+            }
+        }
+
+        const CharBuffer subject(text.c_str());
+        std::vector<CharMultiPattern::Match> matches;
+        automaton.find_all_in(subject, matches);
+        CHECK(matches.size() == expected_count);
+        size_t prev_end = 0;
+        for (const CharMultiPattern::Match& match : matches)
+        {
+            const std::string& pattern = patterns[match.pattern_id];
+            CHECK(text.compare(match.index, pattern.length(), pattern) == 0);
+            CHECK(match.index + pattern.length() >= prev_end);
+            prev_end = match.index + pattern.length();
+        }
+
+        size_t pattern_id = pattern_count;
+        const size_t index = automaton.find_in(subject, 0, pattern_id);
+        CHECK(index == leftmost_index);
+        if (index != CharBuffer::NPOS)
+        {
+            CHECK(patterns[pattern_id].length() == leftmost_length);
+        }
+    }
+}
+
+int main()
+{
+    test_random_patterns();
+    return test_result("CharMultiPatternTest");
+}
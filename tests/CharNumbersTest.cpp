@@ -0,0 +1,382 @@
+// Checks the numbers that CharBuffer appends against snprintf, round-trips random doubles through
+// format_double() and parse_double(), and compares parse_double() with strtod, including numbers
+// that are exactly or almost halfway between two doubles
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <random>
+#include <vector>
+
+#include <CharBuffer.h>
+#include <CharNumbers.h>
+#include <RangeException.h>
+
+#include "TestSupport.h"
+
+static std::mt19937_64 random_engine(20181025);
+
+static uint64_t bits_of(const double value)
+{
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof (bits));
+    return bits;
+}
+
+static double double_of(const uint64_t bits)
+{
+    double value = 0.0;
+    std::memcpy(&value, &bits, sizeof (value));
+    return value;
+}
+
+static bool parses_to(const std::string& text, const double expected)
+{
+    double value = 0.0;
+    return CharNumbers::parse_double(text.c_str(), text.length(), value) && bits_of(value) == bits_of(expected);
+}
+
+static bool rejects(const std::string& text)
+{
+    double value = 1.5;
+    return !CharNumbers::parse_double(text.c_str(), text.length(), value) && value == 1.5;
+}
+
+// Returns the exact decimal representation of significand * 2^exponent
+static std::string exact_decimal(const uint64_t significand, const int exponent)
+{
+    // Decimal digits, least significant first
+    std::vector<int> digits;
+    for (uint64_t rest = significand; rest > 0; rest /= 10)
+    {
+        digits.push_back(static_cast<int> (rest % 10));
+    }
+    // Multiplies by 2 for a positive exponent, and by 5 for a negative one, whose fraction digits
+    // are then separated by the point
+    const int factor = exponent >= 0 ? 2 : 5;
+    for (int idx = 0; idx < std::abs(exponent); ++idx)
+    {
+        int carry = 0;
+        for (int& digit : digits)
+        {
+            const int product = digit * factor + carry;
+            digit = product % 10;
+            carry = product / 10;
+        }
+        if (carry > 0)
+        {
+            digits.push_back(carry);
+        }
+    }
+    const size_t fraction_length = exponent < 0 ? static_cast<size_t> (-exponent) : 0;
+    while (digits.size() <= fraction_length)
+    {
+        digits.push_back(0);
+    }
+    std::string text;
+    for (size_t idx = digits.size(); idx > 0; --idx)
+    {
+        if (idx == fraction_length)
+        {
+            text += '.';
+        }
+        text += static_cast<char> ('0' + digits[idx - 1]);
+    }
+    return text;
+}
+
+static void test_append_integers()
+{
+    const std::vector<long long> values = {
+        0, 1, -1, 9, 10, 99, 100, -100, 1234567890, std::numeric_limits<long long>::max(),
+        std::numeric_limits<long long>::min(), std::numeric_limits<long long>::min() + 1
+    };
+    char expected[64];
+    for (size_t idx = 0; idx < 10000; ++idx)
+    {
+        long long value = idx < values.size() ? values[idx] : static_cast<long long> (random_engine());
+        if (idx >= values.size() && idx % 2 == 0)
+        {
+            // Values of every length
+            value >>= random_engine() % 64;
+        }
+        CharBuffer buffer(4, "<");
+        buffer.set_growable(true);
+        buffer.append_int(value);
+        std::snprintf(expected, sizeof (expected), "<%lld", value);
+        CHECK(buffer == expected);
+
+        const unsigned long long unsigned_value = static_cast<unsigned long long> (value);
+        buffer.clear();
+        buffer.append_uint(unsigned_value);
+        std::snprintf(expected, sizeof (expected), "%llu", unsigned_value);
+        CHECK(buffer == expected);
+
+        buffer.clear();
+        buffer.append_hex(unsigned_value);
+        std::snprintf(expected, sizeof (expected), "%llx", unsigned_value);
+        CHECK(buffer == expected);
+
+        long long parsed = 0;
+        buffer.clear();
+        buffer.append_int(value);
+        CHECK(buffer.parse_int(0, buffer.length(), parsed) && parsed == value);
+    }
+
+    CharBuffer full(4, "ab");
+    CHECK_THROWS(RangeException, full.append_int(-10));
+    CHECK_THROWS(RangeException, full.append_uint(123));
+    CHECK_THROWS(RangeException, full.append_hex(0xabc));
+    CHECK_THROWS(RangeException, full.append_double(0.5));
+    CHECK(full == "ab");
+    full.append_int(-1);
+    CHECK(full == "ab-1");
+}
+
+static void test_parse_int()
+{
+    long long value = 0;
+    CHECK(CharNumbers::parse_int("-9223372036854775808", 20, value));
+    CHECK(value == std::numeric_limits<long long>::min());
+    CHECK(CharNumbers::parse_int("9223372036854775807", 19, value));
+    CHECK(value == std::numeric_limits<long long>::max());
+    CHECK(CharNumbers::parse_int("+0012", 5, value) && value == 12);
+    CHECK(CharNumbers::parse_int("-0", 2, value) && value == 0);
+
+    // Out of range, or not an integer; the value is left unchanged
+    value = 42;
+    CHECK(!CharNumbers::parse_int("9223372036854775808", 19, value));
+    CHECK(!CharNumbers::parse_int("-9223372036854775809", 20, value));
+    CHECK(!CharNumbers::parse_int("18446744073709551616", 20, value));
+    CHECK(!CharNumbers::parse_int("100000000000000000000000", 24, value));
+    CHECK(!CharNumbers::parse_int("", 0, value));
+    CHECK(!CharNumbers::parse_int("-", 1, value));
+    CHECK(!CharNumbers::parse_int("+-1", 3, value));
+    CHECK(!CharNumbers::parse_int("1a", 2, value));
+    CHECK(!CharNumbers::parse_int(" 1", 2, value));
+    CHECK(!CharNumbers::parse_int("1.0", 3, value));
+    CHECK(value == 42);
+
+    const CharBuffer buffer("x-123y");
+    CHECK(buffer.parse_int(1, 5, value) && value == -123);
+    CHECK(!buffer.parse_int(1, 6, value));
+    CHECK(!buffer.parse_int(4, 3, value));
+    CHECK(!buffer.parse_int(1, 7, value));
+    CHECK(value == -123);
+}
+
+// Random bit patterns cover subnormal numbers and the whole exponent range
+static void test_double_round_trip()
+{
+    char text[CharNumbers::MAX_DOUBLE_LENGTH + 1];
+    for (size_t idx = 0; idx < 200000; ++idx)
+    {
+        const double value = double_of(random_engine());
+        const size_t length = CharNumbers::format_double(value, text);
+        text[length] = '\0';
+        CHECK(length <= CharNumbers::MAX_DOUBLE_LENGTH);
+        double parsed = 0.0;
+        CHECK(CharNumbers::parse_double(text, length, parsed));
+        if (std::isnan(value))
+        {
+            CHECK(std::isnan(parsed));
+        }
+        else
+        {
+            CHECK(bits_of(parsed) == bits_of(value));
+            CHECK(bits_of(std::strtod(text, nullptr)) == bits_of(value));
+        }
+    }
+
+    const std::vector<double> values = {
+        0.0, -0.0, 1.0, 0.1, 1e23, 5e-324, -5e-324, 2.2250738585072014e-308, 2.2250738585072009e-308,
+        std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()
+    };
+    for (const double value : values)
+    {
+        CharBuffer buffer(CharNumbers::MAX_DOUBLE_LENGTH);
+        buffer.append_double(value);
+        double parsed = 0.0;
+        CHECK(buffer.parse_double(0, buffer.length(), parsed) && bits_of(parsed) == bits_of(value));
+    }
+
+    CharBuffer buffer(32);
+    buffer.append_double(0.5);
+    buffer += ' ';
+    buffer.append_double(-1234.5);
+    buffer += ' ';
+    buffer.append_double(1e-7);
+    buffer += ' ';
+    buffer.append_double(-0.0);
+    buffer += ' ';
+    buffer.append_double(std::numeric_limits<double>::quiet_NaN());
+    CHECK(buffer == "0.5 -1234.5 1e-7 -0 nan");
+}
+
+static void test_parse_double_errors()
+{
+    CHECK(rejects(""));
+    CHECK(rejects("-"));
+    CHECK(rejects("."));
+    CHECK(rejects("-."));
+    CHECK(rejects("1e"));
+    CHECK(rejects("1e+"));
+    CHECK(rejects("e5"));
+    CHECK(rejects(".e5"));
+    CHECK(rejects("1.2.3"));
+    CHECK(rejects("1 "));
+    CHECK(rejects(" 1"));
+    CHECK(rejects("0x10"));
+    CHECK(rejects("infinity"));
+    CHECK(rejects("--1"));
+
+    // Numbers beyond the range of double are rejected, numbers below its precision become zero
+    CHECK(rejects("1e400"));
+    CHECK(rejects("-1e400"));
+    CHECK(rejects("1e99999999999"));
+    CHECK(rejects("1.8e308"));
+    CHECK(parses_to("1e-400", 0.0));
+    CHECK(parses_to("-1e-400", -0.0));
+    CHECK(parses_to("1e-99999999999", 0.0));
+    CHECK(parses_to("0e99999999999", 0.0));
+    CHECK(parses_to(std::string(400, '9') + "e-800", 0.0));
+
+    CHECK(parses_to("1.", 1.0));
+    CHECK(parses_to(".5", 0.5));
+    CHECK(parses_to("+.5E+1", 5.0));
+    CHECK(parses_to("-inf", -std::numeric_limits<double>::infinity()));
+    CHECK(parses_to("1.7976931348623157e308", std::numeric_limits<double>::max()));
+    CHECK(parses_to("4.9e-324", 5e-324));
+    CHECK(parses_to("2.4703282292062328e-324", 5e-324));
+    CHECK(parses_to("2.4703282292062327e-324", 0.0));
+}
+
+// Numbers with up to 40 significant digits and with hundreds of digits, which need the exact
+// comparison with the halfway point if the digits beyond the 19th matter
+static void test_parse_double_against_strtod()
+{
+    for (size_t idx = 0; idx < 200000; ++idx)
+    {
+        std::string text = random_engine() % 2 == 0 ? "" : "-";
+        const size_t digit_count = 1 + (idx % 100 == 0 ? random_engine() % 1000 : random_engine() % 40);
+        const size_t point = random_engine() % (digit_count + 1);
+        for (size_t digit_idx = 0; digit_idx < digit_count; ++digit_idx)
+        {
+            if (digit_idx == point)
+            {
+                text += '.';
+            }
+            // Long runs of nines and zeros come close to doubles and to halfway points
+            const uint64_t kind = random_engine() % 4;
+            text += static_cast<char> (kind == 0 ? '9' : (kind == 1 ? '0' : '0' + random_engine() % 10));
+        }
+        const long exponent = static_cast<long> (random_engine() % 700) - 360;
+        text += 'e' + std::to_string(exponent);
+
+        const double expected = std::strtod(text.c_str(), nullptr);
+        if (std::isinf(expected))
+        {
+            CHECK(rejects(text));
+        }
+        else
+        {
+            CHECK(parses_to(text, expected));
+        }
+    }
+}
+
+// Decimal numbers that are exactly halfway between two doubles round to even; any further digit,
+// even beyond the 800th, decides the direction
+static void test_parse_double_halfway()
+{
+    struct Case
+    {
+        uint64_t significand;
+        int exponent;
+    };
+    const uint64_t hidden_bit = static_cast<uint64_t> (1) << 52;
+    const std::vector<Case> cases = {
+        // 1 + 2^-53, between 1 and the next double
+        {hidden_bit * 2 + 1, -53},
+        // 1 + 3 * 2^-53, between the next two doubles
+        {hidden_bit * 2 + 3, -53},
+        // Half of the smallest subnormal number, and halfway between the smallest two
+        {1, -1075},
+        {3, -1075},
+        // Halfway between the largest subnormal and the smallest normal number
+        {hidden_bit * 2 - 1, -1075},
+        // Halfway between the largest double and infinity
+        {hidden_bit * 4 - 1, 970},
+        // 2^53 + 1
+        {hidden_bit * 2 + 1, 0},
+        {hidden_bit * 2 + 1, 3},
+        // Halfway points with many digits
+        {hidden_bit * 2 + 12345, -600},
+        {hidden_bit * 2 + 54321, 500}
+    };
+    for (const Case& halfway : cases)
+    {
+        const int shift = halfway.exponent + 1;
+        const double below = std::ldexp(static_cast<double> ((halfway.significand - 1) / 2), shift);
+        const uint64_t above_significand = (halfway.significand + 1) / 2;
+        const double above = above_significand == hidden_bit * 2 && shift == 971 ?
+            std::numeric_limits<double>::infinity() : std::ldexp(static_cast<double> (above_significand), shift);
+        const double even = ((halfway.significand - 1) / 2) % 2 == 0 ? below : above;
+
+        std::string text = exact_decimal(halfway.significand, halfway.exponent);
+        if (text.find('.') == std::string::npos)
+        {
+            text += '.';
+        }
+        const std::string with_zeros = text + std::string(1000, '0');
+        const std::string above_text = with_zeros + "1";
+        if (std::isinf(even))
+        {
+            CHECK(rejects(text));
+            CHECK(rejects(with_zeros));
+        }
+        else
+        {
+            CHECK(parses_to(text, even));
+            CHECK(parses_to(with_zeros, even));
+        }
+        if (std::isinf(above))
+        {
+            CHECK(rejects(above_text));
+        }
+        else
+        {
+            CHECK(parses_to(above_text, above));
+        }
+
+        // Just below the halfway point, by subtracting one unit of the last digit
+        std::string below_text = text;
+        size_t idx = below_text.length();
+        while (idx > 0 && (below_text[idx - 1] == '0' || below_text[idx - 1] == '.'))
+        {
+            if (below_text[idx - 1] == '0')
+            {
+                below_text[idx - 1] = '9';
+            }
+            --idx;
+        }
+        --below_text[idx - 1];
+        CHECK(parses_to(below_text, below));
+        CHECK(parses_to(below_text + std::string(1000, '9'), below));
+    }
+}
+
+int main()
+{
+    test_append_integers();
+    test_parse_int();
+    test_double_round_trip();
+    test_parse_double_errors();
+    test_parse_double_against_strtod();
+    test_parse_double_halfway();
+    return test_result("CharNumbersTest");
+}
@@ -0,0 +1,154 @@
+// Compares the substring search engine against a plain search for short, long and periodic
+// patterns, and checks the results for empty patterns
+
+#include <string>
+#include <random>
+#include <cstring>
+
+#include <CharBuffer.h>
+#include <CharPattern.h>
+#include <RangeException.h>
+
+#include "TestSupport.h"
+
+static std::mt19937 random_engine(20181017);
+
+static std::string random_text(const size_t length, const char* const alphabet, const size_t alphabet_length)
+{
+    std::string text(length, ' ');
+    for (char& letter : text)
+    {
+        letter = alphabet[random_engine() % alphabet_length];
+    }
+    return text;
+}
+
+// Index of the first occurrence of pattern in text at or after start, or NPOS
+static size_t plain_find(const std::string& text, const std::string& pattern, const size_t start)
+{
+    size_t index = CharBuffer::NPOS;
+    for (size_t idx = start; idx + pattern.length() <= text.length() && index == CharBuffer::NPOS; ++idx)
+    {
+        if (text.compare(idx, pattern.length(), pattern) == 0)
+        {
+            index = idx;
+        }
+    }
+    return index;
+}
+
+// Index of the last occurrence of pattern that lies within text[0, end), or NPOS
+static size_t plain_rfind(const std::string& text, const std::string& pattern, const size_t end)
+{
+    size_t index = CharBuffer::NPOS;
+    for (size_t idx = 0; idx + pattern.length() <= end; ++idx)
+    {
+        if (text.compare(idx, pattern.length(), pattern) == 0)
+        {
+            index = idx;
+        }
+    }
+    return index;
+}
+
+static void check_search(const std::string& text, const std::string& pattern)
+{
+    const CharBuffer buffer(text.c_str());
+    const CharPattern compiled(pattern.c_str());
+    const size_t starts[] = {0, 1, text.length() / 2, text.length()};
+    for (const size_t start : starts)
+    {
+        const size_t expected = plain_find(text, pattern, start);
+        CHECK(buffer.index_of(compiled, start) == expected);
+        CHECK(buffer.index_of(pattern.c_str(), start) == expected);
+        CHECK(CharPattern::find(text.c_str(), text.length(), pattern.c_str(), pattern.length(), start) == expected);
+
+        const size_t end = text.length() - start;
+        const size_t expected_last = plain_rfind(text, pattern, end);
+        CHECK(buffer.last_index_of(compiled, end) == expected_last);
+        CHECK(CharPattern::rfind(text.c_str(), end, pattern.c_str(), pattern.length()) == expected_last);
+    }
+}
+
+static void test_random_patterns()
+{
+    static const size_t PAT_LENGTHS[] = {1, 2, 3, 8, 31, 32, 33, 34, 64, 100};
+    for (size_t round = 0; round < 300; ++round)
+    {
+        const std::string text = random_text(random_engine() % 2000, "ab", 2);
+        for (const size_t pat_length : PAT_LENGTHS)
+        {
+            if (pat_length <= text.length() && round % 2 == 0)
+            {
+                check_search(text, text.substr(random_engine() % (text.length() - pat_length + 1), pat_length));
+            }
+            else
+            {
+                check_search(text, random_text(pat_length, "ab", 2));
+            }
+        }
+    }
+}
+
+static void test_periodic_patterns()
+{
+    // Worst cases for a naive search and for the shift tables of Two-Way and Horspool
+    const std::string text = std::string(5000, 'a') + "b" + std::string(3000, 'a');
+    check_search(text, std::string(40, 'a') + "b");
+    check_search(text, "b" + std::string(40, 'a'));
+    check_search(text, std::string(20, 'a') + "b" + std::string(20, 'a'));
+    check_search(text, std::string(50, 'a'));
+
+    std::string abc_text;
+    for (size_t idx = 0; idx < 1000; ++idx)
+    {
+        abc_text += "abcabd";
+    }
+    check_search(abc_text, "abcabdabcabdabcabdabcabdabcabdabcabc");
+    check_search(abc_text, "abdabcabdabcabdabcabdabcabdabcabdabcabd");
+}
+
+static void test_empty_pattern()
+{
+    // The empty pattern matches at the position where the search starts
+    const CharBuffer buffer("abcdef");
+    const CharPattern empty("");
+    CHECK(empty.length() == 0);
+    CHECK(buffer.index_of("") == 0);
+    CHECK(buffer.index_of("", 3) == 3);
+    CHECK(buffer.index_of("", 6) == 6);
+    CHECK(buffer.index_of(empty, 4) == 4);
+    CHECK(empty.find_in(buffer.c_str(), buffer.length(), 2) == 2);
+    CHECK_THROWS(RangeException, buffer.index_of("", 7));
+
+    // Searching backwards, it matches at the end of the searched range
+    CHECK(buffer.last_index_of("") == 6);
+    CHECK(buffer.last_index_of(empty, 3) == 3);
+    CHECK(empty.rfind_in(buffer.c_str(), 0) == 0);
+}
+
+static void test_pattern_text()
+{
+    const char text[] = "pattern text";
+    const CharPattern pattern(text);
+    CHECK(pattern.length() == std::strlen(text));
+    CHECK(std::strcmp(pattern.c_str(), text) == 0);
+    CHECK(pattern.c_str() != text);
+
+    const CharPattern raw_pattern("pattern", 3);
+    CHECK(raw_pattern.length() == 3);
+    CHECK(std::strcmp(raw_pattern.c_str(), "pat") == 0);
+
+    const CharBuffer buffer("buffer");
+    const CharPattern buffer_pattern(buffer);
+    CHECK(std::strcmp(buffer_pattern.c_str(), "buffer") == 0);
+}
+
+int main()
+{
+    test_random_patterns();
+    test_periodic_patterns();
+    test_empty_pattern();
+    test_pattern_text();
+    return test_result("CharPatternTest");
+}
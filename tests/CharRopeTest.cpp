@@ -0,0 +1,222 @@
+// Applies random edits to ropes and to std::string in parallel and compares the content, and
+// checks that copies and slices that share chunks are not affected by later appends
+
+#include <memory>
+#include <string>
+#include <random>
+#include <vector>
+
+#include <CharBuffer.h>
+#include <CharRope.h>
+#include <RangeException.h>
+
+#include "TestSupport.h"
+
+static std::mt19937 random_engine(20181024);
+
+static std::string random_text(const size_t length)
+{
+    std::string text(length, ' ');
+    for (char& letter : text)
+    {
+        letter = static_cast<char> ('a' + random_engine() % 26);
+    }
+    return text;
+}
+
+// Mostly short texts, which are copied into the tail chunk, and sometimes texts that are long
+// enough to get a chunk of their own
+static std::string random_piece()
+{
+    return random_text(random_engine() % 8 == 0 ? 4096 + random_engine() % 2048 : random_engine() % 40);
+}
+
+static bool matches(const CharRope& rope, const std::string& expected)
+{
+    std::string pieces;
+    rope.for_each_piece(
+        [&pieces](const CharBufferView& piece)
+        {
+            pieces.append(piece.data(), piece.length());
+        }
+    );
+    const std::unique_ptr<CharBuffer> flat = rope.flatten();
+    return rope.length() == expected.length() && rope.is_empty() == expected.empty() &&
+        pieces == expected && flat->length() == expected.length() && *flat == expected.c_str();
+}
+
+static void test_random_edits()
+{
+    std::vector<CharRope> ropes(4);
+    std::vector<std::string> expected(4);
+    for (size_t round = 0; round < 20000; ++round)
+    {
+        const size_t idx = random_engine() % ropes.size();
+        CharRope& rope = ropes[idx];
+        std::string& text = expected[idx];
+        const size_t position = random_engine() % (text.length() + 1);
+        const size_t end = position + random_engine() % (text.length() - position + 1);
+        switch (random_engine() % 10)
+        {
+            case 0:
+            {
+                const std::string piece = random_piece();
+                rope.append_raw(piece.data(), piece.length());
+                text += piece;
+                break;
+            }
+            case 1:
+            {
+                const char letter = static_cast<char> ('A' + random_engine() % 26);
+                rope += letter;
+                text += letter;
+                break;
+            }
+            case 2:
+            {
+                const std::string piece = random_piece();
+                rope.insert_raw(position, piece.data(), piece.length());
+                text.insert(position, piece);
+                break;
+            }
+            case 3:
+            {
+                rope.erase(position, end);
+                text.erase(position, end - position);
+                break;
+            }
+            case 4:
+            {
+                // Slices share the pieces of the original, including its pending tail
+                const CharRope slice = rope.slice(position, end);
+                CHECK(matches(slice, text.substr(position, end - position)));
+                const size_t other_idx = random_engine() % ropes.size();
+                ropes[other_idx] = slice;
+                expected[other_idx] = text.substr(position, end - position);
+                break;
+            }
+            case 5:
+            {
+                const size_t other_idx = random_engine() % ropes.size();
+                const CharRope other = ropes[other_idx];
+                rope.insert(position, other);
+                text.insert(position, expected[other_idx]);
+                break;
+            }
+            case 6:
+            {
+                const size_t other_idx = random_engine() % ropes.size();
+                const CharRope other = ropes[other_idx];
+                rope.append(other);
+                text += expected[other_idx];
+                break;
+            }
+            case 7:
+            {
+                // A copy shares the tail chunk of the original, and both continue to append
+                const size_t other_idx = random_engine() % ropes.size();
+                ropes[other_idx] = rope;
+                expected[other_idx] = text;
+                break;
+            }
+            case 8:
+            {
+                if (!text.empty())
+                {
+                    const size_t index = random_engine() % text.length();
+                    CHECK(rope[index] == text[index]);
+                }
+                CHECK_THROWS(RangeException, rope[text.length()]);
+                break;
+            }
+            default:
+            {
+                if (text.length() > 100000)
+                {
+                    rope.clear();
+                    text.clear();
+                }
+                break;
+            }
+        }
+        CHECK(rope.length() == text.length());
+        if (round % 100 == 0)
+        {
+            for (size_t check_idx = 0; check_idx < ropes.size(); ++check_idx)
+            {
+                CHECK(matches(ropes[check_idx], expected[check_idx]));
+            }
+        }
+    }
+    for (size_t check_idx = 0; check_idx < ropes.size(); ++check_idx)
+    {
+        CHECK(matches(ropes[check_idx], expected[check_idx]));
+        for (size_t index = 0; index < expected[check_idx].length(); index += 7)
+        {
+            CHECK(ropes[check_idx][index] == expected[check_idx][index]);
+        }
+    }
+}
+
+static void test_copy_divergence()
+{
+    CharRope original("shared");
+    original += " tail";
+    CHECK(original.piece_count() == 1);
+
+    // The copy refers to the pending tail of the original, whose chunk has room for both appends
+    CharRope copy(original);
+    CharRope assigned;
+    assigned = original;
+    const CharRope slice = original.slice(2, 8);
+    original += " original";
+    copy += " copy";
+    assigned += 'x';
+    CHECK(matches(original, "shared tail original"));
+    CHECK(matches(copy, "shared tail copy"));
+    CHECK(matches(assigned, "shared tailx"));
+    CHECK(matches(slice, "ared t"));
+    CHECK(original.piece_count() == 1);
+
+    original.insert(0, "> ");
+    copy.erase(0, 7);
+    CHECK(matches(original, "> shared tail original"));
+    CHECK(matches(copy, "tail copy"));
+    CHECK(matches(assigned, "shared tailx"));
+
+    // A moved rope takes over the tail chunk
+    CharRope moved(std::move(original));
+    moved += '!';
+    CHECK(matches(moved, "> shared tail original!"));
+    CHECK(matches(copy, "tail copy"));
+
+    CHECK_THROWS(RangeException, copy.insert(10, "x"));
+    CHECK_THROWS(RangeException, copy.erase(5, 10));
+    CHECK_THROWS(RangeException, copy.erase(5, 4));
+    CHECK_THROWS(RangeException, copy.slice(0, 10));
+    CHECK(matches(copy, "tail copy"));
+}
+
+// Inserting into a long piece again and again divides it into many fragments of the same chunk
+static void test_repeated_splits()
+{
+    const std::string text = random_text(200000);
+    CharRope rope(text.c_str());
+    std::string expected = text;
+    for (size_t round = 0; round < 100000; ++round)
+    {
+        const size_t position = random_engine() % (expected.length() + 1);
+        rope.insert(position, "x");
+        expected.insert(position, "x");
+    }
+    CHECK(rope.piece_count() > 100000);
+    CHECK(matches(rope, expected));
+}
+
+int main()
+{
+    test_random_edits();
+    test_repeated_splits();
+    test_copy_divergence();
+    return test_result("CharRopeTest");
+}
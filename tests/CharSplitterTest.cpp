@@ -0,0 +1,242 @@
+// Compares the fields of CharSplitter with a plain reference split, for single delimiters,
+// delimiter sets and separator patterns, with texts that cross the 64 character blocks in which
+// delimiters are classified, and checks the iterators
+
+#include <string>
+#include <random>
+#include <vector>
+
+#include <CharBufferView.h>
+#include <CharKernels.h>
+#include <CharPattern.h>
+#include <CharSplitter.h>
+#include <RangeException.h>
+
+#include "TestSupport.h"
+
+static std::mt19937 random_engine(20181026);
+
+static const char* const ISA_NAMES[] = {"scalar", "sse2", "avx2", "avx512"};
+
+// Splits text at each character of delimiters, or at each non-overlapping occurrence of separator
+static std::vector<std::string> reference_split(
+    const std::string& text,
+    const std::string& delimiters,
+    const std::string& separator,
+    const bool skip_empty
+)
+{
+    std::vector<std::string> fields;
+    size_t field_start = 0;
+    bool done = false;
+    while (!done)
+    {
+        size_t field_end = separator.empty() ?
+            text.find_first_of(delimiters, field_start) : text.find(separator, field_start);
+        if (field_end == std::string::npos)
+        {
+            field_end = text.length();
+            done = true;
+        }
+        if (!skip_empty || field_end > field_start)
+        {
+            fields.push_back(text.substr(field_start, field_end - field_start));
+        }
+        field_start = field_end + (separator.empty() ? 1 : separator.length());
+    }
+    return fields;
+}
+
+static std::vector<std::string> collect(CharSplitter& splitter)
+{
+    std::vector<std::string> fields;
+    CharBufferView field;
+    while (splitter.next(field))
+    {
+        fields.push_back(std::string(field.data(), field.length()));
+    }
+    CHECK(!splitter.next(field));
+    return fields;
+}
+
+static std::vector<std::string> collect_iterated(CharSplitter& splitter)
+{
+    std::vector<std::string> fields;
+    for (const CharBufferView& field : splitter)
+    {
+        fields.push_back(std::string(field.data(), field.length()));
+    }
+    return fields;
+}
+
+// Mostly letters, with delimiters at a random density; long texts cover several blocks
+static std::string random_text(const std::string& alphabet)
+{
+    const size_t length = random_engine() % 4 == 0 ? random_engine() % 400 : random_engine() % 80;
+    const uint32_t density = 1 + random_engine() % 16;
+    std::string text(length, ' ');
+    for (char& letter : text)
+    {
+        letter = random_engine() % density == 0 ?
+            alphabet[random_engine() % alphabet.length()] : static_cast<char> ('a' + random_engine() % 3);
+    }
+    return text;
+}
+
+static void check_split(CharSplitter& splitter, const std::vector<std::string>& expected)
+{
+    CHECK(collect(splitter) == expected);
+    splitter.reset();
+    CHECK(collect_iterated(splitter) == expected);
+    splitter.reset();
+    CHECK(collect(splitter) == expected);
+}
+
+static void test_single_delimiter()
+{
+    const std::vector<std::string> empty_field = {""};
+    CharSplitter empty_text(CharBufferView(), ',');
+    check_split(empty_text, empty_field);
+    CharSplitter leading(CharBufferView(",a,,b"), ',');
+    check_split(leading, {"", "a", "", "b"});
+    CharSplitter trailing(CharBufferView("a,"), ',');
+    check_split(trailing, {"a", ""});
+    CharSplitter skipping(CharBufferView(",a,,b,"), ',');
+    skipping.set_skip_empty(true);
+    CHECK(skipping.is_skip_empty());
+    check_split(skipping, {"a", "b"});
+    CharSplitter only_delimiters(CharBufferView(",,,"), ',');
+    only_delimiters.set_skip_empty(true);
+    check_split(only_delimiters, {});
+
+    for (size_t round = 0; round < 3000; ++round)
+    {
+        const std::string text = random_text(",");
+        const bool skip_empty = round % 2 == 0;
+        CharSplitter splitter(CharBufferView(text.data(), text.length()), ',');
+        splitter.set_skip_empty(skip_empty);
+        check_split(splitter, reference_split(text, ",", "", skip_empty));
+    }
+}
+
+static void test_delimiter_set()
+{
+    CHECK_THROWS(RangeException, CharSplitter(CharBufferView("a,b"), "", 0));
+
+    // Delimiters of both halves of the character range, including the terminator character
+    const std::vector<std::string> sets = {",;", ",;|\t", std::string("\0\xff", 2), std::string("x\x80\0 ", 4)};
+    for (size_t round = 0; round < 3000; ++round)
+    {
+        const std::string& set = sets[round % sets.size()];
+        const std::string text = random_text(set);
+        const bool skip_empty = round % 3 == 0;
+        CharSplitter splitter(CharBufferView(text.data(), text.length()), set.data(), set.length());
+        splitter.set_skip_empty(skip_empty);
+        check_split(splitter, reference_split(text, set, "", skip_empty));
+    }
+}
+
+static void test_separator_pattern()
+{
+    CHECK_THROWS(RangeException, CharSplitter(CharBufferView("a,b"), CharPattern("")));
+
+    const CharPattern overlapping("aa");
+    CharSplitter splitter(CharBufferView("aaaaa"), overlapping);
+    check_split(splitter, {"", "", "a"});
+
+    const std::vector<std::string> separators = {"ab", "aba", "::", "abcabcabcabc"};
+    for (size_t round = 0; round < 3000; ++round)
+    {
+        const std::string& separator = separators[round % separators.size()];
+        const CharPattern pattern(separator.c_str());
+        const std::string text = random_text(separator.substr(0, 1) + ":bc");
+        const bool skip_empty = round % 2 == 0;
+        CharSplitter pattern_splitter(CharBufferView(text.data(), text.length()), pattern);
+        pattern_splitter.set_skip_empty(skip_empty);
+        check_split(pattern_splitter, reference_split(text, "", separator, skip_empty));
+    }
+}
+
+// Delimiters right before, at and after each block boundary, at every offset of the text
+// relative to the start of the storage
+static void test_block_boundaries()
+{
+    const std::vector<size_t> positions = {0, 1, 62, 63, 64, 65, 126, 127, 128, 129, 191, 192};
+    for (size_t offset = 0; offset < 8; ++offset)
+    {
+        for (const size_t first : positions)
+        {
+            for (const size_t second : positions)
+            {
+                std::string storage(offset + 200, 'x');
+                storage[offset + first] = ',';
+                storage[offset + second] = ';';
+                for (const size_t length : {64, 128, 129, 193, 200})
+                {
+                    const std::string text = storage.substr(offset, length);
+                    CharSplitter splitter(CharBufferView(&(storage[offset]), length), ",;", 2);
+                    check_split(splitter, reference_split(text, ",;", "", false));
+                    splitter.reset();
+                    splitter.set_skip_empty(true);
+                    check_split(splitter, reference_split(text, ",;", "", true));
+                }
+            }
+        }
+    }
+
+    // Every character is a delimiter, so that a block produces 64 fields
+    const std::string dense(300, ',');
+    CharSplitter splitter(CharBufferView(dense.data(), dense.length()), ',');
+    CHECK(collect(splitter).size() == 301);
+}
+
+static void test_iterator()
+{
+    const CharBufferView text("a,b,,c");
+    CharSplitter splitter(text, ',');
+    CHECK(splitter.end() == CharSplitter::Iterator());
+
+    CharSplitter::Iterator it = splitter.begin();
+    CharSplitter::Iterator copy = it;
+    CHECK(it == copy);
+    CHECK(it != splitter.end());
+    CHECK(*it == "a");
+    CHECK(it->data() == text.data());
+
+    // Both iterators advance the same splitter, but each keeps its own field
+    ++it;
+    CHECK(*it == "b");
+    CHECK(it != copy);
+    CHECK(*copy == "a");
+    ++it;
+    CHECK(it->is_empty());
+    CHECK(it->data() == text.data() + 4);
+    ++it;
+    CHECK(*it == "c");
+    ++it;
+    CHECK(it == splitter.end());
+    ++it;
+    CHECK(it == CharSplitter::Iterator());
+
+    // An exhausted splitter yields no fields until it is reset
+    CHECK(splitter.begin() == splitter.end());
+    splitter.reset();
+    CHECK(*(splitter.begin()) == "a");
+}
+
+int main()
+{
+    // The delimiters are classified by the kernels, so each supported kernel set is tested
+    for (const char* const isa_name : ISA_NAMES)
+    {
+        if (CharKernels::select_isa(isa_name))
+        {
+            test_single_delimiter();
+            test_delimiter_set();
+            test_block_boundaries();
+        }
+    }
+    test_separator_pattern();
+    test_iterator();
+    return test_result("CharSplitterTest");
+}
@@ -0,0 +1,232 @@
+// Compares the parallel searches of CharWorkerPool with serial searches, with matches placed across
+// the chunk boundaries, and checks nested and concurrent runs and the propagation of exceptions
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <CharBuffer.h>
+#include <CharBufferView.h>
+#include <CharPattern.h>
+#include <CharWorkerPool.h>
+
+#include "TestSupport.h"
+
+static std::mt19937 random_engine(20181030);
+
+static std::string random_text(const size_t length)
+{
+    std::string text(length, ' ');
+    for (char& letter : text)
+    {
+        letter = "abc"[random_engine() % 3];
+    }
+    return text;
+}
+
+// Indexes of all occurrences of pattern in text, including overlapping ones
+static std::vector<size_t> serial_find_all(const std::string& text, const std::string& pattern)
+{
+    std::vector<size_t> matches;
+    size_t index = text.find(pattern);
+    while (index != std::string::npos)
+    {
+        matches.push_back(index);
+        index = text.find(pattern, index + 1);
+    }
+    return matches;
+}
+
+static void check_searches(CharWorkerPool& pool, const std::string& text, const std::string& pattern)
+{
+    const CharBufferView text_view(text.data(), text.length());
+    const CharPattern compiled(pattern.data(), pattern.length());
+    const std::vector<size_t> expected = serial_find_all(text, pattern);
+
+    const size_t first_match = expected.empty() ? CharBuffer::NPOS : expected.front();
+    CHECK(pool.parallel_index_of(text_view, compiled) == (pattern.empty() ? 0 : first_match));
+    CHECK(pool.parallel_count_of(text_view, compiled) == expected.size());
+
+    // Matches are appended to the existing content
+    std::vector<size_t> matches(1, 42);
+    pool.parallel_find_all(text_view, compiled, matches);
+    CHECK(matches.size() == expected.size() + 1);
+    CHECK(std::equal(expected.begin(), expected.end(), matches.begin() + 1));
+}
+
+// Places occurrences of the pattern at offsets around the chunk boundaries of a text of three times
+// MIN_CHUNK_LENGTH characters, which is split into three chunks of MIN_CHUNK_LENGTH for any number of threads
+static void test_chunk_boundaries(CharWorkerPool& pool)
+{
+    const size_t chunk_length = CharWorkerPool::MIN_CHUNK_LENGTH;
+    const std::string filler(3 * chunk_length, 'x');
+    const std::vector<std::string> patterns = {"a", "ab", "abcab", std::string(100, 'a')};
+    for (const std::string& pattern : patterns)
+    {
+        // Long patterns are placed with their ends near the boundary and at a few offsets in between
+        std::vector<size_t> offsets;
+        for (size_t offset = 0; offset <= pattern.length(); ++offset)
+        {
+            if (offset < 3 || offset + 3 > pattern.length() || offset % 16 == 0)
+            {
+                offsets.push_back(offset);
+            }
+        }
+        for (const size_t offset : offsets)
+        {
+            std::string text = filler;
+            for (size_t boundary = chunk_length; boundary < text.length(); boundary += chunk_length)
+            {
+                text.replace(boundary - offset, pattern.length(), pattern);
+            }
+            check_searches(pool, text, pattern);
+
+            // A single match that crosses the last boundary is also the first match
+            std::string single = filler;
+            single.replace(single.length() - chunk_length - offset, pattern.length(), pattern);
+            check_searches(pool, single, pattern);
+        }
+    }
+
+    // Every position matches, so each chunk boundary is crossed by overlapping matches
+    check_searches(pool, std::string(3 * chunk_length + 7, 'a'), "aaaa");
+}
+
+static void test_random_texts(CharWorkerPool& pool)
+{
+    for (size_t round = 0; round < 20; ++round)
+    {
+        const size_t max_length = round % 4 == 0 ? 1000 : 5 * CharWorkerPool::MIN_CHUNK_LENGTH;
+        const size_t length = random_engine() % max_length;
+        const std::string text = random_text(length);
+        const size_t pat_length = 1 + random_engine() % 12;
+        const size_t pat_start = length > pat_length ? random_engine() % (length - pat_length) : 0;
+        check_searches(pool, text, text.substr(pat_start, pat_length));
+        check_searches(pool, text, random_text(pat_length));
+    }
+    check_searches(pool, "", "a");
+    check_searches(pool, "abc", "abcd");
+
+    // The empty pattern matches at every position
+    check_searches(pool, "abc", "");
+    check_searches(pool, "", "");
+}
+
+static void test_nested_run(CharWorkerPool& pool)
+{
+    pool.run(0, [](size_t) { CHECK(false); });
+
+    std::vector<std::atomic<size_t>> calls(100);
+    for (std::atomic<size_t>& count : calls)
+    {
+        count.store(0);
+    }
+    const std::string text = random_text(2 * CharWorkerPool::MIN_CHUNK_LENGTH);
+    const CharPattern pattern("abca");
+    const size_t expected = serial_find_all(text, "abca").size();
+    pool.run(
+        10,
+        [&](const size_t outer_idx)
+        {
+            pool.run(
+                10,
+                [&](const size_t inner_idx)
+                {
+                    ++calls[outer_idx * 10 + inner_idx];
+                }
+            );
+            CHECK(pool.parallel_count_of(CharBufferView(text.data(), text.length()), pattern) == expected);
+        }
+    );
+    for (const std::atomic<size_t>& count : calls)
+    {
+        CHECK(count.load() == 1);
+    }
+}
+
+static void test_exceptions(CharWorkerPool& pool)
+{
+    std::atomic<size_t> finished(0);
+    bool thrown = false;
+    try
+    {
+        pool.run(
+            1000,
+            [&](const size_t index)
+            {
+                if (index % 100 == 7)
+                {
+                    throw std::runtime_error("task failed");
+                }
+                ++finished;
+            }
+        );
+    }
+    catch (std::runtime_error& e)
+    {
+        thrown = std::string(e.what()) == "task failed";
+    }
+
+    // The exception is rethrown after all other tasks have finished
+    CHECK(thrown);
+    CHECK(finished.load() == 990);
+
+    // Exceptions of nested runs propagate through the outer run, and the pool remains usable
+    const std::function<void(size_t)> failing = [](const size_t index)
+    {
+        if (index == 3)
+        {
+            throw std::logic_error("nested");
+        }
+    };
+    CHECK_THROWS(std::logic_error, pool.run(4, [&](size_t) { pool.run(4, failing); }));
+    std::atomic<size_t> calls(0);
+    pool.run(100, [&](size_t) { ++calls; });
+    CHECK(calls.load() == 100);
+}
+
+// Several threads that are not workers of the pool run batches at the same time
+static void test_concurrent_runs(CharWorkerPool& pool)
+{
+    const std::string text = random_text(3 * CharWorkerPool::MIN_CHUNK_LENGTH);
+    const std::vector<size_t> expected = serial_find_all(text, "cab");
+    std::vector<std::thread> threads;
+    for (size_t thread_idx = 0; thread_idx < 4; ++thread_idx)
+    {
+        threads.emplace_back([&]()
+        {
+            const CharPattern pattern("cab");
+            for (size_t round = 0; round < 5; ++round)
+            {
+                std::vector<size_t> matches;
+                pool.parallel_find_all(CharBufferView(text.data(), text.length()), pattern, matches);
+                CHECK(matches == expected);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+int main()
+{
+    for (const size_t thread_count : {1, 2, 3, 0})
+    {
+        CharWorkerPool pool(thread_count);
+        CHECK(pool.thread_count() > 0);
+        CHECK(thread_count == 0 || pool.thread_count() == thread_count);
+        test_chunk_boundaries(pool);
+        test_random_texts(pool);
+        test_nested_run(pool);
+        test_exceptions(pool);
+        test_concurrent_runs(pool);
+    }
+    return test_result("CharWorkerPoolTest");
+}
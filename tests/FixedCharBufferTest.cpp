@@ -0,0 +1,116 @@
+// Builds FixedCharBuffer instances during constant evaluation, and checks the runtime behavior
+// of the operations, including the RangeException if the capacity is exceeded
+
+#include <string>
+
+#include <CharBuffer.h>
+#include <FixedCharBuffer.h>
+#include <RangeException.h>
+
+#include "TestSupport.h"
+
+// Instantiates all members that are not templates themselves, so that errors in members that
+// no test uses are reported as well
+template class FixedCharBuffer<8>;
+
+typedef FixedCharBuffer<16> Buffer16;
+
+static constexpr Buffer16 make_greeting()
+{
+    Buffer16 greeting("hello");
+    greeting += ' ';
+    greeting += "world";
+    return greeting;
+}
+
+static constexpr Buffer16 make_edited()
+{
+    Buffer16 edited("abcdef");
+    edited.substring(1, 5);
+    edited.overwrite_with(2, "XYZ");
+    edited.append(FixedCharBuffer<4>("0123"), 1, 3);
+    edited.fill('-', 10);
+    return edited;
+}
+
+static constexpr Buffer16 GREETING = make_greeting();
+
+static_assert(GREETING.length() == 11, "length");
+static_assert(GREETING.capacity() == 16, "capacity");
+static_assert(GREETING == "hello world", "operator==");
+static_assert(GREETING != "hello", "operator!=");
+static_assert(GREETING[4] == 'o', "operator[]");
+static_assert(GREETING.compare_to("hello") > 0, "compare_to");
+static_assert(GREETING.compare_to("hello world!") < 0, "compare_to");
+static_assert(GREETING.compare_to("hellp") < 0, "compare_to");
+static_assert(GREETING > FixedCharBuffer<4>("abc"), "operator>");
+static_assert(GREETING.starts_with("hello"), "starts_with");
+static_assert(GREETING.ends_with("world"), "ends_with");
+static_assert(!GREETING.ends_with("hello"), "ends_with");
+static_assert(GREETING.index_of('o') == 4, "index_of");
+static_assert(GREETING.index_of('o', 5) == 7, "index_of");
+static_assert(GREETING.index_of("world") == 6, "index_of");
+static_assert(GREETING.index_of("o", 8) == Buffer16::NPOS, "index_of");
+static_assert(GREETING.index_of(FixedCharBuffer<2>("ld")) == 9, "index_of");
+static_assert(make_edited() == "bcXYZ12---", "substring, overwrite_with, append, fill");
+
+static void test_capacity_exceeded()
+{
+    CHECK_THROWS(RangeException, FixedCharBuffer<4>("hello"));
+    CHECK_THROWS(RangeException, FixedCharBuffer<4>(CharBuffer("hello")));
+
+    // The length of the text is only measured as far as necessary; the array is not terminated,
+    // so reading beyond it would be reported by the address sanitizer
+    const char unterminated[5] = {'a', 'b', 'c', 'd', 'e'};
+    CHECK_THROWS(RangeException, FixedCharBuffer<4> {unterminated});
+    const FixedCharBuffer<4> full("abcd");
+    CHECK(full.compare_to(unterminated) < 0);
+    CHECK(!full.starts_with(unterminated));
+    CHECK(full.index_of(unterminated) == FixedCharBuffer<4>::NPOS);
+
+    const std::string huge(1000000, 'x');
+    CHECK_THROWS(RangeException, FixedCharBuffer<4> {huge.c_str()});
+
+    FixedCharBuffer<4> buffer("ab");
+    CHECK_THROWS(RangeException, buffer += "cde");
+    CHECK_THROWS(RangeException, buffer.append_raw("cde", 3));
+    CHECK_THROWS(RangeException, buffer.overwrite_with(1, "bcde"));
+    CHECK_THROWS(RangeException, buffer.overwrite_with(3, "c"));
+    CHECK_THROWS(RangeException, buffer.fill('x', 5));
+    CHECK_THROWS(RangeException, buffer[2]);
+    CHECK_THROWS(RangeException, buffer.index_of('a', 3));
+    CHECK(buffer == "ab");
+    buffer += "cd";
+    CHECK_THROWS(RangeException, buffer += 'e');
+    CHECK(buffer == "abcd");
+}
+
+static void test_char_buffer_operations()
+{
+    const CharBuffer other("hello");
+    FixedCharBuffer<12> buffer(other);
+    CHECK(buffer == other);
+    CHECK(other == buffer);
+    buffer += CharBuffer(" you");
+    CHECK(buffer != other);
+    CHECK(buffer.compare_to(other) > 0);
+    CHECK(buffer.starts_with(other));
+    CHECK(buffer.ends_with(CharBuffer("you")));
+    buffer.overwrite_with(6, CharBuffer("all"));
+    CHECK(buffer == "hello all");
+    buffer.truncate(5);
+    buffer.append(other, 0, 3);
+    CHECK(buffer == "hellohel");
+
+    // Overwriting with the own content moves it backwards correctly
+    FixedCharBuffer<8> shifted("abcd");
+    shifted.overwrite_with(2, shifted);
+    CHECK(shifted == "ababcd");
+}
+
+int main()
+{
+    test_capacity_exceeded();
+    test_char_buffer_operations();
+    return test_result("FixedCharBufferTest");
+}
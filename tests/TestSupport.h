@@ -0,0 +1,66 @@
+#ifndef TESTSUPPORT_H
+#define TESTSUPPORT_H
+
+#include <cstdio>
+#include <cstddef>
+
+// Minimal test support for the test programs
+// Each test program is a single translation unit that calls its test functions from main()
+// and returns test_result(), which is non-zero if any check failed.
+
+// Number of failed checks that are reported individually
+static const size_t MAX_REPORTED_FAILURES = 25;
+
+inline size_t& test_failure_count() noexcept
+{
+    static size_t failure_count = 0;
+    return failure_count;
+}
+
+inline bool test_check(const bool condition, const char* const text, const char* const file, const int line) noexcept
+{
+    if (!condition)
+    {
+        size_t& failure_count = test_failure_count();
+        if (failure_count < MAX_REPORTED_FAILURES)
+        {
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, text);
+        }
+        ++failure_count;
+    }
+    return condition;
+}
+
+inline int test_result(const char* const test_name) noexcept
+{
+    const size_t failure_count = test_failure_count();
+    if (failure_count == 0)
+    {
+        std::printf("%s: passed\n", test_name);
+    }
+    else
+    {
+        std::printf("%s: %zu checks failed\n", test_name, failure_count);
+    }
+    return failure_count == 0 ? 0 : 1;
+}
+
+#define CHECK(condition) test_check((condition), #condition, __FILE__, __LINE__)
+
+#define CHECK_THROWS(exception_type, statement) \
+    do \
+    { \
+        bool thrown = false; \
+        try \
+        { \
+            statement; \
+        } \
+        catch (exception_type&) \
+        { \
+            thrown = true; \
+        } \
+        test_check(thrown, #statement " throws " #exception_type, __FILE__, __LINE__); \
+    } \
+    while (false)
+
+#endif /* TESTSUPPORT_H */